@@ -0,0 +1,103 @@
+#ifndef CONJUNCTION_H
+#define CONJUNCTION_H
+#include <celestial.h>
+#include <datetime.h>
+#include <ephemeris.h>
+
+#include <string>
+#include <vector>
+
+/*
+Close approach between two objects of a screened catalog
+*/
+struct Conjunction {
+  // Catalog index of the first object
+  size_t primary;
+  // Catalog index of the second object
+  size_t secondary;
+  // Time of closest approach
+  DateTime tca;
+  // Distance between the objects at the time of closest approach (m)
+  double miss_distance;
+  // Relative speed of the objects at the time of closest approach (m/s)
+  double relative_speed;
+};
+
+/*
+Catalog conjunction screener
+
+Screens every pair of objects in a catalog of ephemerides for close approaches
+without checking all pairs. For each interval between ephemeris points:
+ - Each object's motion is bounded by a box, and the boxes are placed into a
+ uniform grid so only objects sharing a grid cell are paired
+ - Candidate pairs are dropped if their perigee/apogee shells do not overlap,
+ or if their orbit paths are separated at the line of mutual nodes
+ - Remaining pairs are refined by finding the zero of the range rate on a cubic
+ Hermite interpolation of the relative state
+
+Intervals are screened in parallel. All ephemerides must share the same epochs
+and central body (such as a catalog propagated with common settings).
+
+Ref: Hoots, F. R., Crawford, L. L., & Roehrich, R. L. (1984). An analytic
+method to determine future close approaches between satellites. Celestial
+Mechanics, 33(2), 143-158.
+*/
+class ConjunctionScreener {
+  // Packed positions/velocities of every object, indexed by
+  // [epoch][object][component]
+  std::vector<double> states;
+
+  /*
+  Screen a single interval between ephemeris points
+
+  @param k Index of the epoch starting the interval
+  @param found Vector to which conjunctions in the interval are added
+  */
+  void screen_interval(size_t k, std::vector<Conjunction> &found);
+
+public:
+  // Miss distance under which close approaches are reported (m)
+  double threshold;
+  // Extra distance added to the prefilters to cover perturbations not captured
+  // by osculating orbits over one interval (m)
+  double margin;
+  // Number of worker threads (0 uses the hardware concurrency)
+  unsigned threads;
+  // Number of objects in the catalog
+  size_t n_objects;
+  // Common epochs of the ephemerides
+  std::vector<DateTime> epochs;
+  // Common central body of the ephemerides
+  CelestialBody central_body;
+
+  /*
+  Direct constructor
+
+  @param catalog Ephemerides of each object, copied into packed storage
+  @param threshold Miss distance under which close approaches are reported (m)
+  @throws exceptions::ArcException if the ephemerides do not share epochs and
+  central body, or have fewer than two points
+  */
+  ConjunctionScreener(std::vector<Ephemeris> &catalog, double threshold);
+
+  /*
+  Screen the catalog for close approaches
+
+  @returns (std::vector<conjunction::Conjunction>) Close approaches under the
+  threshold, ordered by time of closest approach
+  */
+  std::vector<Conjunction> screen();
+};
+
+/*
+Write conjunctions to a text report
+
+@param conjunctions Close approaches to report
+@param names Name of each catalog object
+@param filename File system location at which to write the report
+@throws exceptions::ArcException if the file cannot be written
+*/
+void write_conjunctions(std::vector<Conjunction> &conjunctions,
+                        std::vector<std::string> &names, const char filename[]);
+
+#endif
\ No newline at end of file
@@ -6,46 +6,131 @@
 #include <iostream>
 #include <string>
 
+#include <cstdint>
+
 // Forward declaration
 class ICRF;
 
+/*
+Physical constants of a celestial body
+
+Entries of the body registry are immutable; the derived constants are
+computed once when the registry is built rather than on every use
+*/
+struct BodyConstants {
+  // NAIF ID Code
+  int id;
+  // GM in m^3/s^2
+  double mu;
+  // Equatorial radius in meters
+  double radius_equator;
+  // Polar radius in meters
+  double radius_polar;
+  // Rotation rate vector in rad/sec
+  Vector3 rotation;
+  // Flattening, (r_e - r_p) / r_e
+  double flattening;
+  // J2 perturbation constant
+  double j2;
+  // Equatorial radius squared in m^2
+  double radius_squared;
+};
+
+/*
+Build registry constants, deriving the flattening, J2, and radius powers
+
+@param id NAIF ID code
+@param mu GM in m^3/s^2
+@param radius_equator Equatorial radius in meters
+@param radius_polar Polar radius in meters
+@param rotation Rotation rate vector in rad/sec
+@returns (celestial::BodyConstants) Constants of the body
+*/
+constexpr BodyConstants body_constants(int id, double mu,
+                                       double radius_equator,
+                                       double radius_polar,
+                                       Vector3 rotation) {
+  return BodyConstants{
+    id, mu, radius_equator, radius_polar, rotation,
+    (radius_equator - radius_polar) / radius_equator,
+    2.0 * ((radius_equator - radius_polar) / radius_equator) / 3.0 -
+      radius_equator * radius_equator * radius_equator *
+      rotation.dot(rotation) / (3 * mu),
+    radius_equator * radius_equator
+  };
+}
+
+// Number of bodies in the registry
+const uint32_t BODY_COUNT = 10;
+
+// Registry of body constants, indexed by CelestialBody handle
+extern const BodyConstants BODY_REGISTRY[BODY_COUNT];
+
 /*
 Celestial body type
 
-Handles identification and physical attributes 
-(GM, radius, etc.) of celestial bodies
+Handles identification and physical attributes
+(GM, radius, etc.) of celestial bodies. A body is a 4 byte handle into the
+immutable body registry, so states and force models can hold one by value
 */
 class CelestialBody {
 public:
+    // Index of the body in the registry
+    uint32_t handle;
+
+    // Default constructor (the Sun)
+    constexpr CelestialBody() : handle{ 0 } {}
+
+    /*
+    Construct from a registry handle
+
+    @param handle Index of the body in the registry
+    */
+    constexpr explicit CelestialBody(uint32_t handle) : handle{ handle } {}
+
+    /*
+    Get the registry constants of this body
+
+    @returns (celestial::BodyConstants) Immutable constants of this body
+    */
+    const BodyConstants& constants() const { return BODY_REGISTRY[handle]; }
+
     // NAIF ID Code
-    int id;
+    int id() const { return constants().id; }
+
     // GM in m^3/s^2
-    double mu;
+    double mu() const { return constants().mu; }
+
     // Equatorial radius in meters
-    double radius_equator;
+    double radius_equator() const { return constants().radius_equator; }
+
     // Polar radius in meters
-    double radius_polar;
+    double radius_polar() const { return constants().radius_polar; }
+
     // Rotation rate vector in rad/sec
-    Vector3 rotation;
+    const Vector3& rotation() const { return constants().rotation; }
+
+    // Equatorial radius squared in m^2
+    double radius_squared() const { return constants().radius_squared; }
 
     /*
     Get the body's common name
 
     @returns (std::string) Common name of this body
     */
-    std::string get_name();
+    std::string get_name() const;
 
     /*
     Return the ratio between this body's polar and equatorial radii, calculated as (r_e - r_p) / r_e
 
     @returns (double) Flattening (oblateness) of this body
     */
-    double flattening();
+    double flattening() const { return constants().flattening; }
 
     /*
     Return J2 perturbation constant
     */
-    double j2();
+    double j2() const { return constants().j2; }
 
     /*
     Obtain the ICRF state of this body at an epoch
@@ -53,116 +138,36 @@ public:
     @param epoch The requested time at which to obtain the ICRF state
     @returns (icrf::ICRF) The calculated state at the requested epoch
     */
-    ICRF propagate(DateTime& epoch);
+    ICRF propagate(DateTime& epoch) const;
 };
 
 // I/O stream 
 std::ostream& operator << (std::ostream &out, CelestialBody& body);
 
 /*
-Planet definitions
+Planet handles (constants in the body registry)
 */
 
-// Sun definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody SUN = CelestialBody{
-    10,
-    132712440018000003072.0,
-    69570000000.0,
-    69570000000.0,
-    Vector3 {0, 0, 2.8653296490574722e-06}
-};
-
-// Mercury definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody MERCURY = CelestialBody{
-    199,
-    22032000000000.0,
-    2439700.0,
-    2439700.0,
-    Vector3 {0, 0, 1.240013030109886e-06}
-};
-
-// Venus definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody VENUS = CelestialBody{
-    299,
-    324859000000000.0,
-    6051800.0,
-    6051800.0,
-    Vector3 {0, 0, -2.992398738488947e-07}
-};
-
-// Earth definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-// - EGM-2008 (NGA)
-static CelestialBody EARTH = CelestialBody{
-    399,
-    398600441800000.0,
-    6378137.0,
-    6356752.3,
-    Vector3 {0, 0, 7.292115024135738e-05}
-};
-
-// Luna definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody LUNA = CelestialBody{
-    301,
-    4904869500000.0,
-    1738100.0,
-    1736000.0,
-    Vector3 {0, 0, 2.6616995272150692e-06}
-};
-
-// Mars definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody MARS = CelestialBody{
-    499,
-    42828370000000.0,
-    3396200.0,
-    3376200.0,
-    Vector3 {0, 0, 7.088218111185524e-05}
-};
-
-// Jupiter definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody JUPITER = CelestialBody{
-    599,
-    126686534900000000.0,
-    71492000.0,
-    66854000.0,
-    Vector3 {0, 0, 0.00017734058128229425}
-};
-
-// Saturn definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody SATURN = CelestialBody{
-    699,
-    37931187900000000.0,
-    60268000.0,
-    54364000.0,
-    Vector3 {0, 0, 0.00017070904264420285}
-};
-
-// Uranus definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody URANUS = CelestialBody{
-    799,
-    5793939900000000.0,
-    25559000.0,
-    24973000.0,
-    Vector3 {0, 0, -0.00010123766537166816}
-};
-
-// Neptune definition using parameters derived from:
-// - NASA Space Science Data Coordinated Archive
-static CelestialBody NEPTUNE = CelestialBody{
-    899,
-    6836529900000000.0,
-    24764000.0,
-    24341000.0,
-    Vector3 {0, 0, 0.00010833825276190748}
-};
+// Sun
+const CelestialBody SUN{ 0 };
+// Mercury
+const CelestialBody MERCURY{ 1 };
+// Venus
+const CelestialBody VENUS{ 2 };
+// Earth
+const CelestialBody EARTH{ 3 };
+// Luna
+const CelestialBody LUNA{ 4 };
+// Mars
+const CelestialBody MARS{ 5 };
+// Jupiter
+const CelestialBody JUPITER{ 6 };
+// Saturn
+const CelestialBody SATURN{ 7 };
+// Uranus
+const CelestialBody URANUS{ 8 };
+// Neptune
+const CelestialBody NEPTUNE{ 9 };
 
 /*
 Get the common name of a body by NAIF ID
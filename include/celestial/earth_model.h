@@ -1,118 +1,153 @@
 #ifndef EARTH_MODEL_H
 #define EARTH_MODEL_H
+#include <cip_series.h>
 #include <datetime.h>
+#include <rotations.h>
 #include <vectors.h>
 
 #include <array>
 
+/*
+Earth orientation models
+
+Precession-nutation theory used for the ITRF/ICRF rotation
+*/
+enum EarthModel {
+  // IAU 1976 precession and IAU 1980 nutation (equinox based)
+  IAU_1980,
+  // IAU 2006 precession and IAU 2000A nutation (CIO based)
+  IAU_2006
+};
+
+/*
+Term of the IAU 1980 nutation series
+
+The argument is the sum of the fundamental arguments (see nutation_arguments)
+times their integer multipliers. Coefficients are in units of 0.0001
+arcseconds, with rates per Julian century.
+*/
+struct NutationTerm {
+  // Multipliers of the fundamental arguments (l, l', F, D, Omega)
+  int multipliers[5];
+  // Delta psi coefficient and its rate (sine term)
+  double a;
+  double b;
+  // Delta epsilon coefficient and its rate (cosine term)
+  double c;
+  double d;
+};
+
+// Largest absolute multiplier of a fundamental argument in IAU_1980_VALUES
+const int NUTATION_MAX_MULTIPLIER = 4;
+
 // IAU 1980 value array for nutation model
-static const std::array<std::array<double, 9>, 106> IAU_1980_VALUES {
-  std::array<double,9> {0, 0, 0, 0, 1, -171996, -174.2, 92025, 8.9},
-  std::array<double,9> {0, 0, 2, -2, 2, -13187, -1.6, 5736, -3.1},
-  std::array<double,9> {0, 0, 2, 0, 2, -2274, -0.2, 977, -0.5},
-  std::array<double,9> {0, 0, 0, 0, 2, 2062, 0.2, -895, 0.5},
-  std::array<double,9> {0, 1, 0, 0, 0, 1426, -3.4, 54, -0.1},
-  std::array<double,9> {1, 0, 0, 0, 0, 712, 0.1, -7, 0},
-  std::array<double,9> {0, 1, 2, -2, 2, -517, 1.2, 224, -0.6},
-  std::array<double,9> {0, 0, 2, 0, 1, -386, -0.4, 200, 0},
-  std::array<double,9> {1, 0, 2, 0, 2, -301, 0, 129, -0.1},
-  std::array<double,9> {0, -1, 2, -2, 2, 217, -0.5, -95, 0.3},
-  std::array<double,9> {1, 0, 0, -2, 0, -158, 0, -1, 0},
-  std::array<double,9> {0, 0, 2, -2, 1, 129, 0.1, -70, 0},
-  std::array<double,9> {-1, 0, 2, 0, 2, 123, 0, -53, 0},
-  std::array<double,9> {1, 0, 0, 0, 1, 63, 0.1, -33, 0},
-  std::array<double,9> {0, 0, 0, 2, 0, 63, 0, -2, 0},
-  std::array<double,9> {-1, 0, 2, 2, 2, -59, 0, 26, 0},
-  std::array<double,9> {-1, 0, 0, 0, 1, -58, -0.1, 32, 0},
-  std::array<double,9> {1, 0, 2, 0, 1, -51, 0, 27, 0},
-  std::array<double,9> {2, 0, 0, -2, 0, 48, 0, 1, 0},
-  std::array<double,9> {-2, 0, 2, 0, 1, 46, 0, -24, 0},
-  std::array<double,9> {0, 0, 2, 2, 2, -38, 0, 16, 0},
-  std::array<double,9> {2, 0, 2, 0, 2, -31, 0, 13, 0},
-  std::array<double,9> {2, 0, 0, 0, 0, 29, 0, -1, 0},
-  std::array<double,9> {1, 0, 2, -2, 2, 29, 0, -12, 0},
-  std::array<double,9> {0, 0, 2, 0, 0, 26, 0, -1, 0},
-  std::array<double,9> {0, 0, 2, -2, 0, -22, 0, 0, 0},
-  std::array<double,9> {-1, 0, 2, 0, 1, 21, 0, -10, 0},
-  std::array<double,9> {0, 2, 0, 0, 0, 17, -0.1, 0, 0},
-  std::array<double,9> {0, 2, 2, -2, 2, -16, 0.1, 7, 0},
-  std::array<double,9> {-1, 0, 0, 2, 1, 16, 0, -8, 0},
-  std::array<double,9> {0, 1, 0, 0, 1, -15, 0, 9, 0},
-  std::array<double,9> {1, 0, 0, -2, 1, -13, 0, 7, 0},
-  std::array<double,9> {0, -1, 0, 0, 1, -12, 0, 6, 0},
-  std::array<double,9> {2, 0, -2, 0, 0, 11, 0, 0, 0},
-  std::array<double,9> {-1, 0, 2, 2, 1, -10, 0, 5, 0},
-  std::array<double,9> {1, 0, 2, 2, 2, -8, 0, 3, 0},
-  std::array<double,9> {0, -1, 2, 0, 2, -7, 0, 3, 0},
-  std::array<double,9> {0, 0, 2, 2, 1, -7, 0, 3, 0},
-  std::array<double,9> {1, 1, 0, -2, 0, -7, 0, 0, 0},
-  std::array<double,9> {0, 1, 2, 0, 2, 7, 0, -3, 0},
-  std::array<double,9> {-2, 0, 0, 2, 1, -6, 0, 3, 0},
-  std::array<double,9> {0, 0, 0, 2, 1, -6, 0, 3, 0},
-  std::array<double,9> {2, 0, 2, -2, 2, 6, 0, -3, 0},
-  std::array<double,9> {1, 0, 0, 2, 0, 6, 0, 0, 0},
-  std::array<double,9> {1, 0, 2, -2, 1, 6, 0, -3, 0},
-  std::array<double,9> {0, 0, 0, -2, 1, -5, 0, 3, 0},
-  std::array<double,9> {0, -1, 2, -2, 1, -5, 0, 3, 0},
-  std::array<double,9> {2, 0, 2, 0, 1, -5, 0, 3, 0},
-  std::array<double,9> {1, -1, 0, 0, 0, 5, 0, 0, 0},
-  std::array<double,9> {1, 0, 0, -1, 0, -4, 0, 0, 0},
-  std::array<double,9> {0, 0, 0, 1, 0, -4, 0, 0, 0},
-  std::array<double,9> {0, 1, 0, -2, 0, -4, 0, 0, 0},
-  std::array<double,9> {1, 0, -2, 0, 0, 4, 0, 0, 0},
-  std::array<double,9> {2, 0, 0, -2, 1, 4, 0, -2, 0},
-  std::array<double,9> {0, 1, 2, -2, 1, 4, 0, -2, 0},
-  std::array<double,9> {1, 1, 0, 0, 0, -3, 0, 0, 0},
-  std::array<double,9> {1, -1, 0, -1, 0, -3, 0, 0, 0},
-  std::array<double,9> {-1, -1, 2, 2, 2, -3, 0, 1, 0},
-  std::array<double,9> {0, -1, 2, 2, 2, -3, 0, 1, 0},
-  std::array<double,9> {1, -1, 2, 0, 2, -3, 0, 1, 0},
-  std::array<double,9> {3, 0, 2, 0, 2, -3, 0, 1, 0},
-  std::array<double,9> {-2, 0, 2, 0, 2, -3, 0, 1, 0},
-  std::array<double,9> {1, 0, 2, 0, 0, 3, 0, 0, 0},
-  std::array<double,9> {-1, 0, 2, 4, 2, -2, 0, 1, 0},
-  std::array<double,9> {1, 0, 0, 0, 2, -2, 0, 1, 0},
-  std::array<double,9> {-1, 0, 2, -2, 1, -2, 0, 1, 0},
-  std::array<double,9> {0, -2, 2, -2, 1, -2, 0, 1, 0},
-  std::array<double,9> {-2, 0, 0, 0, 1, -2, 0, 1, 0},
-  std::array<double,9> {2, 0, 0, 0, 1, 2, 0, -1, 0},
-  std::array<double,9> {3, 0, 0, 0, 0, 2, 0, 0, 0},
-  std::array<double,9> {1, 1, 2, 0, 2, 2, 0, -1, 0},
-  std::array<double,9> {0, 0, 2, 1, 2, 2, 0, -1, 0},
-  std::array<double,9> {1, 0, 0, 2, 1, -1, 0, 0, 0},
-  std::array<double,9> {1, 0, 2, 2, 1, -1, 0, 1, 0},
-  std::array<double,9> {1, 1, 0, -2, 1, -1, 0, 0, 0},
-  std::array<double,9> {0, 1, 0, 2, 0, -1, 0, 0, 0},
-  std::array<double,9> {0, 1, 2, -2, 0, -1, 0, 0, 0},
-  std::array<double,9> {0, 1, -2, 2, 0, -1, 0, 0, 0},
-  std::array<double,9> {1, 0, -2, 2, 0, -1, 0, 0, 0},
-  std::array<double,9> {1, 0, -2, -2, 0, -1, 0, 0, 0},
-  std::array<double,9> {1, 0, 2, -2, 0, -1, 0, 0, 0},
-  std::array<double,9> {1, 0, 0, -4, 0, -1, 0, 0, 0},
-  std::array<double,9> {2, 0, 0, -4, 0, -1, 0, 0, 0},
-  std::array<double,9> {0, 0, 2, 4, 2, -1, 0, 0, 0},
-  std::array<double,9> {0, 0, 2, -1, 2, -1, 0, 0, 0},
-  std::array<double,9> {-2, 0, 2, 4, 2, -1, 0, 1, 0},
-  std::array<double,9> {2, 0, 2, 2, 2, -1, 0, 0, 0},
-  std::array<double,9> {0, -1, 2, 0, 1, -1, 0, 0, 0},
-  std::array<double,9> {0, 0, -2, 0, 1, -1, 0, 0, 0},
-  std::array<double,9> {0, 0, 4, -2, 2, 1, 0, 0, 0},
-  std::array<double,9> {0, 1, 0, 0, 2, 1, 0, 0, 0},
-  std::array<double,9> {1, 1, 2, -2, 2, 1, 0, -1, 0},
-  std::array<double,9> {3, 0, 2, -2, 2, 1, 0, 0, 0},
-  std::array<double,9> {-2, 0, 2, 2, 2, 1, 0, -1, 0},
-  std::array<double,9> {-1, 0, 0, 0, 2, 1, 0, -1, 0},
-  std::array<double,9> {0, 0, -2, 2, 1, 1, 0, 0, 0},
-  std::array<double,9> {0, 1, 2, 0, 1, 1, 0, 0, 0},
-  std::array<double,9> {-1, 0, 4, 0, 2, 1, 0, 0, 0},
-  std::array<double,9> {2, 1, 0, -2, 0, 1, 0, 0, 0},
-  std::array<double,9> {2, 0, 0, 2, 0, 1, 0, 0, 0},
-  std::array<double,9> {2, 0, 2, -2, 1, 1, 0, -1, 0},
-  std::array<double,9> {2, 0, -2, 0, 1, 1, 0, 0, 0},
-  std::array<double,9> {1, -1, 0, -2, 0, 1, 0, 0, 0},
-  std::array<double,9> {-1, 0, 0, 1, 1, 1, 0, 0, 0},
-  std::array<double,9> {-1, -1, 0, 2, 1, 1, 0, 0, 0},
-  std::array<double,9> {0, 1, 0, 1, 0, 1, 0, 0, 0}
+constexpr NutationTerm IAU_1980_VALUES[106] = {
+  {0, 0, 0, 0, 1, -171996, -174.2, 92025, 8.9},
+  {0, 0, 2, -2, 2, -13187, -1.6, 5736, -3.1},
+  {0, 0, 2, 0, 2, -2274, -0.2, 977, -0.5},
+  {0, 0, 0, 0, 2, 2062, 0.2, -895, 0.5},
+  {0, 1, 0, 0, 0, 1426, -3.4, 54, -0.1},
+  {1, 0, 0, 0, 0, 712, 0.1, -7, 0},
+  {0, 1, 2, -2, 2, -517, 1.2, 224, -0.6},
+  {0, 0, 2, 0, 1, -386, -0.4, 200, 0},
+  {1, 0, 2, 0, 2, -301, 0, 129, -0.1},
+  {0, -1, 2, -2, 2, 217, -0.5, -95, 0.3},
+  {1, 0, 0, -2, 0, -158, 0, -1, 0},
+  {0, 0, 2, -2, 1, 129, 0.1, -70, 0},
+  {-1, 0, 2, 0, 2, 123, 0, -53, 0},
+  {1, 0, 0, 0, 1, 63, 0.1, -33, 0},
+  {0, 0, 0, 2, 0, 63, 0, -2, 0},
+  {-1, 0, 2, 2, 2, -59, 0, 26, 0},
+  {-1, 0, 0, 0, 1, -58, -0.1, 32, 0},
+  {1, 0, 2, 0, 1, -51, 0, 27, 0},
+  {2, 0, 0, -2, 0, 48, 0, 1, 0},
+  {-2, 0, 2, 0, 1, 46, 0, -24, 0},
+  {0, 0, 2, 2, 2, -38, 0, 16, 0},
+  {2, 0, 2, 0, 2, -31, 0, 13, 0},
+  {2, 0, 0, 0, 0, 29, 0, -1, 0},
+  {1, 0, 2, -2, 2, 29, 0, -12, 0},
+  {0, 0, 2, 0, 0, 26, 0, -1, 0},
+  {0, 0, 2, -2, 0, -22, 0, 0, 0},
+  {-1, 0, 2, 0, 1, 21, 0, -10, 0},
+  {0, 2, 0, 0, 0, 17, -0.1, 0, 0},
+  {0, 2, 2, -2, 2, -16, 0.1, 7, 0},
+  {-1, 0, 0, 2, 1, 16, 0, -8, 0},
+  {0, 1, 0, 0, 1, -15, 0, 9, 0},
+  {1, 0, 0, -2, 1, -13, 0, 7, 0},
+  {0, -1, 0, 0, 1, -12, 0, 6, 0},
+  {2, 0, -2, 0, 0, 11, 0, 0, 0},
+  {-1, 0, 2, 2, 1, -10, 0, 5, 0},
+  {1, 0, 2, 2, 2, -8, 0, 3, 0},
+  {0, -1, 2, 0, 2, -7, 0, 3, 0},
+  {0, 0, 2, 2, 1, -7, 0, 3, 0},
+  {1, 1, 0, -2, 0, -7, 0, 0, 0},
+  {0, 1, 2, 0, 2, 7, 0, -3, 0},
+  {-2, 0, 0, 2, 1, -6, 0, 3, 0},
+  {0, 0, 0, 2, 1, -6, 0, 3, 0},
+  {2, 0, 2, -2, 2, 6, 0, -3, 0},
+  {1, 0, 0, 2, 0, 6, 0, 0, 0},
+  {1, 0, 2, -2, 1, 6, 0, -3, 0},
+  {0, 0, 0, -2, 1, -5, 0, 3, 0},
+  {0, -1, 2, -2, 1, -5, 0, 3, 0},
+  {2, 0, 2, 0, 1, -5, 0, 3, 0},
+  {1, -1, 0, 0, 0, 5, 0, 0, 0},
+  {1, 0, 0, -1, 0, -4, 0, 0, 0},
+  {0, 0, 0, 1, 0, -4, 0, 0, 0},
+  {0, 1, 0, -2, 0, -4, 0, 0, 0},
+  {1, 0, -2, 0, 0, 4, 0, 0, 0},
+  {2, 0, 0, -2, 1, 4, 0, -2, 0},
+  {0, 1, 2, -2, 1, 4, 0, -2, 0},
+  {1, 1, 0, 0, 0, -3, 0, 0, 0},
+  {1, -1, 0, -1, 0, -3, 0, 0, 0},
+  {-1, -1, 2, 2, 2, -3, 0, 1, 0},
+  {0, -1, 2, 2, 2, -3, 0, 1, 0},
+  {1, -1, 2, 0, 2, -3, 0, 1, 0},
+  {3, 0, 2, 0, 2, -3, 0, 1, 0},
+  {-2, 0, 2, 0, 2, -3, 0, 1, 0},
+  {1, 0, 2, 0, 0, 3, 0, 0, 0},
+  {-1, 0, 2, 4, 2, -2, 0, 1, 0},
+  {1, 0, 0, 0, 2, -2, 0, 1, 0},
+  {-1, 0, 2, -2, 1, -2, 0, 1, 0},
+  {0, -2, 2, -2, 1, -2, 0, 1, 0},
+  {-2, 0, 0, 0, 1, -2, 0, 1, 0},
+  {2, 0, 0, 0, 1, 2, 0, -1, 0},
+  {3, 0, 0, 0, 0, 2, 0, 0, 0},
+  {1, 1, 2, 0, 2, 2, 0, -1, 0},
+  {0, 0, 2, 1, 2, 2, 0, -1, 0},
+  {1, 0, 0, 2, 1, -1, 0, 0, 0},
+  {1, 0, 2, 2, 1, -1, 0, 1, 0},
+  {1, 1, 0, -2, 1, -1, 0, 0, 0},
+  {0, 1, 0, 2, 0, -1, 0, 0, 0},
+  {0, 1, 2, -2, 0, -1, 0, 0, 0},
+  {0, 1, -2, 2, 0, -1, 0, 0, 0},
+  {1, 0, -2, 2, 0, -1, 0, 0, 0},
+  {1, 0, -2, -2, 0, -1, 0, 0, 0},
+  {1, 0, 2, -2, 0, -1, 0, 0, 0},
+  {1, 0, 0, -4, 0, -1, 0, 0, 0},
+  {2, 0, 0, -4, 0, -1, 0, 0, 0},
+  {0, 0, 2, 4, 2, -1, 0, 0, 0},
+  {0, 0, 2, -1, 2, -1, 0, 0, 0},
+  {-2, 0, 2, 4, 2, -1, 0, 1, 0},
+  {2, 0, 2, 2, 2, -1, 0, 0, 0},
+  {0, -1, 2, 0, 1, -1, 0, 0, 0},
+  {0, 0, -2, 0, 1, -1, 0, 0, 0},
+  {0, 0, 4, -2, 2, 1, 0, 0, 0},
+  {0, 1, 0, 0, 2, 1, 0, 0, 0},
+  {1, 1, 2, -2, 2, 1, 0, -1, 0},
+  {3, 0, 2, -2, 2, 1, 0, 0, 0},
+  {-2, 0, 2, 2, 2, 1, 0, -1, 0},
+  {-1, 0, 0, 0, 2, 1, 0, -1, 0},
+  {0, 0, -2, 2, 1, 1, 0, 0, 0},
+  {0, 1, 2, 0, 1, 1, 0, 0, 0},
+  {-1, 0, 4, 0, 2, 1, 0, 0, 0},
+  {2, 1, 0, -2, 0, 1, 0, 0, 0},
+  {2, 0, 0, 2, 0, 1, 0, 0, 0},
+  {2, 0, 2, -2, 1, 1, 0, -1, 0},
+  {2, 0, -2, 0, 1, 1, 0, 0, 0},
+  {1, -1, 0, -2, 0, 1, 0, 0, 0},
+  {-1, 0, 0, 1, 1, 1, 0, 0, 0},
+  {-1, -1, 0, 2, 1, 1, 0, 0, 0},
+  {0, 1, 0, 1, 0, 1, 0, 0, 0}
 };
 
 /*
@@ -134,6 +169,26 @@ radians
 */
 std::array<double, 3> earth_precession(DateTime &epoch);
 
+/*
+Calculate the zeta, theta, and zed angles of precession in radians
+
+@param t TDB Julian centuries since J2000
+@returns (std::array<double, 3>) Earth precession values (zeta, theta, zed) in
+radians
+*/
+std::array<double, 3> earth_precession(double t);
+
+/*
+Calculate the fundamental (Delaunay) arguments of the lunisolar nutation
+series in radians
+
+@param t TDB Julian centuries since J2000
+@returns (std::array<double, 5>) Moon anomaly (l), Sun anomaly (l'), Moon
+argument of latitude (F), Moon elongation from the Sun (D), and Moon RAAN
+(Omega) in radians
+*/
+std::array<double, 5> nutation_arguments(double t);
+
 /* 
 Calculate the delta psi, delta epsilon, and mean epsilon angles of nutation in radians
 
@@ -143,4 +198,75 @@ Currently uses IAU 1980 nutation
 */
 std::array<double, 3> earth_nutation(DateTime &epoch, int n = 106);
 
+/*
+Calculate the delta psi, delta epsilon, and mean epsilon angles of nutation in
+radians
+
+Evaluates the sine and cosine of each fundamental argument once, then builds
+every term with angle-addition recurrences instead of calling sin and cos per
+term.
+
+@param t TDB Julian centuries since J2000
+@param n Number of terms of the IAU 1980 series to include (up to 106)
+@returns (std::array<double, 3>) Earth nutation values (delta psi, delta
+epsilon, mean epsilon) in radians
+*/
+std::array<double, 3> earth_nutation(double t, int n = 106);
+
+/*
+Select the Earth orientation model of the ITRF/ICRF rotation
+
+Not safe to call while other threads convert coordinates
+
+@param model Earth orientation model (IAU_1980 by default)
+@throws exceptions::ArcException if IAU_2006 is selected before its series
+are loaded into CIP_MODEL
+*/
+void set_earth_model(EarthModel model);
+
+/*
+Get the Earth orientation model of the ITRF/ICRF rotation
+
+@returns (earth_model::EarthModel) Selected Earth orientation model
+*/
+EarthModel get_earth_model();
+
+/*
+Calculate the rotation from the Celestial Intermediate Reference System
+(CIRS) to ICRF
+
+Uses the IAU 2006/2000A CIP coordinates and CIO locator of CIP_MODEL (the
+rotation of the CIP is slow enough that its rate is neglected)
+
+@param epoch Time at which to calculate the rotation
+@returns (rotations::Rotation) Rotation mapping CIRS vectors into ICRF
+@throws exceptions::ArcException if the IAU 2006/2000A series are not loaded
+*/
+Rotation cirs_to_icrf(DateTime &epoch);
+
+/*
+Calculate the rotation from the Earth-fixed ITRF to ICRF
+
+Composes polar motion, Earth rotation (with its rate), nutation, and
+precession into one rotation, which can then be applied to any number of
+states at the epoch. Uses the model selected with set_earth_model.
+
+@param epoch Time at which to calculate the rotation
+@returns (rotations::Rotation) Rotation mapping ITRF vectors into ICRF
+*/
+Rotation itrf_to_icrf(DateTime &epoch);
+
+/*
+Calculate the rotation from TEME to ICRF
+
+Composes the equation of the equinoxes, nutation, and precession into one
+rotation (TEME does not rotate with the Earth, so the rate is zero).
+TEME is defined by the equinox-based theory used by SGP4, so this always uses
+IAU 1980 precession and nutation, whichever model is selected.
+
+@param epoch Time at which to calculate the rotation
+@returns (rotations::Rotation) Rotation mapping TEME vectors into ICRF
+*/
+Rotation teme_to_icrf(DateTime &epoch);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef BATCH_CONVERSION_H
+#define BATCH_CONVERSION_H
+#include <geodetic.h>
+#include <icrf.h>
+#include <itrf.h>
+
+#include <vector>
+
+/*
+Batch coordinate conversions
+
+Convert arrays of states at once. The ITRF/ICRF rotation is composed once per
+distinct epoch (states at the same epoch share it, wherever they are in the
+array), and both the rotations and the states are split across worker
+threads.
+*/
+
+/*
+Rotate ICRF states into ITRF
+
+@param states Earth-centered ICRF states
+@param threads Number of worker threads (0 uses the hardware concurrency)
+@returns (std::vector<itrf::ITRF>) ITRF states in the same order
+*/
+std::vector<ITRF> to_itrf(std::vector<ICRF> &states, unsigned threads = 0);
+
+/*
+Rotate ITRF states into ICRF
+
+@param states ITRF states
+@param threads Number of worker threads (0 uses the hardware concurrency)
+@returns (std::vector<icrf::ICRF>) Earth-centered ICRF states in the same order
+*/
+std::vector<ICRF> to_icrf(std::vector<ITRF> &states, unsigned threads = 0);
+
+/*
+Convert ITRF states to geodetic coordinates
+
+@param states ITRF states
+@param threads Number of worker threads (0 uses the hardware concurrency)
+@returns (std::vector<geodetic::Geodetic>) Geodetic coordinates in the same
+order
+*/
+std::vector<Geodetic> to_geodetic(std::vector<ITRF> &states,
+                                  unsigned threads = 0);
+
+/*
+Convert ICRF states to geodetic coordinates
+
+Rotates each state into ITRF without storing the intermediate states
+
+@param states Earth-centered ICRF states
+@param threads Number of worker threads (0 uses the hardware concurrency)
+@returns (std::vector<geodetic::Geodetic>) Geodetic coordinates in the same
+order
+*/
+std::vector<Geodetic> to_geodetic(std::vector<ICRF> &states,
+                                  unsigned threads = 0);
+
+#endif
\ No newline at end of file
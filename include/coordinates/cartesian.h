@@ -40,7 +40,7 @@ public:
   @param pos (vectors::Vector3) position vector of the state in meters
   @param vel (vectors::Vector3) velocity vector of the state in meters per second
   */
-  Cartesian(CelestialBody& body, DateTime& epoch, Vector3& pos, Vector3& vel);
+  Cartesian(CelestialBody body, DateTime& epoch, Vector3& pos, Vector3& vel);
 
   /*
   Constructor from KeplerianElements
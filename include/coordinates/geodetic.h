@@ -0,0 +1,96 @@
+#ifndef GEODETIC_H
+#define GEODETIC_H
+#include <celestial.h>
+#include <datetime.h>
+#include <vectors.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Forward declaration
+class ITRF;
+
+/*
+Geodetic coordinates on the reference ellipsoid of a body
+
+The ellipsoid is defined by the equatorial and polar radii of the central
+body (WGS 84 for Earth)
+*/
+class Geodetic {
+public:
+  // Central body of the reference ellipsoid
+  CelestialBody central_body;
+  // Epoch at which the coordinates are valid
+  DateTime epoch;
+  // Geodetic latitude in radians (-pi/2 to pi/2)
+  double latitude;
+  // Longitude in radians (-pi to pi, east positive)
+  double longitude;
+  // Height above the ellipsoid in meters
+  double altitude;
+
+  // Default constructor (zero coordinates on the Earth ellipsoid at J2000)
+  Geodetic();
+
+  /*
+  Direct constructor
+
+  @param body Body of the reference ellipsoid
+  @param epoch Epoch at which the coordinates are valid
+  @param latitude Geodetic latitude in radians
+  @param longitude Longitude in radians
+  @param altitude Height above the ellipsoid in meters
+  */
+  Geodetic(CelestialBody body, DateTime &epoch, double latitude,
+           double longitude, double altitude);
+
+  /*
+  Constructor from ITRF
+
+  Uses Vermeille's closed-form solution (no iteration), accurate to well
+  below a millimeter anywhere farther than about 50 km from the center of
+  the body
+
+  Ref: Vermeille, H. (2004). Computing geodetic coordinates from geocentric
+  coordinates. Journal of Geodesy, 78(1), 94-95.
+
+  @param fixed Body-fixed state to convert
+  */
+  Geodetic(ITRF &fixed);
+
+  /*
+  Calculate the body-fixed position of these coordinates
+
+  @returns (vectors::Vector3) ITRF position in meters
+  */
+  Vector3 to_position();
+};
+
+/*
+Create a text ground track from geodetic coordinates
+
+Each line holds the epoch (ISO 8601), latitude and longitude in degrees, and
+altitude in meters
+
+@param track Geodetic coordinates in time order
+@returns (std::vector<std::string>) Lines of the ground track
+*/
+std::vector<std::string> format_ground_track(std::vector<Geodetic> &track);
+
+/*
+Write geodetic coordinates to a text ground track
+
+Each line holds the epoch (ISO 8601), latitude and longitude in degrees, and
+altitude in meters
+
+@param track Geodetic coordinates in time order
+@param filename File system location at which to write the ground track
+@throws exceptions::ArcException if the file cannot be written
+*/
+void write_ground_track(std::vector<Geodetic> &track, const char filename[]);
+
+// I/O stream
+std::ostream& operator << (std::ostream &out, Geodetic& geo);
+
+#endif
\ No newline at end of file
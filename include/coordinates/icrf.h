@@ -2,8 +2,9 @@
 #define ICRF_H
 #include <cartesian.h>
 
-// Forward declaration
+// Forward declarations
 class ITRF;
+class TEME;
 
 // Cartesian state in the International Celestial Reference Frame (~J2000)
 class ICRF : public Cartesian {
@@ -12,11 +13,14 @@ public:
   ICRF();
 
   // Direct constructor
-  ICRF(CelestialBody &body, DateTime &epoch, Vector3 &pos, Vector3 &vel);
+  ICRF(CelestialBody body, DateTime &epoch, Vector3 &pos, Vector3 &vel);
 
   // Constructor from ITRF
   ICRF(ITRF &fixed);
 
+  // Constructor from TEME
+  ICRF(TEME &teme);
+
   // Constructor from KeplerianElements
   ICRF(KeplerianElements &el);
 
@@ -24,7 +28,7 @@ public:
   ICRF to_solar();
 
   // Convert position/velocity vectors into the ICRF frame centered around another celestial body's position
-  ICRF change_central_body(CelestialBody &body);
+  ICRF change_central_body(CelestialBody body);
 };
 
 // I/O stream 
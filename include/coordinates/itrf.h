@@ -12,7 +12,7 @@ public:
   ITRF();
 
   // Direct constructor
-  ITRF(CelestialBody &body, DateTime &epoch, Vector3 &pos, Vector3 &vel);
+  ITRF(CelestialBody body, DateTime &epoch, Vector3 &pos, Vector3 &vel);
 
   // Constructor from ICRF
   ITRF(ICRF &inertial);
@@ -3,7 +3,9 @@
 #include <celestial.h>
 #include <datetime.h>
 #include <propagator.h>
+#include <vectors.h>
 
+#include <cstddef>
 #include <iostream>
 
 // Forward declaration
@@ -33,7 +35,7 @@ class KeplerianElements {
   KeplerianElements();
 
   // Direct constructor
-  KeplerianElements(CelestialBody &body, DateTime epoch, double a, double e,
+  KeplerianElements(CelestialBody body, DateTime epoch, double a, double e,
                     double i, double o, double w, double v);
 
   // Constructor using Cartesian instance
@@ -42,13 +44,77 @@ class KeplerianElements {
   // Print to std::cout
   void print();
 
-  // Compute mean motion
+  // Compute mean motion (valid for elliptic and hyperbolic orbits)
   double mean_motion();
 
+  // Compute the mean anomaly from the true anomaly (hyperbolic mean anomaly
+  // for eccentricities above one)
+  double mean_anomaly();
+
+  /*
+  Compute the true anomaly corresponding to an eccentric anomaly
+
+  @param ecc_anom Eccentric anomaly (hyperbolic anomaly for eccentricities
+  above one) in radians
+  @returns (double) True anomaly in radians
+  */
+  double true_anomaly(double ecc_anom);
+
   // Propagate the True Anomaly of the elements to a specified epoch
   KeplerianElements propagate_to(DateTime &t);
 };
 
+/*
+Solve Kepler's equation for the eccentric anomaly
+
+Elliptic orbits (e < 1) solve M = E - e sin(E), hyperbolic orbits (e > 1)
+solve M = e sinh(H) - H. Both use Danby's starting value and his fourth-order
+correction, which converges to machine precision within a few iterations for
+any eccentricity.
+
+Ref: Danby, J. M. A. (1988). The Solution of Kepler's Equation.
+In Fundamentals of celestial mechanics (pp. 149-154). Richmond: Willmann-Bell.
+
+@param mean_anom Mean anomaly in radians
+@param e Eccentricity
+@returns (double) Eccentric (or hyperbolic) anomaly in radians
+*/
+double solve_kepler(double mean_anom, double e);
+
+/*
+Solve Kepler's equation for a batch of elliptic orbits
+
+Every element takes the same fixed number of Danby corrections, so the loops
+are free of data-dependent branches and can be vectorized by the compiler.
+
+@param n Number of elements in the batch
+@param mean_anom Mean anomalies in radians
+@param e Eccentricities (each below one)
+@param ecc_anom Array of length n into which the eccentric anomalies are
+written (in the range [-pi, pi])
+*/
+void solve_kepler_batch(size_t n, const double mean_anom[], const double e[],
+                        double ecc_anom[]);
+
+/*
+Propagate a two-body state using universal variables
+
+Valid for elliptic, parabolic, and hyperbolic orbits without any conversion to
+orbital elements.
+
+Ref: Vallado, D. A. (2013). Kepler's Problem. In Fundamentals of
+astrodynamics and applications (pp. 92-101). Hawthorne, CA: Microcosm Press.
+
+@param mu Gravitational parameter of the central body
+@param r_0 Initial position
+@param v_0 Initial velocity
+@param dt Seconds to propagate (forward or backward)
+@param r Position after dt seconds
+@param v Velocity after dt seconds
+*/
+void propagate_universal(double mu, Vector3 &r_0, Vector3 &v_0, double dt,
+                         Vector3 &r, Vector3 &v);
+
 // Propagator using Kepler's method
 class KeplerianPropagator : public Propagator {
  public:
@@ -60,6 +126,10 @@ class KeplerianPropagator : public Propagator {
 
   // Propagate the inital state to specified epoch
   ICRF propagate(DateTime &epoch);
+
+  // Create an Ephemeris by propagating over an interval, solving Kepler's
+  // equation for every epoch as a single batch
+  Ephemeris step(DateTime &start, DateTime &stop, double step);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef TEME_H
+#define TEME_H
+#include <cartesian.h>
+
+// Forward declaration
+class ICRF;
+
+/*
+Cartesian state in the True Equator Mean Equinox frame
+
+The frame in which SGP4/SDP4 produce states from two-line element sets. It
+shares the true equator of date with TOD, but measures right ascension from the
+mean equinox, so the two differ by a rotation about Z of the equation of the
+equinoxes.
+
+Ref: Vallado, D. A., Crawford, P., Hujsak, R., & Kelso, T. S. (2006).
+Revisiting Spacetrack Report #3. AIAA 2006-6753.
+*/
+class TEME : public Cartesian {
+public:
+  // Default constructor (call base class)
+  TEME();
+
+  // Direct constructor
+  TEME(CelestialBody body, DateTime &epoch, Vector3 &pos, Vector3 &vel);
+
+  // Constructor from ICRF
+  TEME(ICRF &inertial);
+};
+
+// I/O stream
+std::ostream& operator << (std::ostream &out, TEME& teme);
+
+#endif
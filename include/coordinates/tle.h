@@ -0,0 +1,75 @@
+#ifndef TLE_H
+#define TLE_H
+#include <datetime.h>
+
+#include <string>
+#include <vector>
+
+/*
+NORAD two-line element set
+
+Mean elements in the form expected by SGP4/SDP4 (angles in radians, mean motion
+in radians per minute). The elements are only meaningful to SGP4/SDP4 and
+should not be treated as osculating Keplerian elements.
+
+Ref: Vallado, D. A., Crawford, P., Hujsak, R., & Kelso, T. S. (2006).
+Revisiting Spacetrack Report #3. AIAA 2006-6753.
+*/
+class TwoLineElement {
+public:
+  // Name of the object (from the optional title line)
+  std::string name;
+  // Catalog number
+  std::string satnum;
+  // Epoch of the elements (UTC)
+  DateTime epoch;
+  // Epoch as days since 1950 Jan 0.0 UTC (the SGP4 epoch reference)
+  double epoch_ds50;
+  // First derivative of the mean motion (radians per minute^2)
+  double ndot;
+  // Second derivative of the mean motion (radians per minute^3)
+  double nddot;
+  // Drag term (per Earth radius)
+  double bstar;
+  // Inclination (radians)
+  double inclination;
+  // Right ascension of the ascending node (radians)
+  double raan;
+  // Eccentricity
+  double eccentricity;
+  // Argument of perigee (radians)
+  double arg_perigee;
+  // Mean anomaly (radians)
+  double mean_anomaly;
+  // Kozai mean motion (radians per minute)
+  double mean_motion;
+
+  // Default constructor
+  TwoLineElement();
+
+  /*
+  Constructor from the two element lines
+
+  @param line_1 First line of the element set
+  @param line_2 Second line of the element set
+  @throws exceptions::ArcException if the lines are malformed
+  */
+  TwoLineElement(std::string line_1, std::string line_2);
+};
+
+/*
+Read a file of two-line element sets
+
+Both the two-line and three-line (with a title line) formats are accepted
+
+@param filepath Element set file location in the filesystem
+@returns (std::vector<tle::TwoLineElement>) Element sets in file order
+@throws exceptions::ArcException if the file cannot be read or an element set
+is malformed
+*/
+std::vector<TwoLineElement> read_tle_file(const char filepath[]);
+
+// I/O stream
+std::ostream& operator << (std::ostream &out, TwoLineElement& tle);
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef COVARIANCE_H
+#define COVARIANCE_H
+#include <celestial.h>
+#include <datetime.h>
+#include <matrices.h>
+
+#include <string>
+#include <vector>
+
+/*
+Table of position/velocity covariances
+
+Covariances are always expressed in ICRF axes (m^2, m^2/s, m^2/s^2), centered
+around a single body
+*/
+class CovarianceEphemeris {
+public:
+  // Epochs of the covariance points
+  std::vector<DateTime> epochs;
+  // Position/velocity covariance at each epoch
+  std::vector<Matrix6> covariances;
+  // Epoch of the covariance ephemeris
+  DateTime epoch;
+  // Celestial body origin of the states the covariances describe
+  CelestialBody central_body;
+
+  /*
+  Default constructor
+
+  Creates empty list of covariances, sets epoch to J2000 and central body to Sun
+  */
+  CovarianceEphemeris();
+
+  /*
+  Direct constructor
+
+  @param epochs Epochs of the covariance points
+  @param covariances Position/velocity covariance at each epoch
+  @param central_body Celestial body origin of the described states
+  */
+  CovarianceEphemeris(std::vector<DateTime> &epochs,
+                      std::vector<Matrix6> &covariances,
+                      CelestialBody central_body);
+
+  /*
+  Create ASCII covariance ephemeris in STK format (.e)
+
+  Each point is written as the time since epoch followed by the 21 lower
+  triangular elements of the covariance, row by row (CovarianceTimePosVel)
+
+  @returns Vector of ASCII lines comprising an STK ephemeris file
+  */
+  std::vector<std::string> format_stk();
+
+  /*
+  Write covariance ephemeris to file using STK format
+
+  @param filename File system location at which to write the new file
+  @throws exceptions::ArcException if the file cannot be written
+  */
+  void write_stk(const char filename[]);
+};
+
+#endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef EPHEMERIS_H
 #define EPHEMERIS_H
+#include <geodetic.h>
 #include <icrf.h>
+#include <itrf.h>
 #include <keplerian.h>
 #include <celestial.h>
 #include <propagator.h>
@@ -27,16 +29,31 @@ formatted ephemeris
 */
 void parse_stk(std::vector<std::string> &lines, Ephemeris &ephem);
 
+/*
+Number of states from start to stop (inclusive) at a fixed step
+
+Used to reserve ephemeris storage before propagating
+
+@param start Epoch of the first state
+@param stop Latest epoch of the last state
+@param step Step between states in seconds
+@returns (size_t) Number of states, or 0 if stop is before start
+*/
+size_t step_count(DateTime &start, DateTime &stop, double step);
+
 /*
 Table of astronomical positions/velocities
 
-States are always stored in ICRF, centered around a single body
+States are always stored in ICRF, centered around a single body. Rather than
+one ICRF per point (each repeating the central body and a full epoch), the
+table is stored as columns: seconds since the ephemeris epoch, then the X, Y,
+Z, VX, VY, and VZ components. All seven columns share one arena allocation,
+so an ephemeris of known length is allocated once and every column can be
+scanned contiguously.
 */
 class Ephemeris {
 public:
-  // Vector of ICRF states comprising the Ephemeris
-  std::vector<ICRF> states;
-  // Epoch of the ephemeris
+  // Epoch of the ephemeris (origin of the epoch offset column)
   DateTime epoch;
   // Celestial body origin of the ICRF states
   CelestialBody central_body;
@@ -48,6 +65,15 @@ public:
   */
   Ephemeris();
 
+  /*
+  Constructor with reserved storage
+
+  @param body Celestial body origin of the states
+  @param epoch Epoch of the ephemeris
+  @param capacity Number of states to reserve storage for
+  */
+  Ephemeris(CelestialBody body, DateTime &epoch, size_t capacity = 0);
+
   /*
   Direct constructor
 
@@ -66,6 +92,87 @@ public:
   */
   Ephemeris(const char filepath[]);
 
+  /*
+  Get the number of states in the ephemeris
+
+  @returns (size_t) Number of states
+  */
+  size_t size();
+
+  /*
+  Reserve storage for a number of states, relocating the columns at most once
+
+  @param capacity Number of states to reserve storage for
+  */
+  void reserve(size_t capacity);
+
+  /*
+  Resize the ephemeris, zeroing any added states
+
+  Lets callers fill states by index (e.g. from several worker threads)
+
+  @param count New number of states
+  */
+  void resize(size_t count);
+
+  /*
+  Append a state
+
+  @param offset Seconds since the ephemeris epoch
+  @param position ICRF position in meters
+  @param velocity ICRF velocity in meters per second
+  */
+  void push_back(double offset, const Vector3 &position,
+                 const Vector3 &velocity);
+
+  /*
+  Append an ICRF state
+
+  The first state appended to an empty ephemeris sets its epoch and central
+  body
+
+  @param state ICRF state centered on the central body of the ephemeris
+  */
+  void push_back(ICRF &state);
+
+  /*
+  Get the epoch offset column
+
+  @returns (double*) Seconds since the ephemeris epoch of each state
+  */
+  double* offsets();
+
+  /*
+  Get a state component column
+
+  @param index Component index (0-2 position, 3-5 velocity)
+  @returns (double*) Component of each state in meters or meters per second
+  */
+  double* component(int index);
+
+  /*
+  Get the epoch of a state
+
+  @param index Index of the state
+  @returns (datetime::DateTime) Epoch of the state
+  */
+  DateTime state_epoch(size_t index);
+
+  /*
+  Get a state as ICRF
+
+  @param index Index of the state
+  @returns (icrf::ICRF) State at the index
+  */
+  ICRF state(size_t index);
+
+  /*
+  Get every state as ICRF
+
+  @returns (std::vector<icrf::ICRF>) States in ephemeris order
+  */
+  std::vector<ICRF> states();
+
   /*
   Use Keplerian estimation to obtain an interpolated ICRF
   state by using the nearest (by time) ICRF value contained in the ephemeris
@@ -75,6 +182,25 @@ public:
   */
   ICRF interpolate(DateTime &requested);
 
+  /*
+  Rotate every state into ITRF
+
+  Each distinct epoch is rotated once, split across worker threads
+
+  @param threads Number of worker threads (0 uses the hardware concurrency)
+  @returns (std::vector<itrf::ITRF>) ITRF states in ephemeris order
+  */
+  std::vector<ITRF> to_itrf(unsigned threads = 0);
+
+  /*
+  Convert every state to geodetic coordinates
+
+  @param threads Number of worker threads (0 uses the hardware concurrency)
+  @returns (std::vector<geodetic::Geodetic>) Geodetic coordinates in
+  ephemeris order
+  */
+  std::vector<Geodetic> to_geodetic(unsigned threads = 0);
+
   /*
   Create ASCII ephemeris in STK format (.e)
 
@@ -88,6 +214,15 @@ public:
   @param filename File system location at which to write the new ephemeris file
   */
   void write_stk(const char filename[]);
+
+private:
+  // Arena holding the epoch offset column followed by the six component
+  // columns, each 'capacity' long
+  std::vector<double> arena;
+  // Number of states
+  size_t count;
+  // Number of states the columns can hold
+  size_t capacity;
 };
 
 // I/O stream 
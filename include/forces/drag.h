@@ -1,6 +1,7 @@
 #ifndef DRAG_H
 #define DRAG_H
 #include <icrf.h>
+#include <matrices.h>
 #include <vectors.h>
 #include <celestial.h>
 
@@ -46,6 +47,15 @@ public:
     @param sc_state Spacecraft inertial state
     */
     Vector3 acceleration(ICRF& sc_state);
+
+    /*
+    Add the partial derivatives of drag acceleration with respect to spacecraft
+    position and velocity into a state Jacobian
+
+    @param sc_state Spacecraft inertial state
+    @param jacobian State Jacobian to which the partials are added
+    */
+    void partials(ICRF& sc_state, Matrix6& jacobian);
 };
 
 #endif
\ No newline at end of file
@@ -3,11 +3,29 @@
 #include <drag.h>
 #include <gravity.h>
 #include <icrf.h>
+#include <matrices.h>
+#include <solar_radiation.h>
 #include <vectors.h>
 
+#include <array>
 #include <iostream>
 #include <vector>
 
+/*
+Position of a celestial body relative to a spacecraft's central body at an
+epoch, kept so that bodies are propagated once per epoch
+*/
+struct BodyPositionCache {
+  // NAIF ID of the body
+  int body_id;
+  // NAIF ID of the central body the position is relative to
+  int central_body_id;
+  // Epoch of the position (seconds since J2000)
+  double epoch;
+  // Position of the body in meters
+  Vector3 position;
+};
+
 /*
 Acceleration force model
 
@@ -18,12 +36,38 @@ class ForceModel {
   std::vector<GravityModel> gravity_models;
   // Atmospheric drag model to utilize
   DragModel drag_model;
+  // Flag to determine if atmospheric drag should be modeled
+  bool has_drag;
+  // Solar radiation pressure model to utilize
+  SolarRadiationModel srp_model;
+  // Flag to determine if solar radiation pressure should be modeled
+  bool has_srp;
+  // Recently computed body positions, enough to cover the distinct epochs of a
+  // few integration steps for several bodies
+  std::array<BodyPositionCache, 16> body_cache;
+  // Index of the next cache entry to replace
+  size_t body_cache_next;
+
+  /*
+  Get the position of a body relative to the central body of a spacecraft
+  state, reusing any position already computed at the state's epoch
+
+  @param body Celestial body for which to obtain the position
+  @param state ICRF state providing the epoch and central body
+  @returns Position of the body relative to the state's central body in meters
+  */
+  Vector3 body_position(CelestialBody body, ICRF& state);
 
 public:
+  // Number of acceleration evaluations made with this model, used to compare
+  // the cost of propagators
+  size_t evaluations;
+
   /*
   Default constructor
 
-  Set gravity_models to empty vector
+  Set gravity_models to empty vector, with drag and solar radiation pressure
+  disabled
   */
   ForceModel();
 
@@ -58,6 +102,13 @@ public:
   */
   void set_drag_model(DragModel model);
 
+  /*
+  Change solar radiation pressure model
+
+  @param model Solar radiation pressure model to use
+  */
+  void set_srp_model(SolarRadiationModel model);
+
   /*
   Get total acceleration force at a given state
 
@@ -66,6 +117,38 @@ public:
   */
   Vector3 acceleration(ICRF& state);
 
+  /*
+  Determine whether the model is limited to the gravity of a state's central
+  body, as required by integrators that differentiate the equations of motion
+  analytically
+
+  @param state ICRF state from which to determine central body
+  @param is_aspherical Set to the aspherical flag of the central-body model
+  @returns True if central-body gravity is the only force modeled
+  */
+  bool central_gravity_only(ICRF& state, bool& is_aspherical);
+
+  /*
+  Determine whether every modeled force is conservative (derived from a
+  potential that depends only on position and time), as required by
+  symplectic integrators
+
+  @returns True if neither drag nor solar radiation pressure is modeled
+  */
+  bool is_conservative();
+
+  /*
+  Get the Jacobian of the state derivative (velocity/acceleration) with respect
+  to position and velocity at a given state
+
+  Analytic partials of gravity and drag accelerations are included, solar
+  radiation pressure partials are small and neglected
+
+  @param state ICRF state at which to determine the Jacobian
+  @returns Jacobian of the state derivative at the given state
+  */
+  Matrix6 jacobian(ICRF& state);
+
   // I/O stream operator
   friend std::ostream& operator<<(std::ostream& out, ForceModel& fm);
 };
@@ -2,6 +2,7 @@
 #define GRAVITY_H
 #include <celestial.h>
 #include <icrf.h>
+#include <matrices.h>
 #include <vectors.h>
 
 #include <iostream>
@@ -16,9 +17,21 @@ class GravityModel {
   // Calculate acceleration due to gravity, assuming a spherical body
   Vector3 spherical(ICRF &sc_state);
 
+  // Calculate acceleration due to gravity of a spherical third body at a known
+  // position relative to the spacecraft's central body
+  Vector3 third_body(ICRF &sc_state, Vector3 &body_position);
+
   // Calculate the aspherical components of acceleration due to gravity
   Vector3 aspherical(ICRF &sc_state);
 
+  // Add the partial derivatives of point-mass gravity with respect to position,
+  // given the spacecraft position relative to the body
+  void spherical_partials(Vector3 &relative_position, Matrix6 &jacobian);
+
+  // Add the partial derivatives of the aspherical components of gravity with
+  // respect to position
+  void aspherical_partials(ICRF &sc_state, Matrix6 &jacobian);
+
  public:
   // Body this model represents
   CelestialBody body;
@@ -35,10 +48,23 @@ class GravityModel {
   GravityModel();
 
   // Direct constructor
-  GravityModel(CelestialBody &body, GeopotentialModel model, bool is_aspherical, int degree, int order);
+  GravityModel(CelestialBody body, GeopotentialModel model, bool is_aspherical, int degree, int order);
 
   // Calculate acceleration on a spacecraft due to gravity, given its ICRF state
   Vector3 acceleration(ICRF &state);
+
+  // Calculate acceleration on a spacecraft due to gravity, given its ICRF state
+  // and the position of this model's body relative to the state's central body
+  Vector3 acceleration(ICRF &state, Vector3 &body_position);
+
+  // Add the partial derivatives of central-body gravity acceleration with
+  // respect to spacecraft position into a state Jacobian
+  void partials(ICRF &state, Matrix6 &jacobian);
+
+  // Add the partial derivatives of third-body gravity acceleration with respect
+  // to spacecraft position into a state Jacobian, given the position of this
+  // model's body relative to the state's central body
+  void partials(ICRF &state, Vector3 &body_position, Matrix6 &jacobian);
 };
 
 // I/O stream
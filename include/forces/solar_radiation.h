@@ -0,0 +1,63 @@
+#ifndef SOLAR_RADIATION_H
+#define SOLAR_RADIATION_H
+#include <celestial.h>
+#include <icrf.h>
+#include <vectors.h>
+
+// Astronomical unit in meters
+const double ASTRONOMICAL_UNIT = 149597870700.0;
+
+// Solar radiation pressure at one astronomical unit in N/m^2
+const double SOLAR_PRESSURE_AU = 4.56e-6;
+
+enum ShadowModel {
+    // Cylindrical shadow (full sunlight or umbra)
+    Cylindrical,
+    // Conical shadow (umbra and penumbra)
+    Conical
+};
+
+/*
+Solar radiation pressure model
+
+Shadowing is computed against the central body of the spacecraft state
+
+Ref: Montenbruck, O., & Gill, E. (2012). Solar Radiation Pressure
+In Satellite orbits: Models, methods, and applications (pp. 77-83). Berlin: Springer-Verlag.
+*/
+class SolarRadiationModel {
+public:
+    // Shadow model
+    ShadowModel shadow_model;
+    // Spacecraft mass
+    double mass;
+    // Spacecraft area
+    double area;
+    // Spacecraft reflectivity coefficient
+    double cr;
+
+    // Default constructor
+    SolarRadiationModel();
+
+    // Direct constructor
+    SolarRadiationModel(ShadowModel model, double mass, double area, double cr);
+
+    /*
+    Calculate the fraction of the solar disk visible from the spacecraft
+
+    @param sc_state Spacecraft inertial state
+    @param sun_position Position of the Sun relative to the spacecraft's central body
+    @returns (double) Illumination fraction, from 0 (umbra) to 1 (full sunlight)
+    */
+    double illumination(ICRF& sc_state, Vector3& sun_position);
+
+    /*
+    Calculate the acceleration due to solar radiation pressure
+
+    @param sc_state Spacecraft inertial state
+    @param sun_position Position of the Sun relative to the spacecraft's central body
+    */
+    Vector3 acceleration(ICRF& sc_state, Vector3& sun_position);
+};
+
+#endif
\ No newline at end of file
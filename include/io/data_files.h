@@ -1,6 +1,8 @@
 #ifndef DATA_FILES_H
 #define DATA_FILES_H
 #include <file_io.h>
+#include <leap_seconds.h>
+#include <time_scales.h>
 #include <cstdio>
 #include <vector>
 #include <array>
@@ -11,51 +13,82 @@ Earth Orientation Parameter files, leap second announcements, etc
 */
 class DataFileHandler {
 
-    /*
-    Read/parse the leap seconds file
-
-    Open/parse the leap seconds file and add the values to the leap_seconds vector
-    */
-    void parse_leap_seconds();
+    // Leap seconds as constant segments, searched with a cached index
+    OffsetTable leap_second_table;
 
-    void parse_finals();
+    // Rebuild the leap second segments from the leap_seconds vector
+    void build_leap_second_table();
 
 public:
     // List of all known leap second times and values (sec. since J2000, Leap second value)
     std::vector<std::array<double, 2>> leap_seconds;
-    // List of finals.all data lines
+    // Daily Earth orientation parameters from finals.all (MJD, polar motion x
+    // and y in radians, UT1-UTC in seconds, excess length of day in seconds,
+    // and the nutation corrections dPsi and dEps in radians)
     std::vector<std::array<double, 7>> finals_data;
 
     /*
     Default constructor
 
-    Assigns member variables to empty vectors
+    Loads the built-in leap second table and assigns an empty finals.all vector
     */
     DataFileHandler();
 
+    /*
+    Replace the leap seconds with those of a leap seconds file
+
+    Each line holds the start of an interval (seconds since J2000) and the
+    leap second value over it. Not safe to call while other threads look up
+    leap seconds.
+    @param filename Location in the filesystem of the leap seconds file
+    @throws exceptions::ArcException if the file cannot be read, has no
+    entries, or is not in increasing order
+    */
+    void load_leap_seconds(const char filename[]);
+
     /*
     Get the number of leap seconds used in offset
 
-    Determine the leap seconds value to use for a given epoch
+    Determine the leap seconds value to use for a given epoch with a binary
+    search, testing the most recently used interval first (safe to call from
+    multiple threads)
     @param seconds_since_j2000 Requested time given in seconds since J2000
     @returns (double) The leap second value at the given epoch
     */
     double get_leap_seconds(double seconds_since_j2000);
 
+    /*
+    Replace the Earth orientation parameters with those of an IERS finals.all
+    file
+
+    Reads the IERS (Bulletin A) values of the fixed-width columns, skipping
+    the trailing days that have no polar motion or UT1-UTC yet. Missing length
+    of day and nutation values are zero. Not safe to call while other threads
+    look up Earth orientation parameters.
+    @param filename Location in the filesystem of the finals.all file
+    @throws exceptions::ArcException if the file cannot be read or has no
+    entries
+    */
+    void load_finals(const char filename[]);
+
     /*
     Get the finals.all data at an epoch (modified Julian)
 
+    Interpolates linearly between the entries of finals_data (in increasing
+    order of MJD) around the epoch, holding the first or last entry outside
+    them. All values are zero if no finals.all data is loaded.
     @param mjd Modified Julian Date at which to find valid finals.all data
-    @returns (std::array<double, 7>) finals.all data as a series of doubles
+    @returns (std::array<double, 7>) Earth orientation parameters, in the
+    layout of finals_data
     */
     std::array<double, 7> get_finals(double mjd);
 };
 
 /*
-Static instance of DataFileHandler
+Shared instance of DataFileHandler
 
 A singleton prevents repeated parsing of data files, saving I/O overhead
 */
-static DataFileHandler DATA_FILES{};
+extern DataFileHandler DATA_FILES;
 
 #endif
\ No newline at end of file
@@ -1,6 +1,6 @@
 #ifndef MATH_UTILS_H
 #define MATH_UTILS_H
-#include <vector>
+#include <cstddef>
 
 // Convert an angle in degrees to radians
 double radians(double deg);
@@ -14,10 +14,16 @@ double arcsec_to_radians(double arcsec);
 // Convert an angle in milliarcseconds to radians
 double marcsec_to_radians(double marcsec);
 
-// Evaluate a polynomial given a variable (x) and its coefficients
+// Evaluate a polynomial given a variable (x) and its coefficients, using
+// Horner's method
 // Exponents start at zero and increase to the order given by the length of
-// 'coeffs'
-double eval_poly(double x, std::vector<double> coeffs);
+// 'coeffs', and 'i' is the first coefficient to include
+template <size_t N>
+constexpr double eval_poly(double x, const double (&coeffs)[N],
+                           size_t i = 0) {
+  return (i + 1 < N) ? coeffs[i] + x * eval_poly(x, coeffs, i + 1)
+                     : coeffs[i];
+}
 
 // Return the angle (original or inverse) that exists in the half plane of the
 // match argument (m)
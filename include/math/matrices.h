@@ -0,0 +1,367 @@
+#ifndef MATRICES_H
+#define MATRICES_H
+#include <exceptions.h>
+#include <vectors.h>
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+/*
+Three-by-three matrix
+
+Typically represents a linear mapping between two 3D vectors, such as a
+rotation between coordinate frames
+
+Defined entirely in this header (constexpr where C++11 allows) so that the
+arithmetic inlines into frame conversions
+*/
+class Matrix3 {
+public:
+  // Elements in row-major order
+  double elements[3][3];
+
+  /*
+  Default constructor
+
+  Sets all elements to zero
+  */
+  constexpr Matrix3() : elements{} {}
+
+  /*
+  Constructor using a diagonal value
+
+  @param diagonal Value of each diagonal element (1.0 creates an identity
+  matrix), all other elements are set to zero
+  */
+  constexpr Matrix3(double diagonal)
+    : elements{ { diagonal, 0.0, 0.0 }, { 0.0, diagonal, 0.0 },
+                { 0.0, 0.0, diagonal } } {}
+
+  /*
+  Constructor using rows
+
+  @param row_1 First row
+  @param row_2 Second row
+  @param row_3 Third row
+  */
+  constexpr Matrix3(const Vector3& row_1, const Vector3& row_2,
+                    const Vector3& row_3)
+    : elements{ { row_1.x, row_1.y, row_1.z }, { row_2.x, row_2.y, row_2.z },
+                { row_3.x, row_3.y, row_3.z } } {}
+
+  /*
+  Get a row
+
+  @param i Index of the row (0-2)
+  @returns (vectors::Vector3) The row
+  */
+  constexpr Vector3 row(int i) const {
+    return Vector3{ elements[i][0], elements[i][1], elements[i][2] };
+  }
+
+  /*
+  Get a column
+
+  @param j Index of the column (0-2)
+  @returns (vectors::Vector3) The column
+  */
+  constexpr Vector3 column(int j) const {
+    return Vector3{ elements[0][j], elements[1][j], elements[2][j] };
+  }
+
+  /*
+  Add another Matrix3 using element-wise addition
+
+  @param m Matrix to add element-wise
+  @returns (matrices::Matrix3) Matrix representing the element-wise sum
+  */
+  constexpr Matrix3 add(const Matrix3& m) const {
+    return Matrix3{ row(0).add(m.row(0)), row(1).add(m.row(1)),
+                    row(2).add(m.row(2)) };
+  }
+
+  /*
+  Scale by a scalar value using element-wise multiplication
+
+  @param scalar Number by which to multiply each element
+  @returns (matrices::Matrix3) scaled matrix
+  */
+  constexpr Matrix3 scale(double scalar) const {
+    return Matrix3{ row(0).scale(scalar), row(1).scale(scalar),
+                    row(2).scale(scalar) };
+  }
+
+  /*
+  Multiply by another Matrix3 (this * m)
+
+  @param m Matrix by which to multiply
+  @returns (matrices::Matrix3) Matrix product
+  */
+  constexpr Matrix3 multiply(const Matrix3& m) const {
+    return Matrix3{ m.transpose().multiply(row(0)),
+                    m.transpose().multiply(row(1)),
+                    m.transpose().multiply(row(2)) };
+  }
+
+  /*
+  Multiply a Vector3 (this * v)
+
+  @param v Vector by which to multiply
+  @returns (vectors::Vector3) Transformed vector
+  */
+  constexpr Vector3 multiply(const Vector3& v) const {
+    return Vector3{ row(0).dot(v), row(1).dot(v), row(2).dot(v) };
+  }
+
+  /*
+  Calculate the transpose
+
+  @returns (matrices::Matrix3) The transposed matrix
+  */
+  constexpr Matrix3 transpose() const {
+    return Matrix3{ column(0), column(1), column(2) };
+  }
+};
+
+/*
+Matrix3 operator functions
+*/
+
+// I/O stream
+inline std::ostream& operator << (std::ostream &out, const Matrix3& m) {
+  out << "[Matrix3] {";
+  for (int i = 0; i < 3; i++) {
+    out << std::endl << " ";
+    for (int j = 0; j < 3; j++) {
+      out << " " << m.elements[i][j];
+    }
+  }
+  out << " }";
+  return out;
+}
+
+// Element-wise addition
+constexpr Matrix3 operator + (const Matrix3& m_1, const Matrix3& m_2) {
+  return m_1.add(m_2);
+}
+
+// Element-wise subtraction
+constexpr Matrix3 operator - (const Matrix3& m_1, const Matrix3& m_2) {
+  return m_1.add(m_2.scale(-1.0));
+}
+
+// Element-wise multiplication by scalar
+constexpr Matrix3 operator * (const Matrix3& m_1, double scalar) {
+  return m_1.scale(scalar);
+}
+
+// Matrix product with another Matrix3
+constexpr Matrix3 operator * (const Matrix3& m_1, const Matrix3& m_2) {
+  return m_1.multiply(m_2);
+}
+
+// Matrix product with a Vector3
+constexpr Vector3 operator * (const Matrix3& m, const Vector3& v) {
+  return m.multiply(v);
+}
+
+/*
+Six-by-six matrix
+
+Typically represents a linear mapping between two six-element states, such as
+a state transition matrix or a covariance
+
+Defined entirely in this header so that the arithmetic inlines into the
+variational equations and covariance propagation
+*/
+class alignas(16) Matrix6 {
+public:
+  // Elements in row-major order
+  double elements[6][6];
+
+  /*
+  Default constructor
+
+  Sets all elements to zero
+  */
+  constexpr Matrix6() : elements{} {}
+
+  /*
+  Constructor using a diagonal value
+
+  @param diagonal Value of each diagonal element (1.0 creates an identity
+  matrix), all other elements are set to zero
+  */
+  Matrix6(double diagonal) : elements{} {
+    for (int i = 0; i < 6; i++) {
+      elements[i][i] = diagonal;
+    }
+  }
+
+  /*
+  Add another Matrix6 using element-wise addition
+
+  @param m Matrix to add element-wise
+  @returns (matrices::Matrix6) Matrix representing the element-wise sum
+  */
+  Matrix6 add(const Matrix6& m) const {
+    Matrix6 sum;
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        sum.elements[i][j] = elements[i][j] + m.elements[i][j];
+      }
+    }
+    return sum;
+  }
+
+  /*
+  Scale by a scalar value using element-wise multiplication
+
+  @param scalar Number by which to multiply each element
+  @returns (matrices::Matrix6) scaled matrix
+  */
+  Matrix6 scale(double scalar) const {
+    Matrix6 scaled;
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        scaled.elements[i][j] = elements[i][j] * scalar;
+      }
+    }
+    return scaled;
+  }
+
+  /*
+  Multiply by another Matrix6 (this * m)
+
+  @param m Matrix by which to multiply
+  @returns (matrices::Matrix6) Matrix product
+  */
+  Matrix6 multiply(const Matrix6& m) const {
+    Matrix6 product;
+    for (int i = 0; i < 6; i++) {
+      for (int k = 0; k < 6; k++) {
+        double a = elements[i][k];
+        for (int j = 0; j < 6; j++) {
+          product.elements[i][j] += a * m.elements[k][j];
+        }
+      }
+    }
+    return product;
+  }
+
+  /*
+  Multiply a Vector6 (this * v)
+
+  @param v Vector by which to multiply
+  @returns (vectors::Vector6) Transformed vector
+  */
+  Vector6 multiply(const Vector6& v) const {
+    double in[6] = {v.a, v.b, v.c, v.x, v.y, v.z};
+    double out[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        out[i] += elements[i][j] * in[j];
+      }
+    }
+    return Vector6{out[0], out[1], out[2], out[3], out[4], out[5]};
+  }
+
+  /*
+  Calculate the transpose
+
+  @returns (matrices::Matrix6) The transposed matrix
+  */
+  Matrix6 transpose() const {
+    Matrix6 transposed;
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        transposed.elements[j][i] = elements[i][j];
+      }
+    }
+    return transposed;
+  }
+
+  /*
+  Calculate the Cholesky decomposition of a symmetric positive definite matrix
+
+  Only the lower triangle of the matrix is read
+
+  @returns (matrices::Matrix6) Lower triangular matrix L such that L * L^T
+  equals this matrix
+  @throws exceptions::ArcException if the matrix is not positive definite
+  */
+  Matrix6 cholesky() const {
+    Matrix6 lower;
+    for (int j = 0; j < 6; j++) {
+      double diag = elements[j][j];
+      for (int k = 0; k < j; k++) {
+        diag -= lower.elements[j][k] * lower.elements[j][k];
+      }
+      if (diag <= 0.0) {
+        std::stringstream ss;
+        ss << "Matrix is not positive definite (pivot " << j << " is "
+           << diag << ")";
+        throw ArcException(ss.str());
+      }
+      lower.elements[j][j] = sqrt(diag);
+      for (int i = j + 1; i < 6; i++) {
+        double sum = elements[i][j];
+        for (int k = 0; k < j; k++) {
+          sum -= lower.elements[i][k] * lower.elements[j][k];
+        }
+        lower.elements[i][j] = sum / lower.elements[j][j];
+      }
+    }
+    return lower;
+  }
+};
+
+/*
+Matrix6 operator functions
+*/
+
+// I/O stream
+inline std::ostream& operator << (std::ostream &out, const Matrix6& m) {
+  out << "[Matrix6] {";
+  for (int i = 0; i < 6; i++) {
+    out << std::endl << " ";
+    for (int j = 0; j < 6; j++) {
+      out << " " << m.elements[i][j];
+    }
+  }
+  out << " }";
+  return out;
+}
+
+// Element-wise addition
+inline Matrix6 operator + (const Matrix6& m_1, const Matrix6& m_2) {
+  return m_1.add(m_2);
+}
+
+// Element-wise subtraction
+inline Matrix6 operator - (const Matrix6& m_1, const Matrix6& m_2) {
+  return m_1.add(m_2.scale(-1.0));
+}
+
+// Element-wise multiplication by scalar
+inline Matrix6 operator * (const Matrix6& m_1, double scalar) {
+  return m_1.scale(scalar);
+}
+
+// Element-wise division by scalar
+inline Matrix6 operator / (const Matrix6& m_1, double scalar) {
+  return m_1.scale(1.0 / scalar);
+}
+
+// Matrix product with another Matrix6
+inline Matrix6 operator * (const Matrix6& m_1, const Matrix6& m_2) {
+  return m_1.multiply(m_2);
+}
+
+// Matrix product with a Vector6
+inline Vector6 operator * (const Matrix6& m, const Vector6& v) {
+  return m.multiply(v);
+}
+
+#endif
\ No newline at end of file
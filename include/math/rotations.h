@@ -0,0 +1,187 @@
+#ifndef ROTATIONS_H
+#define ROTATIONS_H
+#include <matrices.h>
+#include <vectors.h>
+
+#include <iostream>
+
+/*
+Unit quaternion
+
+Compact representation of a rotation, using the same convention as the
+equivalent matrix: rotating v gives q * v * conjugate(q), and the product
+q_2 * q_1 applies q_1 first
+
+Ref: Shepperd, S. W. (1978). Quaternion from rotation matrix. Journal of
+Guidance and Control, 1(3), 223-224.
+*/
+class Quaternion {
+public:
+  // Scalar part
+  double w;
+  // Vector part
+  double x;
+  double y;
+  double z;
+
+  /*
+  Default constructor
+
+  Creates the identity rotation
+  */
+  Quaternion();
+
+  /*
+  Constructor using components
+
+  @param w Scalar part
+  @param x "X" component of the vector part
+  @param y "Y" component of the vector part
+  @param z "Z" component of the vector part
+  */
+  Quaternion(double w, double x, double y, double z);
+
+  /*
+  Constructor using a rotation matrix
+
+  @param m Proper orthogonal matrix
+  */
+  Quaternion(const Matrix3& m);
+
+  /*
+  Multiply by another Quaternion (this * q)
+
+  @param q Quaternion by which to multiply
+  @returns (rotations::Quaternion) Rotation applying q, then this
+  */
+  Quaternion multiply(const Quaternion& q) const;
+
+  /*
+  Calculate the conjugate
+
+  @returns (rotations::Quaternion) The inverse rotation
+  */
+  Quaternion conjugate() const;
+
+  /*
+  Scale to unit magnitude
+
+  @returns (rotations::Quaternion) Unit quaternion
+  */
+  Quaternion normalize() const;
+
+  /*
+  Rotate a Vector3
+
+  @param v Vector to rotate
+  @returns (vectors::Vector3) The rotated vector
+  */
+  Vector3 rotate(const Vector3& v) const;
+
+  /*
+  Convert to the equivalent rotation matrix
+
+  @returns (matrices::Matrix3) Rotation matrix
+  */
+  Matrix3 to_matrix() const;
+};
+
+/*
+Time-dependent rotation between two coordinate frames
+
+Holds the rotation matrix together with its time derivative, so that a chain
+of elementary rotations is composed once and then applied to any number of
+vectors. A position maps with one matrix product, and a velocity with one
+multiply-add (matrix * v + rate * r), which includes the transport term of a
+rotating frame.
+*/
+class Rotation {
+public:
+  // Matrix mapping vectors from the source to the destination frame
+  Matrix3 matrix;
+  // Time derivative of the matrix (per second)
+  Matrix3 rate;
+
+  /*
+  Default constructor
+
+  Creates the identity rotation with no rate
+  */
+  Rotation();
+
+  /*
+  Constructor using a matrix and its rate
+
+  @param matrix Matrix mapping vectors from the source to the destination frame
+  @param rate Time derivative of the matrix (per second)
+  */
+  Rotation(const Matrix3& matrix, const Matrix3& rate);
+
+  /*
+  Compose with a rotation applied after this one
+
+  @param next Rotation from this destination frame to another frame
+  @returns (rotations::Rotation) Rotation from this source frame to the
+  destination frame of next
+  */
+  Rotation then(const Rotation& next) const;
+
+  /*
+  Calculate the inverse rotation
+
+  @returns (rotations::Rotation) Rotation from the destination frame back to
+  the source frame
+  */
+  Rotation inverse() const;
+
+  /*
+  Rotate a position (or any fixed vector)
+
+  @param position Vector in the source frame
+  @returns (vectors::Vector3) Vector in the destination frame
+  */
+  Vector3 apply(const Vector3& position) const;
+
+  /*
+  Rotate a velocity, including the rate of the rotation
+
+  @param position Position in the source frame
+  @param velocity Velocity in the source frame
+  @returns (vectors::Vector3) Velocity in the destination frame
+  */
+  Vector3 apply_velocity(const Vector3& position,
+                         const Vector3& velocity) const;
+
+  /*
+  Convert the rotation matrix to a quaternion
+
+  @returns (rotations::Quaternion) Equivalent unit quaternion
+  */
+  Quaternion to_quaternion() const;
+};
+
+/*
+Elementary frame rotations
+
+Rotate the coordinate frame (not the vector) by an angle about an axis,
+matching Vector3::rot_x, rot_y, and rot_z
+
+@param theta Angle of rotation in radians
+@param theta_rate Rate of change of the angle in radians per second
+@returns (rotations::Rotation) The elementary rotation and its rate
+*/
+Rotation rotation_x(double theta, double theta_rate = 0.0);
+Rotation rotation_y(double theta, double theta_rate = 0.0);
+Rotation rotation_z(double theta, double theta_rate = 0.0);
+
+/*
+Rotation operator functions
+*/
+
+// I/O stream
+std::ostream& operator << (std::ostream &out, const Quaternion& q);
+
+// Quaternion product
+Quaternion operator * (const Quaternion& q_1, const Quaternion& q_2);
+
+#endif
\ No newline at end of file
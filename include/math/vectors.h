@@ -8,6 +8,9 @@
 Three-element vector
 
 Vector with X,Y,Z or I,J,K components. Typically represents a single construct in 3D space.
+
+Defined entirely in this header (constexpr where C++11 allows) so that the
+arithmetic inlines into integrators and force models
 */
 class Vector3 {
 public:
@@ -23,7 +26,7 @@ public:
 
   Sets all elements to zero
   */
-  Vector3();
+  constexpr Vector3() : x{ 0.0 }, y{ 0.0 }, z{ 0.0 } {}
 
   /*
   Constructor using doubles
@@ -32,14 +35,14 @@ public:
   @param y "Y" or "J" value
   @param z "Z" or "K" value
   */
-  Vector3(double x, double y, double z);
+  constexpr Vector3(double x, double y, double z) : x{ x }, y{ y }, z{ z } {}
 
   /*
   Calculate the magnitude
 
   @returns Magnitude of this vector
   */
-  double mag();
+  double mag() const { return sqrt(x * x + y * y + z * z); }
 
   /*
   Scale by a scalar value using element-wise multiplication
@@ -47,7 +50,9 @@ public:
   @param scalar Number by which to multiply each element
   @returns (vectors::Vector3) scaled vector
   */
-  Vector3 scale(double scalar);
+  constexpr Vector3 scale(double scalar) const {
+    return Vector3{ x * scalar, y * scalar, z * scalar };
+  }
 
   /*
   Scale by a vector using element-wise multiplication
@@ -55,14 +60,16 @@ public:
   @param v Vector to multiply element-wise
   @returns (vectors::Vector3) scaled vector
   */
-  Vector3 scale(Vector3& v);
+  constexpr Vector3 scale(const Vector3& v) const {
+    return Vector3{ x * v.x, y * v.y, z * v.z };
+  }
 
   /*
   Calculate the unit vector
 
   @returns (vectors::Vector3) unit vector
   */
-  Vector3 unit();
+  Vector3 unit() const { return scale(1.0 / mag()); }
 
   /*
   Add another Vector3 using element-wise addition
@@ -70,14 +77,16 @@ public:
   @param v Vector to add element-wise
   @returns (vectors::Vector3) Vector representing the element-wise sum
   */
-  Vector3 add(Vector3& v);
+  constexpr Vector3 add(const Vector3& v) const {
+    return Vector3{ x + v.x, y + v.y, z + v.z };
+  }
 
   /*
   Calculate a new Vector3 representing the inverse (negated elements)
 
   @returns (vectors::Vector3) The same vector, scaled by -1
   */
-  Vector3 inverse();
+  constexpr Vector3 inverse() const { return Vector3{ -x, -y, -z }; }
 
   /*
   Distance to another Vector3, assuming that
@@ -86,7 +95,12 @@ public:
   @param v The vector from which to calculate distance
   @returns (double) distance between this and the vector v
   */
-  double distance(Vector3& v);
+  double distance(const Vector3& v) const {
+    double dx = x - v.x;
+    double dy = y - v.y;
+    double dz = z - v.z;
+    return sqrt(dx * dx + dy * dy + dz * dz);
+  }
 
   /*
   Dot product with another Vector3
@@ -94,7 +108,9 @@ public:
   @param v The vector to use for dot product calculation
   @returns (double) Dot product of this and the vector v
   */
-  double dot(Vector3& v);
+  constexpr double dot(const Vector3& v) const {
+    return x * v.x + y * v.y + z * v.z;
+  }
 
   /*
   Cross product with another Vector3
@@ -102,7 +118,9 @@ public:
   @param v The vector to use for cross product calculation
   @returns (vector::Vector3) Cross product of this and the vector v
   */
-  Vector3 cross(Vector3& v);
+  constexpr Vector3 cross(const Vector3& v) const {
+    return Vector3{ y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x };
+  }
 
   /*
   Rotate along the x-axis
@@ -110,7 +128,11 @@ public:
   @param theta The angle of rotation
   @returns (vector::Vector3) the rotated vector
   */
-  Vector3 rot_x(double theta);
+  Vector3 rot_x(double theta) const {
+    double cos_t = cos(theta);
+    double sin_t = sin(theta);
+    return Vector3{ x, cos_t * y + sin_t * z, -sin_t * y + cos_t * z };
+  }
 
   /*
   Rotate along the y-axis
@@ -118,7 +140,11 @@ public:
   @param theta The angle of rotation
   @returns (vector::Vector3) the rotated vector
   */
-  Vector3 rot_y(double theta);
+  Vector3 rot_y(double theta) const {
+    double cos_t = cos(theta);
+    double sin_t = sin(theta);
+    return Vector3{ cos_t * x - sin_t * z, y, sin_t * x + cos_t * z };
+  }
 
   /*
   Rotate along the z-axis
@@ -126,7 +152,11 @@ public:
   @param theta The angle of rotation
   @returns (vector::Vector3) the rotated vector
   */
-  Vector3 rot_z(double theta);
+  Vector3 rot_z(double theta) const {
+    double cos_t = cos(theta);
+    double sin_t = sin(theta);
+    return Vector3{ cos_t * x + sin_t * y, -sin_t * x + cos_t * y, z };
+  }
 
   /*
   Calculate angle to another Vector3
@@ -134,50 +164,72 @@ public:
   @param v The vector to which to calculate the angle
   @returns (double) The angle between this and the vector v
   */
-  double angle(Vector3& v);
+  double angle(const Vector3& v) const {
+    return acos(dot(v) / (mag() * v.mag()));
+  }
 
   /*
-  Change coordinates to relative position from a 
+  Change coordinates to relative position from a
   new origin, assuming both vectors have the same starting origin
 
   @param origin Vector to use as the new origin
   @returns (vectors::Vector3) This vector centered around the new origin vector
   */
-  Vector3 change_origin(Vector3& origin);
+  constexpr Vector3 change_origin(const Vector3& origin) const {
+    return add(origin.inverse());
+  }
 };
 
 /*
 Vector3 operator functions
 */
 
-// I/O stream 
-std::ostream& operator << (std::ostream &out, Vector3& v);
+// I/O stream
+inline std::ostream& operator << (std::ostream &out, const Vector3& v) {
+  out << "[Vector3] { X: " << v.x << ", Y: " << v.y << ", Z: " << v.z << " }";
+  return out;
+}
 
 // Element-wise addition
-Vector3 operator + (Vector3& v_1, Vector3& v_2);
+constexpr Vector3 operator + (const Vector3& v_1, const Vector3& v_2) {
+  return v_1.add(v_2);
+}
 
 // Element-wise subtraction
-Vector3 operator - (Vector3& v_1, Vector3& v_2);
+constexpr Vector3 operator - (const Vector3& v_1, const Vector3& v_2) {
+  return Vector3{ v_1.x - v_2.x, v_1.y - v_2.y, v_1.z - v_2.z };
+}
 
 // Element-wise multiplication by scalar
-Vector3 operator * (Vector3& v_1, double scalar);
+constexpr Vector3 operator * (const Vector3& v_1, double scalar) {
+  return v_1.scale(scalar);
+}
 
 // Element-wise division by scalar
-Vector3 operator / (Vector3& v_1, double scalar);
+constexpr Vector3 operator / (const Vector3& v_1, double scalar) {
+  return v_1.scale(1.0 / scalar);
+}
 
 // Dot product with another Vector3
-double operator * (Vector3& v_1, Vector3& v_2);
+constexpr double operator * (const Vector3& v_1, const Vector3& v_2) {
+  return v_1.dot(v_2);
+}
 
 // Cross product with another Vector3
-Vector3 operator % (Vector3& v_1, Vector3& v_2);
+constexpr Vector3 operator % (const Vector3& v_1, const Vector3& v_2) {
+  return v_1.cross(v_2);
+}
 
 
 /*
 Six-element vector
 
 Typically represents the combination of two constructs in 3D space.
+
+Aligned to 16 bytes (without changing its size) so that element-wise
+arithmetic on pairs of components can use packed SIMD loads
 */
-class Vector6 {
+class alignas(16) Vector6 {
 public:
   // "A" or "I_1" component
   double a;
@@ -197,7 +249,8 @@ public:
 
   Sets all elements to zero
   */
-  Vector6();
+  constexpr Vector6() : a{ 0.0 }, b{ 0.0 }, c{ 0.0 }, x{ 0.0 }, y{ 0.0 },
+                        z{ 0.0 } {}
 
   /*
   Constructor using doubles
@@ -209,7 +262,9 @@ public:
   @param y "Y" or "Y2" value
   @param z "Z" or "Z2" value
   */
-  Vector6(double a, double b, double c, double x, double y, double z);
+  constexpr Vector6(double a, double b, double c, double x, double y,
+                    double z)
+    : a{ a }, b{ b }, c{ c }, x{ x }, y{ y }, z{ z } {}
 
   /*
   Constructor using two Vector3 instances as {a.x, a.y, a.z, b.x, b.y, b.z}
@@ -218,7 +273,8 @@ public:
   @param b Second vector
   @returns (vectors::Vector6) combined a/b vector
   */
-  Vector6(Vector3& a, Vector3& b);
+  constexpr Vector6(const Vector3& a, const Vector3& b)
+    : a{ a.x }, b{ a.y }, c{ a.z }, x{ b.x }, y{ b.y }, z{ b.z } {}
 
   /*
   Add another Vector6 using element-wise addition
@@ -226,7 +282,9 @@ public:
   @param v Vector to add element-wise
   @returns (vectors::Vector6) Vector representing the element-wise sum
   */
-  Vector6 add(Vector6& v);
+  constexpr Vector6 add(const Vector6& v) const {
+    return Vector6{ a + v.a, b + v.b, c + v.c, x + v.x, y + v.y, z + v.z };
+  }
 
   /*
   Scale by a scalar value using element-wise multiplication
@@ -234,33 +292,51 @@ public:
   @param scalar Number by which to multiply each element
   @returns (vectors::Vector6) scaled vector
   */
-  Vector6 scale(double scalar);
+  constexpr Vector6 scale(double scalar) const {
+    return Vector6{ a * scalar, b * scalar, c * scalar,
+                    x * scalar, y * scalar, z * scalar };
+  }
 
   /*
   Split the elements into two Vector3 instances
 
   @returns (std::array<Vector3, 2>) Array of this vector split by first/last 3 elements
   */
-  std::array<Vector3, 2> split();
+  constexpr std::array<Vector3, 2> split() const {
+    return std::array<Vector3, 2>{ { Vector3{ a, b, c }, Vector3{ x, y, z } } };
+  }
 };
 
 /*
 Vector6 operator functions
 */
 
-// I/O stream 
-std::ostream& operator << (std::ostream &out, Vector6& v);
+// I/O stream
+inline std::ostream& operator << (std::ostream &out, const Vector6& v) {
+  out << "[Vector6] { A: " << v.a << ", B: " << v.b << ", C: " << v.c
+    << ", X: " << v.x << ", Y: " << v.y << ", Z: " << v.z << " }";
+  return out;
+}
 
 // Element-wise addition
-Vector6 operator + (Vector6& v_1, Vector6& v_2);
+constexpr Vector6 operator + (const Vector6& v_1, const Vector6& v_2) {
+  return v_1.add(v_2);
+}
 
 // Element-wise subtraction
-Vector6 operator - (Vector6& v_1, Vector6& v_2);
+constexpr Vector6 operator - (const Vector6& v_1, const Vector6& v_2) {
+  return Vector6{ v_1.a - v_2.a, v_1.b - v_2.b, v_1.c - v_2.c,
+                  v_1.x - v_2.x, v_1.y - v_2.y, v_1.z - v_2.z };
+}
 
 // Element-wise multiplication by scalar
-Vector6 operator * (Vector6& v_1, double scalar);
+constexpr Vector6 operator * (const Vector6& v_1, double scalar) {
+  return v_1.scale(scalar);
+}
 
 // Element-wise division by scalar
-Vector6 operator / (Vector6& v_1, double scalar);
+constexpr Vector6 operator / (const Vector6& v_1, double scalar) {
+  return v_1.scale(1.0 / scalar);
+}
 
 #endif
\ No newline at end of file
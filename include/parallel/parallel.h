@@ -0,0 +1,31 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <cstddef>
+#include <functional>
+
+/*
+Determine the number of worker threads to use
+
+@param requested Requested number of threads (0 uses the hardware concurrency)
+@param count Number of work items, no more threads than items are used
+@returns (unsigned) Number of worker threads, at least one
+*/
+unsigned worker_count(unsigned requested, size_t count);
+
+/*
+Run a function over the index range [0, count) split into contiguous chunks,
+one chunk per worker thread
+
+Each chunk is processed by a single call, so workers can set up their own state
+(propagators, accumulators) once per chunk. Any exception thrown by a worker is
+rethrown on the calling thread after all workers have finished.
+
+@param count Number of work items
+@param threads Requested number of worker threads (0 uses the hardware
+concurrency)
+@param fn Function called with the [begin, end) index range of each chunk
+*/
+void parallel_for(size_t count, unsigned threads,
+                  std::function<void(size_t, size_t)> fn);
+
+#endif
\ No newline at end of file
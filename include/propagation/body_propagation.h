@@ -4,6 +4,8 @@
 #include <icrf.h>
 #include <datetime.h>
 
+#include <mutex>
+
 /*
 Celestial body propagation handler
 
@@ -28,10 +30,28 @@ class BodyPropagationHandler {
   Ephemeris uranus;
   // Neptune states
   Ephemeris neptune;
+  // Load flags, one per ephemeris, so that concurrent propagations read each
+  // file exactly once
+  std::once_flag mercury_loaded, venus_loaded, earth_loaded, luna_loaded,
+      mars_loaded, jupiter_loaded, saturn_loaded, uranus_loaded, neptune_loaded;
+
+  /*
+  Load an ephemeris file exactly once, even when called from several threads
+
+  @param ephem Ephemeris member to populate
+  @param loaded Load flag associated with the ephemeris
+  @param filepath Ephemeris location in the filesystem
+  @returns ephemeris::Ephemeris reference to the loaded ephemeris
+  @throws exceptions::ArcException if ephemeris file is not found
+  */
+  Ephemeris& load_once(Ephemeris& ephem, std::once_flag& loaded,
+                       const char filepath[]);
 
   /*
   Returns a planetary ephemeris file, loading it from disk if necessary
 
+  Safe to call from multiple threads
+
   @param id NAIF id of the requested celestial body
   @returns ephemeris::Ephemeris instance of the requested celestial body
   @throws exceptions::ArcException if ephemeris file is not found
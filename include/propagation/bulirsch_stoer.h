@@ -0,0 +1,89 @@
+#ifndef BULIRSCH_STOER_H
+#define BULIRSCH_STOER_H
+#include <datetime.h>
+#include <force_model.h>
+#include <icrf.h>
+#include <propagator.h>
+#include <vectors.h>
+
+#include <cfloat>
+
+// Number of columns in the extrapolation tableau (midpoint substeps 2, 4, ...,
+// 2 * BS_MAX_COLUMNS)
+const int BS_MAX_COLUMNS = 10;
+
+// Smallest tolerance, below which rounding error stops the extrapolation
+// from converging
+const double BS_MIN_TOLERANCE = 100.0 * DBL_EPSILON;
+
+/*
+Gragg-Bulirsch-Stoer extrapolation integrator
+
+Each step is integrated with Gragg's modified midpoint rule using an
+increasing number of substeps, and the results are extrapolated to zero
+substep size. The number of extrapolation columns (order) and the step size
+are adapted to minimize force evaluations per unit time while meeting the
+tolerance, so smooth problems are integrated with large steps at tight
+tolerances. The step size acts as the first trial step and an upper bound on
+the adaptive step.
+
+Ref: Hairer, E., Norsett, S. P., & Wanner, G. (1993). Extrapolation Methods.
+In Solving ordinary differential equations I (2nd ed., pp. 224-241). Berlin:
+Springer-Verlag.
+*/
+class BulirschStoerPropagator : public NumericalPropagator {
+  // Magnitude of the next trial step in seconds
+  double trial_step;
+  // Tableau column at which the next step is expected to converge
+  int target_column;
+
+  /*
+  Integrate the offset from a state over a step with the modified midpoint
+  rule
+
+  @param state State at the start of the step
+  @param step Seconds to step (signed)
+  @param substeps Number of midpoint substeps (even)
+  @param f_0 Derivative at the start of the step
+  @returns (vectors::Vector6) Position/velocity offset at the end of the step
+  */
+  Vector6 midpoint(ICRF &state, double step, int substeps, Vector6 &f_0);
+
+  /*
+  Take one adaptive extrapolation step, retrying with smaller steps until the
+  tolerance is met
+
+  @param state State at the start of the step
+  @param limit Seconds remaining to the end of the integration (signed)
+  @param taken Seconds actually stepped (signed)
+  @returns (icrf::ICRF) State at the end of the step
+  */
+  ICRF extrapolation_step(ICRF &state, double limit, double &taken);
+
+public:
+  // Relative error allowed per step
+  double tolerance;
+  // Number of rejected steps
+  int rejections;
+
+  // Direct constructor (default settings)
+  BulirschStoerPropagator(ICRF initial_state);
+
+  // Direct constructor (full settings)
+  BulirschStoerPropagator(ICRF initial_state, double step_size,
+                          ForceModel force_model);
+
+  /*
+  Change the tolerance and select the matching initial order
+
+  @param tolerance Relative error allowed per step (raised to
+  BS_MIN_TOLERANCE if smaller)
+  @throws exceptions::ArcException if the tolerance is not positive
+  */
+  void set_tolerance(double tolerance);
+
+  // Step the integration a number of seconds forward/backward
+  ICRF integrate(ICRF &state, double step);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef ENCKE_H
+#define ENCKE_H
+#include <datetime.h>
+#include <force_model.h>
+#include <icrf.h>
+#include <propagator.h>
+#include <vectors.h>
+
+/*
+Encke-method propagator
+
+Integrates only the deviation of the trajectory from a reference two-body
+orbit (fourth-order Runge-Kutta), so the step size is driven by the
+perturbations rather than the central-body term. The reference orbit is
+propagated analytically with universal variables and is rectified to the
+current state whenever the deviation grows past a tolerance.
+
+The force model must include the central body's gravity, whose point-mass
+term is replaced by the reference orbit.
+
+Ref: Battin, R. H. (1999). Encke's Method. In An introduction to the
+mathematics and methods of astrodynamics (pp. 447-450). Reston, VA: AIAA.
+*/
+class EnckePropagator : public NumericalPropagator {
+  // Osculating reference orbit state (at its own epoch)
+  ICRF reference_state;
+  // Position/velocity deviation from the reference orbit at the cached state
+  Vector6 deviation;
+
+  /*
+  Calculate the derivative of the deviation from a reference orbit
+
+  @param reference Reference orbit state at its osculation epoch
+  @param tau Seconds from the reference epoch at which to evaluate
+  @param delta Position/velocity deviation at tau
+  @returns (vectors::Vector6) Derivative of the deviation
+  */
+  Vector6 deviation_derivatives(ICRF &reference, double tau, Vector6 &delta);
+
+  /*
+  Step the deviation from a reference orbit a number of seconds
+  forward/backward
+
+  @param reference Reference orbit state at its osculation epoch
+  @param tau Seconds from the reference epoch at the start of the step
+  @param delta Position/velocity deviation at tau (updated in place)
+  @param step Seconds to step
+  @returns (icrf::ICRF) Full state at the end of the step
+  */
+  ICRF step_deviation(ICRF &reference, double tau, Vector6 &delta,
+                      double step);
+
+public:
+  // Ratio of the position deviation to the reference orbit radius above
+  // which the reference orbit is rectified
+  double rectify_tolerance;
+  // Number of rectifications performed
+  int rectifications;
+
+  // Direct constructor (default settings)
+  EnckePropagator(ICRF initial_state);
+
+  // Direct constructor (full settings)
+  EnckePropagator(ICRF initial_state, double step_size, ForceModel force_model);
+
+  // Propagate the inital state to specified epoch
+  ICRF propagate(DateTime &epoch);
+
+  // Step the integration a number of seconds forward/backward (the reference
+  // orbit osculates the given state)
+  ICRF integrate(ICRF &state, double step);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,159 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+#include <datetime.h>
+#include <drag.h>
+#include <force_model.h>
+#include <icrf.h>
+#include <matrices.h>
+#include <vectors.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/*
+Running statistics of propagated states at a single epoch
+
+Samples are accumulated one at a time (Welford) so trials never need to be
+stored, and partial results from separate workers can be combined (Chan et al.)
+
+Ref: Chan, T. F., Golub, G. H., & LeVeque, R. J. (1979). Updating formulae and
+a pairwise algorithm for computing sample variances. Stanford University.
+*/
+class StateStatistics {
+public:
+  // Epoch of the accumulated states
+  DateTime epoch;
+  // Number of accumulated states
+  size_t count;
+  // Mean position/velocity
+  double mean[6];
+  // Sum of the products of deviations from the mean
+  Matrix6 comoment;
+
+  // Default constructor
+  StateStatistics();
+
+  /*
+  Add a state to the statistics
+
+  @param state ICRF state to accumulate
+  */
+  void add(ICRF &state);
+
+  /*
+  Combine with statistics accumulated from a separate set of states
+
+  @param other Statistics to combine into these
+  */
+  void merge(StateStatistics &other);
+
+  /*
+  Calculate the sample covariance of the accumulated states
+
+  @returns (matrices::Matrix6) Sample covariance (zero with fewer than two
+  states)
+  */
+  Matrix6 covariance();
+};
+
+/*
+One-sigma (Gaussian) dispersions applied to each Monte Carlo trial
+*/
+struct Dispersion {
+  // Initial position dispersion in ICRF axes (m)
+  Vector3 position;
+  // Initial velocity dispersion in ICRF axes (m/s)
+  Vector3 velocity;
+  // Drag coefficient dispersion
+  double drag_coeff;
+  // Drag area dispersion (m^2)
+  double area;
+};
+
+/*
+Monte Carlo dispersion propagator
+
+Propagates a number of trials with dispersed initial states and drag
+parameters and reduces them to per-epoch statistics. Each trial draws from its
+own random stream seeded by (seed, trial number), and trials are grouped into a
+fixed number of blocks whose statistics are merged in order, so the results are
+identical regardless of the number of worker threads.
+*/
+class MonteCarloPropagator {
+public:
+  // Nominal initial state
+  ICRF initial_state;
+  // Number of seconds between integration steps
+  double step_size;
+  // Nominal force model
+  ForceModel force_model;
+  // Nominal drag model, dispersed in each trial
+  DragModel drag_model;
+  // Flag to determine if drag parameters should be dispersed
+  bool has_drag;
+  // Dispersions applied to each trial
+  Dispersion dispersion;
+  // Number of trials
+  size_t trials;
+  // Seed of the random streams
+  std::uint64_t seed;
+  // Number of worker threads (0 uses the hardware concurrency)
+  unsigned threads;
+
+  /*
+  Direct constructor
+
+  @param initial_state Nominal initial state
+  @param step_size Number of seconds between integration steps
+  @param force_model Nominal force model
+  @param dispersion Dispersions applied to each trial
+  @param trials Number of trials
+  @param seed Seed of the random streams
+  */
+  MonteCarloPropagator(ICRF initial_state, double step_size,
+                       ForceModel force_model, Dispersion dispersion,
+                       size_t trials, std::uint64_t seed);
+
+  /*
+  Change the nominal drag model, enabling dispersion of its parameters
+
+  @param model Drag model to use (also set on the nominal force model)
+  */
+  void set_drag_model(DragModel model);
+
+  /*
+  Draw the initial state and force model of a trial
+
+  @param trial Trial number (determines the random stream)
+  @param state State into which the dispersed initial state is written
+  @param fm Force model into which the dispersed force model is written
+  */
+  void sample(size_t trial, ICRF &state, ForceModel &fm);
+
+  /*
+  Propagate all trials over an interval and reduce them to statistics
+
+  @param start Time of the first output point
+  @param stop Time after which no more points are output
+  @param step Number of seconds between output points
+  @returns (std::vector<monte_carlo::StateStatistics>) Statistics of the trials
+  at each output epoch
+  */
+  std::vector<StateStatistics> step(DateTime &start, DateTime &stop, double step);
+};
+
+/*
+Write Monte Carlo statistics to a text summary
+
+Each line holds the ISO epoch, the mean position/velocity, and the standard
+deviation of each position/velocity component
+
+@param statistics Statistics at each output epoch
+@param filename File system location at which to write the summary
+@throws exceptions::ArcException if the file cannot be written
+*/
+void write_statistics(std::vector<StateStatistics> &statistics,
+                      const char filename[]);
+
+#endif
\ No newline at end of file
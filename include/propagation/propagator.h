@@ -3,6 +3,7 @@
 #include <icrf.h>
 #include <datetime.h>
 #include <force_model.h>
+#include <matrices.h>
 
 #include <vector>
 
@@ -30,6 +31,10 @@ public:
   ICRF cache_state;
   // Force model
   ForceModel force_model;
+  // State used for the initial condition of the next variational integration step
+  ICRF stm_cache_state;
+  // State transition matrix from the initial state to stm_cache_state
+  Matrix6 stm_cache;
 
   // Direct constructor (default settings)
   NumericalPropagator(ICRF initial_state);
@@ -40,11 +45,62 @@ public:
   // Propagate the inital state to specified epoch
   ICRF propagate(DateTime &epoch);
 
+  /*
+  Propagate the initial state and its state transition matrix to specified epoch
+
+  Integrates the variational equations alongside the state, so one propagation
+  provides the sensitivity of the final state to the initial state
+
+  @param epoch Requested time to which to propagate
+  @param stm Matrix into which the state transition matrix from the initial
+  state to the requested epoch is written
+  @returns Propagated state at the requested epoch
+  */
+  ICRF propagate_with_stm(DateTime &epoch, Matrix6 &stm);
+
+  /*
+  Propagate a batch of states to specified epoch
+
+  The states are stepped in lockstep (every state takes an integration step
+  before any state takes the next), so time-dependent force model lookups such
+  as third-body positions are evaluated once per step and shared by the batch.
+  The initial and cached states of the propagator are not used.
+
+  @param states States to propagate, all at the same epoch (updated in place)
+  @param epoch Requested time to which to propagate
+  */
+  void propagate_batch(std::vector<ICRF> &states, DateTime &epoch);
+
   // Calculate partial derivatives for numerical integration
   Vector6 derivatives(ICRF &state, double h, Vector6 &k);
 
+  /*
+  Calculate the derivative of the state transition matrix (variational
+  equations) for numerical integration
+
+  @param state State at the start of the integration step
+  @param h Time offset from the state epoch at which to evaluate
+  @param k Offset to add to the state position/velocity
+  @param stm State transition matrix at the evaluation point
+  @returns Derivative of the state transition matrix
+  */
+  Matrix6 variational(ICRF &state, double h, Vector6 &k, Matrix6 &stm);
+
   // Step the integration a number of seconds forward/backward
-  virtual ICRF integrate(ICRF &state, double step);
+  virtual ICRF integrate(ICRF &state, double step) = 0;
+
+  /*
+  Step the integration of the state and its state transition matrix a number
+  of seconds forward/backward
+
+  @param state State at the start of the step
+  @param stm State transition matrix at the start of the step (updated)
+  @param step Seconds to step
+  @returns State at the end of the step
+  @throws exceptions::ArcException if the integrator does not support the
+  state transition matrix
+  */
+  virtual ICRF integrate_with_stm(ICRF &state, Matrix6 &stm, double step);
 
 };
 
@@ -1,11 +1,57 @@
 #ifndef RUN_CONFIG_H
 #define RUN_CONFIG_H
+#include <json.h>
+
+#include <string>
+#include <vector>
+
+// Output product filename that streams the product instead of writing a file
+const char STREAM_FILENAME[] = "-";
+
+// Earth orientation parameters loaded when FINALS_FILE is not set
+const char DEFAULT_FINALS_FILE[] = "data/finals_all.txt";
+
+// IERS Conventions (2010) Tables 5.2a, 5.2b, and 5.2d loaded for the IAU
+// 2006/2000A model when SERIES_FILES X, Y, or S is not set
+const char DEFAULT_X_SERIES_FILE[] = "data/tab5.2a.txt";
+const char DEFAULT_Y_SERIES_FILE[] = "data/tab5.2b.txt";
+const char DEFAULT_S_SERIES_FILE[] = "data/tab5.2d.txt";
+
+/*
+Apply the reference data settings of a run configuration
+
+Loads the leap seconds file (LEAP_SECONDS_FILE) and the Earth orientation
+parameters (FINALS_FILE, by default DEFAULT_FINALS_FILE if it exists), and
+sets the Earth orientation model (EARTH_ORIENTATION). All are shared by the
+whole process.
+
+@param input INPUT section of a run configuration
+@throws exceptions::ArcException if the reference data cannot be loaded
+*/
+void apply_reference_data(nlohmann::json &input);
+
+/*
+Execute a run task using a parsed run configuration
+
+Ephemeris, covariance, and ground track products whose FILENAME is "-" are
+appended to the stream instead of being written to a file
+
+@param json Parsed run configuration
+@param stream Lines of the streamed output products
+@param reference_data Whether to apply the reference data settings of the
+run configuration
+@throws exceptions::ArcException if the run fails
+*/
+void run_config(nlohmann::json &json, std::vector<std::string> &stream,
+                bool reference_data = true);
 
 /*
 Execute a run task using a run configuration file
 
+Streamed output products are printed to stdout
+
 @param filepath Path to the run config file to parse
 */
 void run_config_file(const char filepath[]);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,129 @@
+#ifndef RUN_SERVER_H
+#define RUN_SERVER_H
+#include <json.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/*
+Persistent run configuration server
+
+Runs configurations sent over a local (Unix domain) socket inside one
+long-running process, so planetary ephemerides, leap seconds, and Earth
+orientation series are loaded once and stay resident between runs.
+
+Each line a client sends is one JSON run configuration. For every request the
+server replies with the lines of the streamed output products (those whose
+FILENAME is "-"), then a status line: "ARC_STATUS OK" or
+"ARC_STATUS ERROR <message>". Relative paths in a request are resolved from
+the working directory of the server. A request longer than 1 MiB is answered
+with an error status and ends its connection. Connections are queued and
+served by a fixed pool of worker threads, each handling the requests of one
+connection in order.
+
+Reference data is shared by the whole process, so it is fixed when the server
+starts. A request may repeat the LEAP_SECONDS_FILE, FINALS_FILE, and
+EARTH_ORIENTATION settings of the server (they are not reloaded) but not
+change them.
+*/
+class RunServer {
+public:
+  // Socket location in the filesystem
+  std::string socket_path;
+  // Number of worker threads (0 uses the hardware concurrency)
+  unsigned threads;
+
+  /*
+  Direct constructor
+
+  @param socket_path Socket location in the filesystem
+  @param threads Number of worker threads (0 uses the hardware concurrency)
+  */
+  RunServer(const char socket_path[], unsigned threads = 0);
+
+  /*
+  Load the resident reference data from a run configuration file
+
+  Applies the LEAP_SECONDS_FILE, FINALS_FILE, and EARTH_ORIENTATION settings
+  of its INPUT section, and the THREADS setting of its SERVER section.
+  Without a configuration, serve applies the default reference data.
+
+  @param filepath Path to the run configuration file
+  @throws exceptions::ArcException if the file or reference data cannot be
+  loaded
+  */
+  void configure(const char filepath[]);
+
+  /*
+  Run a single request
+
+  @param request JSON run configuration
+  @returns (std::vector<std::string>) Streamed product lines followed by the
+  status line
+  */
+  std::vector<std::string> handle(const std::string &request);
+
+  /*
+  Accept and serve connections until a client requests a shutdown
+
+  @throws exceptions::ArcException if the socket cannot be created
+  */
+  void serve();
+
+  /*
+  Stop accepting connections and end open connections after their current
+  request
+
+  Safe to call from any thread
+  */
+  void stop();
+
+private:
+  // Reference data settings the server was started with
+  nlohmann::json reference;
+  // Whether the reference data has been loaded
+  bool configured;
+  // Listening socket
+  int listen_fd;
+  // Whether the server is accepting connections
+  std::atomic<bool> running;
+  // Accepted connections waiting for a worker
+  std::deque<int> pending;
+  // Connections being served
+  std::set<int> active;
+  // Guards pending and active
+  std::mutex queue_mutex;
+  // Signals workers that a connection is pending or the server stopped
+  std::condition_variable queue_ready;
+
+  // Serve queued connections until the server stops
+  void work();
+
+  // Serve the requests of one connection
+  void serve_connection(int fd);
+};
+
+/*
+Send a run configuration file to a server and print the streamed products
+
+@param socket_path Socket location in the filesystem
+@param filepath Path to the run configuration file
+@returns (bool) True if the run succeeded
+@throws exceptions::ArcException if the server cannot be reached
+*/
+bool send_run_config(const char socket_path[], const char filepath[]);
+
+/*
+Ask a server to shut down
+
+@param socket_path Socket location in the filesystem
+@throws exceptions::ArcException if the server cannot be reached
+*/
+void stop_run_server(const char socket_path[]);
+
+#endif
@@ -1,3 +1,5 @@
+#ifndef RUNGEKUTTA4_H
+#define RUNGEKUTTA4_H
 #include <propagator.h>
 
 // Fourth-order Runge-Kutta
@@ -11,4 +13,10 @@ public:
 
     // Step the integration a number of seconds forward/backward
     ICRF integrate(ICRF &state, double step);
-};
\ No newline at end of file
+
+    // Step the integration of the state and its state transition matrix a
+    // number of seconds forward/backward (stm is updated in place)
+    ICRF integrate_with_stm(ICRF &state, Matrix6 &stm, double step);
+};
+
+#endif
\ No newline at end of file
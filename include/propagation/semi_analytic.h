@@ -0,0 +1,258 @@
+#ifndef SEMI_ANALYTIC_H
+#define SEMI_ANALYTIC_H
+#include <celestial.h>
+#include <datetime.h>
+#include <drag.h>
+#include <ephemeris.h>
+#include <icrf.h>
+#include <propagator.h>
+#include <vectors.h>
+
+#include <array>
+#include <vector>
+
+// Earth J3 zonal harmonic (EGM-2008, unnormalized)
+const double EARTH_J3 = -2.53241051856772e-06;
+
+// Earth J4 zonal harmonic (EGM-2008, unnormalized)
+const double EARTH_J4 = -1.61989759991697e-06;
+
+// Perigee altitude in meters below which a mean orbit is considered decayed
+const double DECAY_ALTITUDE = 120000.0;
+
+// Shortest mean element step in seconds taken as an orbit approaches decay
+const double MIN_DECAY_STEP = 600.0;
+
+/*
+Nonsingular mean orbital elements
+
+Elements are ordered as semi-major axis (m), eccentricity vector components
+(e cos(w), e sin(w)), inclination (rad), right ascension of the ascending node
+(rad), and mean argument of latitude (M + w, rad), which stay defined for
+circular orbits
+*/
+typedef std::array<double, 6> MeanElements;
+
+/*
+Mean elements and their rates at an integration node
+*/
+struct MeanElementNode {
+  // Seconds from the initial state epoch
+  double t;
+  // Mean elements at the node
+  MeanElements elements;
+  // Averaged rates of the mean elements at the node
+  MeanElements rates;
+};
+
+/*
+Semi-analytic mean-element propagator
+
+Integrates the orbit-averaged equations of motion of the mean elements with
+large (day-scale) steps. Averaged rates are the mean of the Gauss variational
+equations over equally spaced points in mean anomaly, which gives the secular
+and long-period effects of the J2-J4 zonal harmonics and of atmospheric drag
+without any expansion in eccentricity. Short-period terms are reconstructed
+from the same samples when osculating states are requested.
+
+Equatorial orbits (zero inclination) and unbound orbits are not supported.
+
+Ref: Danielson, D. A., Sagovac, C. P., Neta, B., & Early, L. W. (1995).
+Semianalytic Satellite Theory. Monterey, CA: Naval Postgraduate School.
+*/
+class SemiAnalyticPropagator : public Propagator {
+  // Central body J2 zonal harmonic
+  double j2;
+  // Central body J3 zonal harmonic
+  double j3;
+  // Central body J4 zonal harmonic
+  double j4;
+  // Mean elements of the initial state
+  MeanElements initial_mean;
+  // Integration nodes forward (and backward) in time from the initial state
+  std::vector<MeanElementNode> forward_nodes;
+  std::vector<MeanElementNode> backward_nodes;
+  // Seconds from the initial state epoch at which the orbit decays forward
+  // (and backward) in time, zero if no decay has been found
+  double forward_decay;
+  double backward_decay;
+
+  // Calculate the perturbing acceleration (zonal gravity and drag) at a state
+  Vector3 perturbation(ICRF &state);
+
+  /*
+  Calculate the osculating element rates at a point on an orbit
+
+  @param elements Osculating elements of the point
+  @param epoch Epoch of the elements
+  @returns (MeanElements) Rate of each element
+  */
+  MeanElements element_rates(MeanElements &elements, DateTime &epoch);
+
+  /*
+  Calculate the harmonic coefficients of rates sampled at equally spaced mean
+  arguments of latitude
+
+  @param samples Rates at each sample point
+  @param c Cosine coefficient of each harmonic (index 0 unused)
+  @param s Sine coefficient of each harmonic (index 0 unused)
+  */
+  void harmonics(std::vector<MeanElements> &samples,
+                 std::vector<MeanElements> &c, std::vector<MeanElements> &s);
+
+  /*
+  Integrate the harmonics of the element rates over the mean argument of
+  latitude
+
+  @param c Cosine coefficient of each harmonic
+  @param s Sine coefficient of each harmonic
+  @param a Mean semi-major axis
+  @param lambda Mean argument of latitude at which to evaluate
+  @param mean_motion Flag to add the effect of the semi-major axis variation
+  on the mean motion (needed when the rates were sampled on the mean orbit)
+  @returns (MeanElements) Short-period variation of each element
+  */
+  MeanElements variation(std::vector<MeanElements> &c,
+                         std::vector<MeanElements> &s, double a,
+                         double lambda, bool mean_motion);
+
+  /*
+  Sample the osculating element rates at equally spaced mean arguments of
+  latitude around the orbit of a set of mean elements
+
+  Each sample is taken at the osculating elements of its point (mean elements
+  plus first-order short-period variations), so averages of the samples carry
+  the second-order coupling between short-period terms
+
+  @param mean Mean elements to sample
+  @param epoch Epoch of the mean elements
+  @param samples Rates at each sample point
+  */
+  void sample_rates(MeanElements &mean, DateTime &epoch,
+                    std::vector<MeanElements> &samples);
+
+  /*
+  Extend the integration nodes to cover an offset from the initial epoch
+
+  @param dt Seconds from the initial state epoch
+  @returns (bool) False if the orbit decays before the nodes cover the offset
+  */
+  bool extend_to(double dt);
+
+public:
+  // Initial osculating state
+  ICRF initial_state;
+  // Number of seconds between mean element integration steps
+  double step_size;
+  // Highest zonal harmonic to include (0 for two-body, or 2 to 4)
+  int zonal_degree;
+  // Number of samples around the orbit used to average the equations
+  int quadrature_points;
+  // Flag to add short-period terms to the propagated states
+  bool osculating;
+  // Atmospheric drag model to utilize
+  DragModel drag_model;
+  // Flag to determine if atmospheric drag should be modeled
+  bool has_drag;
+
+  /*
+  Direct constructor (default settings)
+
+  Uses J2-J4 zonal harmonics, no drag, and a one-day step
+
+  @param initial_state Initial osculating state
+  @throws exceptions::ArcException if the orbit is unbound or equatorial
+  */
+  SemiAnalyticPropagator(ICRF initial_state);
+
+  /*
+  Direct constructor (full settings)
+
+  @param initial_state Initial osculating state
+  @param step_size Seconds between mean element integration steps
+  @param zonal_degree Highest zonal harmonic to include (0, 2, 3, or 4)
+  @param quadrature_points Number of averaging samples around the orbit (even)
+  @param osculating Flag to add short-period terms to the propagated states
+  @throws exceptions::ArcException if the orbit is unbound or equatorial, or
+  the settings are invalid
+  */
+  SemiAnalyticPropagator(ICRF initial_state, double step_size,
+                         int zonal_degree, int quadrature_points,
+                         bool osculating);
+
+  /*
+  Change atmospheric drag model
+
+  @param model Drag model to use
+  */
+  void set_drag_model(DragModel model);
+
+  /*
+  Calculate the orbit-averaged rates of a set of mean elements
+
+  @param mean Mean elements
+  @param epoch Epoch of the mean elements
+  @returns (MeanElements) Averaged rate of each element
+  */
+  MeanElements averaged_rates(MeanElements &mean, DateTime &epoch);
+
+  /*
+  Calculate the short-period variations of the osculating elements about a
+  set of mean elements
+
+  @param mean Mean elements
+  @param epoch Epoch of the mean elements
+  @returns (MeanElements) Osculating minus mean elements
+  */
+  MeanElements short_periodic(MeanElements &mean, DateTime &epoch);
+
+  /*
+  Convert an osculating state to mean elements
+
+  @param state Osculating state
+  @returns (MeanElements) Mean elements whose osculating state matches
+  */
+  MeanElements mean_elements(ICRF &state);
+
+  /*
+  Calculate the ICRF state represented by a set of elements
+
+  @param elements Nonsingular elements (osculating or mean)
+  @param epoch Epoch of the elements
+  @returns (icrf::ICRF) Cartesian state of the elements
+  */
+  ICRF state(MeanElements &elements, DateTime &epoch);
+
+  /*
+  Obtain the mean elements at an epoch
+
+  @param epoch Requested epoch
+  @returns (MeanElements) Mean elements interpolated between integration nodes
+  @throws exceptions::ArcException if the orbit decays before the epoch
+  */
+  MeanElements propagate_mean(DateTime &epoch);
+
+  /*
+  Propagate the initial state to specified epoch
+
+  @param epoch Requested epoch
+  @returns (icrf::ICRF) Mean state, or osculating state if requested
+  @throws exceptions::ArcException if the orbit decays before the epoch
+  */
+  ICRF propagate(DateTime &epoch);
+
+  /*
+  Create an Ephemeris by propagating over an interval
+
+  The ephemeris ends early if the orbit decays within the interval
+
+  @param start Start of the interval
+  @param stop End of the interval
+  @param step Seconds between ephemeris states
+  @returns (ephemeris::Ephemeris) Propagated states
+  @throws exceptions::ArcException if the orbit decays before the start
+  */
+  Ephemeris step(DateTime &start, DateTime &stop, double step);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,160 @@
+#ifndef SGP4_H
+#define SGP4_H
+#include <datetime.h>
+#include <ephemeris.h>
+#include <icrf.h>
+#include <propagator.h>
+#include <tle.h>
+
+#include <vector>
+
+// WGS-72 gravitational parameter (km^3/s^2), the SGP4 standard constants
+const double SGP4_MU = 398600.8;
+// WGS-72 equatorial radius (km)
+const double SGP4_RADIUS = 6378.135;
+// WGS-72 zonal harmonics
+const double SGP4_J2 = 0.001082616;
+const double SGP4_J3 = -0.00000253881;
+const double SGP4_J4 = -0.00000165597;
+
+/*
+SGP4 error codes
+
+Returned by SGP4Propagator::propagate_teme when the mean elements can no
+longer be propagated
+*/
+enum SGP4Error {
+  // No error
+  SGP4_OK = 0,
+  // Mean eccentricity is outside of [0, 1)
+  SGP4_ECCENTRICITY = 1,
+  // Mean motion is not positive
+  SGP4_MEAN_MOTION = 2,
+  // Perturbed eccentricity is outside of [0, 1]
+  SGP4_PERTURBED_ECCENTRICITY = 3,
+  // Semi-latus rectum is negative
+  SGP4_SEMI_LATUS_RECTUM = 4,
+  // Orbit has decayed below the surface of the Earth
+  SGP4_DECAYED = 6
+};
+
+/*
+Initialized SGP4/SDP4 model constants of a single element set
+
+Lengths are in Earth radii, times in minutes and angles in radians
+*/
+struct SGP4Record {
+  // Deep space (SDP4) flag, set for periods of 225 minutes or longer
+  bool deep_space;
+  // Simplified drag flag, set for perigee heights below 220 km
+  bool simple;
+  // Mean elements at epoch (un-Kozai'd mean motion)
+  double bstar, ecco, inclo, nodeo, argpo, mo, no;
+  // Secular rates
+  double mdot, argpdot, nodedot;
+  // Drag and long-period coefficients
+  double aycof, con41, cc1, cc4, cc5, d2, d3, d4, delmo, eta, omgcof, sinmao,
+    t2cof, t3cof, t4cof, t5cof, x1mth2, x7thm1, xlcof, xmcof, nodecf;
+  // Greenwich sidereal angle at epoch
+  double gsto;
+  // Deep space resonance flag (0 none, 1 synchronous, 2 half-day)
+  int irez;
+  // Deep space lunar-solar periodic coefficients
+  double e3, ee2, peo, pgho, pho, pinco, plo, se2, se3, sgh2, sgh3, sgh4, sh2,
+    sh3, si2, si3, sl2, sl3, sl4, xgh2, xgh3, xgh4, xh2, xh3, xi2, xi3, xl2,
+    xl3, xl4, zmol, zmos;
+  // Deep space secular and resonance coefficients
+  double d2201, d2211, d3210, d3222, d4410, d4422, d5220, d5232, d5421, d5433,
+    dedt, del1, del2, del3, didt, dmdt, dnodt, domdt, xfact, xlamo;
+};
+
+/*
+SGP4/SDP4 analytic propagator for two-line element sets
+
+States are produced in TEME by the model and rotated into Earth-centered ICRF.
+The deep space resonance integration always restarts from the element epoch,
+so propagation does not depend on the order of requested epochs and a single
+propagator can be shared between threads.
+
+Ref: Vallado, D. A., Crawford, P., Hujsak, R., & Kelso, T. S. (2006).
+Revisiting Spacetrack Report #3. AIAA 2006-6753.
+*/
+class SGP4Propagator : public Propagator {
+public:
+  // Element set being propagated
+  TwoLineElement elements;
+  // Initialized model constants
+  SGP4Record record;
+
+  // Default constructor
+  SGP4Propagator();
+
+  /*
+  Constructor from a two-line element set
+
+  @param elements Element set to propagate
+  @throws exceptions::ArcException if the elements cannot be initialized
+  */
+  SGP4Propagator(TwoLineElement &elements);
+
+  /*
+  Propagate the elements in the model's native TEME frame
+
+  @param tsince Minutes since the element epoch
+  @param r Array into which the TEME position (km) is written
+  @param v Array into which the TEME velocity (km/s) is written
+  @returns (sgp4::SGP4Error) SGP4_OK, or the reason the elements could not be
+  propagated
+  */
+  SGP4Error propagate_teme(double tsince, double r[3], double v[3]);
+
+  /*
+  Propagate the elements to specified epoch
+
+  @param epoch Requested time to which to propagate
+  @returns (icrf::ICRF) Earth-centered ICRF state
+  @throws exceptions::ArcException if the elements cannot be propagated to the
+  requested epoch
+  */
+  ICRF propagate(DateTime &epoch);
+};
+
+/*
+Bulk SGP4/SDP4 propagator for a catalog of element sets
+
+Every element set is evaluated on a shared epoch grid. Work is split across
+threads by epoch, and the TEME to ICRF rotation is computed once per epoch
+rather than once per state. Near-earth element sets are evaluated with a
+branch-free loop over packed (structure of arrays) model constants so the
+compiler can vectorize it; deep space element sets use the scalar model.
+States that cannot be propagated (decayed or invalid elements) are written as
+NaN.
+*/
+class SGP4Catalog {
+public:
+  // Propagators of each element set, in input order
+  std::vector<SGP4Propagator> propagators;
+  // Number of worker threads (0 uses the hardware concurrency)
+  unsigned threads;
+
+  /*
+  Direct constructor
+
+  @param elements Element sets to propagate
+  @throws exceptions::ArcException if any element set cannot be initialized
+  */
+  SGP4Catalog(std::vector<TwoLineElement> &elements);
+
+  /*
+  Propagate every element set over an interval
+
+  @param start Time of the first output point
+  @param stop Time after which no more points are output
+  @param step Number of seconds between output points
+  @returns (std::vector<ephemeris::Ephemeris>) Earth-centered ICRF ephemeris of
+  each element set, in input order
+  */
+  std::vector<Ephemeris> step(DateTime &start, DateTime &stop, double step);
+};
+
+#endif
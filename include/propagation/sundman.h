@@ -0,0 +1,66 @@
+#ifndef SUNDMAN_H
+#define SUNDMAN_H
+#include <datetime.h>
+#include <force_model.h>
+#include <icrf.h>
+#include <rungekutta4.h>
+#include <vectors.h>
+
+/*
+Fourth-order Runge-Kutta with a Sundman time transformation
+
+Integrates in the fictitious time s, where dt = (r / r_ref)^k ds, so a fixed
+step in s becomes a physical step that shrinks near periapsis and grows near
+apoapsis. Highly eccentric orbits then take short steps only where the
+dynamics require them. The step size is the physical step at the reference
+radius (the semi-major axis of the initial orbit). Requested epochs are met
+with a final physical-time step.
+
+Ref: Montenbruck, O., & Gill, E. (2012). Regularization. In Satellite orbits:
+Models, methods, and applications (pp. 143-146). Berlin: Springer-Verlag.
+*/
+class SundmanPropagator : public RungeKutta4 {
+  /*
+  Calculate the derivatives of the state and time with respect to the
+  fictitious time
+
+  @param state State at the start of the step
+  @param k Offset to add to the state position/velocity
+  @param tau Offset to add to the state epoch (seconds)
+  @param dt_ds Derivative of time with respect to the fictitious time
+  @returns (vectors::Vector6) Derivative of the position/velocity
+  */
+  Vector6 regularized_derivatives(ICRF &state, Vector6 &k, double tau,
+                                  double &dt_ds);
+
+  /*
+  Take one fixed step in the fictitious time
+
+  @param state State at the start of the step
+  @param ds Fictitious time step (signed)
+  @returns (icrf::ICRF) State at the end of the step
+  */
+  ICRF regularized_step(ICRF &state, double ds);
+
+public:
+  // Exponent of the radius in the time transformation (1 gives steps uniform
+  // in eccentric anomaly, 2 gives steps uniform in true anomaly)
+  double sundman_power;
+  // Radius at which a fictitious time step equals the physical step size
+  double reference_radius;
+
+  // Direct constructor (default settings)
+  SundmanPropagator(ICRF initial_state);
+
+  // Direct constructor (full settings)
+  SundmanPropagator(ICRF initial_state, double step_size,
+                    ForceModel force_model);
+
+  // Propagate the inital state to specified epoch
+  ICRF propagate(DateTime &epoch);
+
+  // Step the integration a number of seconds forward/backward
+  ICRF integrate(ICRF &state, double step);
+};
+
+#endif
\ No newline at end of file
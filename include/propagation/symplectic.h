@@ -0,0 +1,94 @@
+#ifndef SYMPLECTIC_H
+#define SYMPLECTIC_H
+#include <datetime.h>
+#include <force_model.h>
+#include <icrf.h>
+#include <propagator.h>
+#include <vectors.h>
+
+#include <vector>
+
+enum SymplecticSplitting {
+    // Kinetic/potential split (kick-drift-kick leapfrog)
+    Leapfrog,
+    // Keplerian/perturbation split with Keplerian drifts (Wisdom-Holman)
+    WisdomHolman
+};
+
+/*
+Symplectic integrator for conservative force models
+
+A second-order kick-drift-kick splitting of the equations of motion, raised
+to fourth, sixth, or eighth order by Yoshida's symmetric composition. The
+leapfrog splitting drifts in straight lines and kicks with the full
+acceleration. The Wisdom-Holman splitting drifts along the central-body
+Keplerian orbit (universal variables) and kicks with the remaining
+acceleration, so only the perturbations limit the step. Both conserve a
+modified energy, so the energy error stays bounded over arbitrarily long
+propagations instead of drifting.
+
+Drag and solar radiation pressure are not conservative and are rejected.
+
+Ref: Yoshida, H. (1990). Construction of higher order symplectic integrators.
+Physics Letters A, 150(5-7), 262-268.
+Ref: Wisdom, J., & Holman, M. (1991). Symplectic maps for the n-body problem.
+The Astronomical Journal, 102, 1528-1538.
+*/
+class SymplecticPropagator : public NumericalPropagator {
+  // Step fractions of the second-order stages of one step
+  std::vector<double> weights;
+
+  /*
+  Calculate the acceleration applied by a kick
+
+  @param state State (position and epoch) at which to evaluate
+  @returns (vectors::Vector3) Full acceleration for the leapfrog splitting, or
+  the acceleration less the central-body point mass for Wisdom-Holman
+  */
+  Vector3 kick_acceleration(ICRF &state);
+
+  /*
+  Drift a state a number of seconds without kicks
+
+  @param state State to drift (updated in place)
+  @param dt Seconds to drift (signed)
+  */
+  void drift(ICRF &state, double dt);
+
+public:
+  // Splitting of the equations of motion
+  SymplecticSplitting splitting;
+  // Order of the composed method (2, 4, 6, or 8)
+  int order;
+
+  // Direct constructor (default settings: two-body gravity, second-order
+  // leapfrog)
+  SymplecticPropagator(ICRF initial_state);
+
+  /*
+  Direct constructor (full settings)
+
+  Uses the second-order leapfrog splitting
+
+  @param initial_state Initial state
+  @param step_size Number of seconds between integration steps
+  @param force_model Conservative force model
+  @throws exceptions::ArcException if the force model is not conservative
+  */
+  SymplecticPropagator(ICRF initial_state, double step_size,
+                       ForceModel force_model);
+
+  /*
+  Change the splitting and order of the method
+
+  @param splitting Splitting of the equations of motion
+  @param order Order of the composed method (2, 4, 6, or 8)
+  @throws exceptions::ArcException if the order is not supported
+  */
+  void set_method(SymplecticSplitting splitting, int order);
+
+  // Step the integration a number of seconds forward/backward
+  ICRF integrate(ICRF &state, double step);
+};
+
+#endif
\ No newline at end of file
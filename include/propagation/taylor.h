@@ -0,0 +1,105 @@
+#ifndef TAYLOR_H
+#define TAYLOR_H
+#include <datetime.h>
+#include <force_model.h>
+#include <icrf.h>
+#include <propagator.h>
+#include <vectors.h>
+
+#include <vector>
+
+// Lowest series order the Taylor integrator will select
+const int MIN_TAYLOR_ORDER = 4;
+
+// Highest series order the Taylor integrator will select
+const int MAX_TAYLOR_ORDER = 30;
+
+/*
+Taylor series integrator
+
+Expands the position and velocity in a Taylor series about each step's
+initial epoch, with coefficients of any order generated by automatic
+differentiation (recurrence relations) of the two-body plus J2 equations of
+motion. The order is chosen from the tolerance and each step from the decay
+of the last two coefficients, so steps of a large fraction of an orbit are
+taken at close to machine precision. The step size acts as an upper bound on
+the adaptive step.
+
+The force model may only contain the gravity of the state's central body
+(point mass, with J2 if aspherical).
+
+Ref: Jorba, A., & Zou, M. (2005). A software package for the numerical
+integration of ODEs by means of high-order Taylor methods. Experimental
+Mathematics, 14(1), 99-117.
+*/
+class TaylorPropagator : public NumericalPropagator {
+  // Central body gravitational parameter
+  double mu;
+  // Leading J2 coefficient (3/2 mu J2 R^2), zero if J2 is not modeled
+  double j2_coeff;
+  // Taylor coefficients of each position/velocity component about the start
+  // of the current step
+  std::vector<double> series[6];
+  // Coefficients of intermediate quantities of the equations of motion
+  std::vector<double> r_2, r_m3, r_m5, r_m7, z_2, j2_term;
+
+  /*
+  Generate the Taylor coefficients of the trajectory through a state up to
+  the current order
+
+  @param state State about which to expand
+  */
+  void expand(ICRF &state);
+
+  /*
+  Choose the step size from the last coefficients of the current expansion
+
+  @param state State about which the series was expanded
+  @returns (double) Magnitude of the step in seconds
+  */
+  double series_step(ICRF &state);
+
+  /*
+  Evaluate the current expansion a number of seconds from its epoch
+
+  @param state State about which the series was expanded
+  @param h Seconds from the state epoch (signed)
+  @returns (icrf::ICRF) State at the requested offset
+  */
+  ICRF evaluate(ICRF &state, double h);
+
+public:
+  // Relative error allowed per step
+  double tolerance;
+  // Order of the Taylor series
+  int order;
+  // Number of Taylor steps taken
+  size_t steps;
+
+  // Direct constructor (default settings: two-body gravity, 1e-15 tolerance)
+  TaylorPropagator(ICRF initial_state);
+
+  /*
+  Direct constructor (full settings)
+
+  @param initial_state Initial state
+  @param step_size Largest step in seconds
+  @param force_model Force model containing only central-body gravity
+  @throws exceptions::ArcException if the force model contains other forces
+  */
+  TaylorPropagator(ICRF initial_state, double step_size,
+                   ForceModel force_model);
+
+  /*
+  Change the tolerance and select the matching series order
+
+  @param tolerance Relative error allowed per step
+  @throws exceptions::ArcException if the tolerance is not positive
+  */
+  void set_tolerance(double tolerance);
+
+  // Step the integration a number of seconds forward/backward
+  ICRF integrate(ICRF &state, double step);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef UNSCENTED_H
+#define UNSCENTED_H
+#include <covariance.h>
+#include <datetime.h>
+#include <ephemeris.h>
+#include <force_model.h>
+#include <icrf.h>
+#include <matrices.h>
+
+#include <vector>
+
+/*
+Covariance propagator using the unscented transform
+
+Samples the initial covariance with 2n + 1 sigma points, propagates them
+together (fourth-order Runge-Kutta), and recovers the covariance at each output
+epoch from the propagated points. Sigma points are split into contiguous
+batches, one per worker thread, and each batch is stepped in lockstep so the
+force model setup and third-body lookups are shared within the batch.
+
+Ref: Julier, S. J., & Uhlmann, J. K. (2004). Unscented filtering and nonlinear
+estimation. Proceedings of the IEEE, 92(3), 401-422.
+*/
+class UnscentedPropagator {
+public:
+  // Mean initial state
+  ICRF initial_state;
+  // Covariance of the initial state in ICRF axes
+  Matrix6 initial_covariance;
+  // Number of seconds between integration steps
+  double step_size;
+  // Force model
+  ForceModel force_model;
+  // Spread of the sigma points around the mean
+  double alpha;
+  // Prior knowledge of the distribution (2 is optimal for Gaussian)
+  double beta;
+  // Secondary scaling parameter
+  double kappa;
+  // Number of worker threads (0 uses the hardware concurrency)
+  unsigned threads;
+
+  /*
+  Direct constructor
+
+  Uses alpha = 1, beta = 2, kappa = 0, so lambda = 0: the central point has
+  mean weight 0 and covariance weight 2, and the other 12 points have mean
+  and covariance weights of 1/12. No weight is negative.
+
+  @param initial_state Mean initial state
+  @param initial_covariance Covariance of the initial state in ICRF axes
+  @param step_size Number of seconds between integration steps
+  @param force_model Force model applied to every sigma point
+  */
+  UnscentedPropagator(ICRF initial_state, Matrix6 initial_covariance,
+                      double step_size, ForceModel force_model);
+
+  /*
+  Generate the sigma points of the initial state and covariance
+
+  @returns (std::vector<icrf::ICRF>) 13 sigma points, the first being the mean
+  @throws exceptions::ArcException if the covariance is not positive definite
+  or the scaling parameters are invalid
+  */
+  std::vector<ICRF> sigma_points();
+
+  /*
+  Calculate the weights used to recover the mean and covariance
+
+  @param mean_weights Vector into which the mean weights are written
+  @param cov_weights Vector into which the covariance weights are written
+  */
+  void weights(std::vector<double> &mean_weights, std::vector<double> &cov_weights);
+
+  /*
+  Create an Ephemeris and covariance ephemeris by propagating over an interval
+
+  @param start Time of the first output point
+  @param stop Time after which no more points are output
+  @param step Number of seconds between output points
+  @param covariance Covariance ephemeris into which the propagated covariances
+  are written
+  @returns (ephemeris::Ephemeris) Trajectory of the mean initial state
+  */
+  Ephemeris step(DateTime &start, DateTime &stop, double step,
+                 CovarianceEphemeris &covariance);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef CIVIL_TIME_H
+#define CIVIL_TIME_H
+#include <cstddef>
+#include <cstdint>
+
+// Digits of fractional seconds written by format_civil
+const int CIVIL_FRACTION_DIGITS = 6;
+
+// Size of a buffer large enough for any date written by format_civil
+const size_t CIVIL_BUFFER_SIZE = 48;
+
+/*
+Calendar date formats
+
+Formats with a dedicated parser and formatter
+*/
+enum CivilFormat {
+  // ISO 8601: YYYY-MM-DDTHH:MM:SS.FFFFFF
+  ISO_8601,
+  // STK ephemeris: DD Mon YYYY HH:MM:SS.FFFFFF
+  STK_DATE
+};
+
+/*
+Get the strftime format equivalent to a calendar date format
+
+@param format Calendar date format
+@returns (const char*) strftime format (without fractional seconds)
+*/
+const char* civil_strftime(CivilFormat format);
+
+/*
+Calculate the number of days from 1 Jan 1970 to a date in the proleptic
+Gregorian calendar
+
+Ref: Hinnant, H. (2013). chrono-Compatible Low-Level Date Algorithms.
+http://howardhinnant.github.io/date_algorithms.html
+
+@param year Year (any sign)
+@param month Month of the year (1-12)
+@param day Day of the month (1-31)
+@returns (int64_t) Days since 1 Jan 1970 (negative before)
+*/
+int64_t days_from_civil(int64_t year, int month, int day);
+
+/*
+Calculate the date in the proleptic Gregorian calendar a number of days from
+1 Jan 1970
+
+@param days Days since 1 Jan 1970 (negative before)
+@param year Output year
+@param month Output month of the year (1-12)
+@param day Output day of the month (1-31)
+*/
+void civil_from_days(int64_t days, int64_t &year, int &month, int &day);
+
+/*
+Parse a calendar date
+
+Uses no libc time functions and no heap memory. Fractional seconds are
+optional, trailing whitespace (and a UTC designator for ISO 8601) is ignored.
+The day of an STK date may have one or two digits and the month may be
+abbreviated or in full, in any case.
+
+@param str Characters of the date (need not be null-terminated)
+@param length Number of characters
+@param format Calendar date format of the string
+@param unix_seconds Output whole seconds since 1 Jan 1970 00:00:00
+@param fraction Output fraction of a second, in [0, 1)
+@returns (bool) True if the string is a valid date in the format
+*/
+bool parse_civil(const char str[], size_t length, CivilFormat format,
+                 int64_t &unix_seconds, double &fraction);
+
+/*
+Format a calendar date
+
+Uses no libc time functions and no heap memory. The fraction is rounded to
+CIVIL_FRACTION_DIGITS digits, carrying into the seconds when it rounds up to
+a whole second.
+
+@param unix_seconds Whole seconds since 1 Jan 1970 00:00:00
+@param fraction Fraction of a second, in [0, 1)
+@param format Calendar date format to write
+@param buffer Output buffer of at least CIVIL_BUFFER_SIZE characters
+(null-terminated on return)
+@returns (size_t) Number of characters written (excluding the terminator)
+*/
+size_t format_civil(int64_t unix_seconds, double fraction, CivilFormat format,
+                    char buffer[]);
+
+#endif
\ No newline at end of file
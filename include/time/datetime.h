@@ -1,11 +1,21 @@
 #ifndef DATETIME_H
 #define DATETIME_H
+#include <civil_time.h>
+
+#include <cstddef>
+#include <cstdint>
 #include <ctime>
 #include <string>
 
 // Unix timestamp of J2000
 const double UNIX_J2000 = 946727935.815918;
 
+// Whole seconds of the Unix timestamp of J2000
+const int64_t UNIX_J2000_WHOLE = 946727935;
+
+// Fractional seconds of the Unix timestamp of J2000
+const double UNIX_J2000_FRACTION = 0.815918;
+
 /*
 Time scales
 
@@ -30,20 +40,26 @@ std::string time_scale_str(TimeScale scale);
 /*
 Date and Time
 
+Epochs are held as whole seconds since J2000 plus a fraction of a second, so
+accumulating steps keeps sub-nanosecond precision over any span instead of the
+roughly 0.1 microsecond resolution of a single double at today's epochs
+
 Ref: Montenbruck, O., & Gill, E. (2012). Time and Reference Systems
 In Satellite orbits: Models, methods, and applications (pp. 157-169). Berlin: Springer-Verlag.
 */
 class DateTime {
 public:
-  // Number of seconds since J2000 (1 Jan 2000 12:00:00 TT)
-  double seconds_since_j2000;
+  // Whole seconds since J2000 (1 Jan 2000 12:00:00 TT)
+  int64_t whole_seconds;
+  // Fraction of a second past whole_seconds, in [0, 1)
+  double fraction;
   // Time scale in which this DateTime is represented
   TimeScale scale;
 
   /*
   Default constructor
 
-  Sets seconds_since_j2000 to 0.0 using UTC time scale
+  Sets the epoch to J2000 using UTC time scale
   */
   DateTime();
 
@@ -55,25 +71,56 @@ public:
   */
   DateTime(double seconds, TimeScale scale = UTC);
 
+  /*
+  Constructor using whole and fractional seconds
+
+  @param whole_seconds Whole seconds since J2000
+  @param fraction Fractional seconds (any value, normalized to [0, 1))
+  @param scale Time scale in which this DateTime is represented
+  */
+  DateTime(int64_t whole_seconds, double fraction, TimeScale scale);
+
   /*
   Constructor using input string and format
 
+  ISO 8601 and STK formats are parsed without libc time functions, any other
+  format with strptime
+
   @param datestr String representing the date
   @param datestr String representing the format of the date, using strftime
   parameters
   @param scale Time scale in which this DateTime is represented (default is UTC)
+  @throws exceptions::ArcException if the date does not match the format
   */
   DateTime(std::string datestr, std::string format, TimeScale scale = UTC);
 
+  /*
+  Constructor using characters in a calendar date format
+
+  Allocation-free, for parsing many epochs
+
+  @param datestr Characters of the date (need not be null-terminated)
+  @param length Number of characters
+  @param format Calendar date format of the characters
+  @param scale Time scale in which this DateTime is represented (default is UTC)
+  @throws exceptions::ArcException if the date does not match the format
+  */
+  DateTime(const char datestr[], size_t length, CivilFormat format,
+           TimeScale scale = UTC);
+
   /*
   Constructor using input string in ISO 8601 format:
   YYYY-MM-DDTHH:MM:SS.FFFFFF
 
   @param datestr String representing the date
   @param scale Time scale in which this DateTime is represented (default is UTC)
+  @throws exceptions::ArcException if the date is not in ISO 8601 format
   */
   DateTime(std::string datestr, TimeScale scale = UTC);
 
+  // Get the number of seconds since J2000 as a single double
+  double seconds_since_j2000();
+
   // Convert to `struct tm' representation of *TIMER in UTC
   tm* to_tm();
 
@@ -102,6 +149,8 @@ public:
   /*
   Convert to equivalent time in the International Atomic Time (TAI) scale
 
+  Converts from the time scale of this instance
+
   @returns (datetime::DateTime) This time in the TAI scale
   */
   DateTime tai();
@@ -109,6 +158,8 @@ public:
   /*
   Convert to equivalent time in the Terrestrial Time (TT) scale
 
+  Converts from the time scale of this instance
+
   @returns (datetime::DateTime) This time in the TT scale
   */
   DateTime tt();
@@ -116,6 +167,8 @@ public:
   /*
   Convert to equivalent time in the Barycentric Dynamical Time (TDB) scale
 
+  Converts from the time scale of this instance
+
   @returns (datetime::DateTime) This time in the TDB scale
   */
   DateTime tdb();
@@ -127,9 +180,20 @@ public:
   */
   double gmst_angle();
 
+  /*
+  Calculate the Earth Rotation Angle (ERA) of the IAU 2000 resolutions
+
+  @returns (double) This time as an Earth Rotation Angle in radians, in
+  [0, 2 pi)
+  */
+  double era_angle();
+
   /*
   Increment time by a desired number of seconds
 
+  The whole and fractional parts of the increment are added separately, so
+  repeated increments do not accumulate rounding error of the epoch magnitude
+
   @param seconds Number of seconds to increment the time (can be negative)
   @returns (datetime::DateTime) New instance representing this plus the seconds
   argument
@@ -145,7 +209,7 @@ public:
   double difference(DateTime& other);
 
   /*
-  Evaluates to true if DateTime is equal to another
+  Evaluates to true if DateTime is equal to another (exactly)
 
   @param other DateTime instance to compare
   @returns (bool) Evaluation of the comparison
@@ -168,6 +232,17 @@ public:
   */
   std::string format_fractional(const char fmt[]);
 
+  /*
+  Write date in a calendar date format with fractional seconds
+
+  Allocation-free, for writing many epochs
+
+  @param format Calendar date format to write
+  @param buffer Output buffer of at least CIVIL_BUFFER_SIZE characters
+  @returns (size_t) Number of characters written (excluding the terminator)
+  */
+  size_t write_civil(CivilFormat format, char buffer[]);
+
   /*
   Format date as ISO 8601
 
@@ -0,0 +1,85 @@
+#ifndef LEAP_SECONDS_H
+#define LEAP_SECONDS_H
+#include <cstddef>
+
+/*
+Leap second announcement
+
+Start of an interval of constant TAI-UTC
+*/
+struct LeapSecond {
+  // Start of the interval (seconds since J2000, UTC)
+  double start;
+  // TAI-UTC over the interval in seconds
+  double offset;
+};
+
+/*
+Built-in leap second table (matches data/leap_second.txt)
+
+Compiled in so time conversions need no file I/O, a newer data file can
+replace it at run time (see DataFileHandler::load_leap_seconds)
+*/
+constexpr LeapSecond LEAP_SECONDS[] = {
+  { -883655936.0, 10.0 },
+  { -867931136.0, 11.0 },
+  { -852033536.0, 12.0 },
+  { -820497536.0, 13.0 },
+  { -788961536.0, 14.0 },
+  { -757425536.0, 15.0 },
+  { -725803136.0, 16.0 },
+  { -694267136.0, 17.0 },
+  { -662731136.0, 18.0 },
+  { -631195136.0, 19.0 },
+  { -583934336.0, 20.0 },
+  { -552398336.0, 21.0 },
+  { -520862336.0, 22.0 },
+  { -457703936.0, 23.0 },
+  { -378734336.0, 24.0 },
+  { -315575936.0, 25.0 },
+  { -284039936.0, 26.0 },
+  { -236779136.0, 27.0 },
+  { -205243136.0, 28.0 },
+  { -173707136.0, 29.0 },
+  { -126273536.0, 30.0 },
+  { -79012736.0, 31.0 },
+  { -31579136.0, 32.0 },
+  { 189345663.0, 33.0 },
+  { 284040063.0, 34.0 },
+  { 394372863.0, 35.0 },
+  { 488980863.0, 36.0 },
+  { 536500863.0, 37.0 }
+};
+
+// Number of entries in the built-in leap second table
+constexpr size_t LEAP_SECOND_COUNT = sizeof(LEAP_SECONDS) / sizeof(LeapSecond);
+
+/*
+Find the first built-in leap second after an epoch (binary search)
+
+@param seconds Seconds since J2000 (UTC)
+@param low Lowest index to search
+@param high One past the highest index to search
+@returns (size_t) Index of the first entry starting after the epoch
+*/
+constexpr size_t leap_second_upper_bound(double seconds, size_t low = 0,
+                                         size_t high = LEAP_SECOND_COUNT) {
+  return low == high ? low
+         : LEAP_SECONDS[(low + high) / 2].start <= seconds
+           ? leap_second_upper_bound(seconds, (low + high) / 2 + 1, high)
+           : leap_second_upper_bound(seconds, low, (low + high) / 2);
+}
+
+/*
+Get TAI-UTC from the built-in table (usable in constant expressions)
+
+@param seconds Seconds since J2000 (UTC)
+@returns (double) TAI-UTC in seconds, zero before the first leap second
+*/
+constexpr double builtin_leap_seconds(double seconds) {
+  return leap_second_upper_bound(seconds) == 0
+         ? 0.0
+         : LEAP_SECONDS[leap_second_upper_bound(seconds) - 1].offset;
+}
+
+#endif
\ No newline at end of file
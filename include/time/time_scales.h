@@ -0,0 +1,200 @@
+#ifndef TIME_SCALES_H
+#define TIME_SCALES_H
+#include <datetime.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// TT - TAI in seconds
+const double TT_TAI_OFFSET = 32.184;
+
+/*
+Interval over which a time-scale offset is constant or varies linearly
+*/
+struct OffsetSegment {
+  // Start of the segment (seconds since J2000, in the source scale)
+  double start;
+  // Offset at the start of the segment in seconds
+  double offset;
+  // Rate of change of the offset over the segment (seconds per second)
+  double rate;
+};
+
+/*
+Segment table with a cached index of the most recently used segment
+
+Successive lookups in a propagation or ephemeris are almost always in the
+same or a neighboring segment, so the cached segment is tested before falling
+back to a binary search
+*/
+class OffsetTable {
+  // Segments in increasing start order
+  std::vector<OffsetSegment> segments;
+  // Index of the most recently used segment
+  std::atomic<size_t> hot;
+
+public:
+  // Default constructor (no segments, zero offset everywhere)
+  OffsetTable();
+
+  /*
+  Add a segment after all existing segments
+
+  @param segment Segment to add (must start after the last segment)
+  */
+  void push_back(OffsetSegment segment);
+
+  // Remove all segments
+  void clear();
+
+  /*
+  Get the number of segments
+
+  @returns (size_t) Number of segments in the table
+  */
+  size_t size();
+
+  /*
+  Get the offset at an epoch
+
+  @param seconds Seconds since J2000 in the source scale of the table
+  @returns (double) Offset in seconds, zero before the first segment
+  */
+  double offset(double seconds);
+};
+
+/*
+Time-scale conversion engine
+
+Converts epochs between UTC, UT1, TAI, TT, and TDB using leap-second and
+Earth orientation (UT1-UTC) offsets precomputed into segment tables, built
+once on first use from the built-in leap seconds and the loaded data files.
+Conversions pivot through TAI.
+
+Safe to call from multiple threads
+*/
+class TimeScaleConverter {
+  // TAI-UTC keyed by UTC, and the same segments keyed by TAI
+  OffsetTable tai_utc;
+  OffsetTable tai_utc_by_tai;
+  // UT1-UTC keyed by UTC
+  OffsetTable ut1_utc;
+  // Set once the tables have been built (the flag is checked first since
+  // std::call_once is comparatively slow even after it has run)
+  std::once_flag tables_built;
+  std::atomic<bool> tables_ready;
+
+  // Build the offset tables from the data files
+  void build_tables();
+
+  // Build the TAI-UTC tables from the leap seconds
+  void build_leap_second_tables();
+
+  // Build the UT1-UTC table from the Earth orientation parameters
+  void build_ut1_table();
+
+  /*
+  Calculate TAI minus a time scale at an epoch
+
+  @param seconds Seconds since J2000 in the source scale
+  @param scale Source time scale
+  @returns (double) Seconds to add to convert to TAI
+  */
+  double tai_offset(double seconds, TimeScale scale);
+
+  /*
+  Calculate a time scale minus TAI at a TAI epoch
+
+  @param seconds Seconds since J2000 in TAI
+  @param scale Destination time scale
+  @returns (double) Seconds to add to convert from TAI
+  */
+  double scale_offset(double seconds, TimeScale scale);
+
+public:
+  // Default constructor (tables are built on first conversion)
+  TimeScaleConverter();
+
+  /*
+  Replace the built-in leap seconds with those of a leap seconds file
+
+  Not safe to call while other threads convert epochs
+
+  @param filename Location in the filesystem of the leap seconds file
+  @throws exceptions::ArcException if the file cannot be read or is invalid
+  */
+  void load_leap_seconds(const char filename[]);
+
+  /*
+  Load the Earth orientation parameters (UT1-UTC and polar motion) of an IERS
+  finals.all file
+
+  Not safe to call while other threads convert epochs
+
+  @param filename Location in the filesystem of the finals.all file
+  @throws exceptions::ArcException if the file cannot be read or is invalid
+  */
+  void load_earth_orientation(const char filename[]);
+
+  /*
+  Calculate the offset between time scales at an epoch
+
+  @param seconds Seconds since J2000 in the source scale
+  @param from Source time scale
+  @param to Destination time scale
+  @returns (double) Seconds to add to convert to the destination scale
+  @throws exceptions::ArcException if UT1 is involved and no Earth
+  orientation parameters are loaded
+  */
+  double offset(double seconds, TimeScale from, TimeScale to);
+
+  /*
+  Convert seconds since J2000 between time scales
+
+  @param seconds Seconds since J2000 in the source scale
+  @param from Source time scale
+  @param to Destination time scale
+  @returns (double) Seconds since J2000 in the destination scale
+  */
+  double convert(double seconds, TimeScale from, TimeScale to);
+
+  /*
+  Convert a DateTime to another time scale
+
+  @param epoch Epoch to convert (in its own scale)
+  @param to Destination time scale
+  @returns (datetime::DateTime) Equivalent epoch in the destination scale
+  */
+  DateTime convert(DateTime &epoch, TimeScale to);
+
+  /*
+  Convert an array of epochs between time scales in place
+
+  @param seconds Seconds since J2000 in the source scale (overwritten with
+  the destination scale)
+  @param count Number of epochs
+  @param from Source time scale
+  @param to Destination time scale
+  */
+  void convert_batch(double *seconds, size_t count, TimeScale from,
+                     TimeScale to);
+
+  /*
+  Convert DateTimes to another time scale in place
+
+  @param epochs Epochs to convert (each in its own scale)
+  @param to Destination time scale
+  */
+  void convert_batch(std::vector<DateTime> &epochs, TimeScale to);
+};
+
+/*
+Shared instance of TimeScaleConverter
+
+A single instance lets every conversion reuse the tables and cached segments
+*/
+extern TimeScaleConverter TIME_SCALES;
+
+#endif
\ No newline at end of file
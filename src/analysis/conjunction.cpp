@@ -0,0 +1,397 @@
+#include <conjunction.h>
+#include <exceptions.h>
+#include <file_io.h>
+#include <parallel.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <sstream>
+#include <utility>
+
+/*
+Conjunction screening helpers
+*/
+
+// Number of values stored per object state (position and velocity)
+static const size_t STATE_SIZE = 6;
+
+// Most grid cells a box spans along one axis, beyond the one holding its
+// lowest corner
+static const double MAX_CELL_SPAN = 8.0;
+
+// Osculating orbit shape of an object, used by the prefilters
+struct OrbitShape {
+  // Unit angular momentum (orbit normal)
+  Vector3 normal;
+  // Eccentricity vector
+  Vector3 e_vec;
+  // Eccentricity
+  double e;
+  // Semi-latus rectum (m)
+  double p;
+  // Perigee radius (m)
+  double perigee;
+  // Apogee radius (m, infinite if unbound)
+  double apogee;
+};
+
+// Determine the osculating orbit shape from a packed state
+static OrbitShape orbit_shape(const double *s, double mu) {
+  Vector3 r{s[0], s[1], s[2]};
+  Vector3 v{s[3], s[4], s[5]};
+  Vector3 h = r.cross(v);
+  double h_mag = h.mag();
+  double r_mag = r.mag();
+  // e = (v x h) / mu - r / |r|
+  Vector3 vxh = v.cross(h);
+  Vector3 e_vec{vxh.x / mu - r.x / r_mag, vxh.y / mu - r.y / r_mag,
+                vxh.z / mu - r.z / r_mag};
+  OrbitShape shape;
+  shape.normal = h.scale(1.0 / h_mag);
+  shape.e_vec = e_vec;
+  shape.e = e_vec.mag();
+  shape.p = h_mag * h_mag / mu;
+  shape.perigee = shape.p / (1.0 + shape.e);
+  shape.apogee = shape.e < 1.0 ? shape.p / (1.0 - shape.e) : INFINITY;
+  return shape;
+}
+
+// Check whether the perigee/apogee shells of two orbits come within a distance
+static bool apsides_overlap(OrbitShape &a, OrbitShape &b, double distance) {
+  return std::max(a.perigee, b.perigee) - std::min(a.apogee, b.apogee) <=
+         distance;
+}
+
+// Check whether two orbit paths come within a distance, testing the radius of
+// each orbit near the line of mutual nodes
+static bool paths_overlap(OrbitShape &a, OrbitShape &b, double distance) {
+  // The radius bound below only holds for closed orbits
+  if (a.e >= 1.0 || b.e >= 1.0) {
+    return true;
+  }
+  Vector3 nodes = a.normal.cross(b.normal);
+  double sin_rel_inc = nodes.mag();
+  double r_min = std::min(a.perigee, b.perigee);
+  // Points within the distance of the other plane lie within this angle of
+  // the node line (nearly coplanar orbits cannot be filtered)
+  double s_max = distance / (r_min * sin_rel_inc);
+  if (sin_rel_inc == 0.0 || s_max >= 1.0) {
+    return true;
+  }
+  double window = asin(s_max) + distance / r_min;
+  // Largest change of radius of each orbit within the window (dr/dv is bounded
+  // by e * r^2 / p)
+  double slack_a = a.e * a.apogee * a.apogee / a.p * window;
+  double slack_b = b.e * b.apogee * b.apogee / b.p * window;
+  Vector3 node = nodes.scale(1.0 / sin_rel_inc);
+  for (double sign : {1.0, -1.0}) {
+    Vector3 u = node.scale(sign);
+    // Radius of each orbit in the node direction, r = p / (1 + e . u)
+    double r_a = a.p / (1.0 + a.e_vec.dot(u));
+    double r_b = b.p / (1.0 + b.e_vec.dot(u));
+    if (fabs(r_a - r_b) <= distance + slack_a + slack_b) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Relative position/velocity of two objects on a cubic Hermite interpolation of
+// an interval, tau in [0, 1] spanning dt seconds
+static void hermite_relative(const double *a0, const double *a1,
+                             const double *b0, const double *b1, double dt,
+                             double tau, double *dr, double *dv) {
+  double t2 = tau * tau;
+  double t3 = t2 * tau;
+  double h00 = 2 * t3 - 3 * t2 + 1, h10 = t3 - 2 * t2 + tau;
+  double h01 = -2 * t3 + 3 * t2, h11 = t3 - t2;
+  double d00 = 6 * t2 - 6 * tau, d10 = 3 * t2 - 4 * tau + 1;
+  double d01 = -6 * t2 + 6 * tau, d11 = 3 * t2 - 2 * tau;
+  for (int i = 0; i < 3; i++) {
+    double p0 = b0[i] - a0[i], p1 = b1[i] - a1[i];
+    double v0 = b0[i + 3] - a0[i + 3], v1 = b1[i + 3] - a1[i + 3];
+    dr[i] = h00 * p0 + h10 * dt * v0 + h01 * p1 + h11 * dt * v1;
+    dv[i] = (d00 * p0 + d01 * p1) / dt + d10 * v0 + d11 * v1;
+  }
+}
+
+// Range rate (scaled by range) of two objects on an interval
+static double range_rate(const double *a0, const double *a1, const double *b0,
+                         const double *b1, double dt, double tau) {
+  double dr[3], dv[3];
+  hermite_relative(a0, a1, b0, b1, dt, tau, dr, dv);
+  return dr[0] * dv[0] + dr[1] * dv[1] + dr[2] * dv[2];
+}
+
+// Pack signed grid cell indices into a single key
+static std::uint64_t cell_key(std::int64_t x, std::int64_t y, std::int64_t z) {
+  const std::uint64_t mask = (1 << 21) - 1;
+  return (((std::uint64_t)x & mask) << 42) | (((std::uint64_t)y & mask) << 21) |
+         ((std::uint64_t)z & mask);
+}
+
+/*
+Conjunction screener methods
+*/
+
+// Direct constructor
+ConjunctionScreener::ConjunctionScreener(std::vector<Ephemeris> &catalog,
+                                         double threshold) {
+  if (catalog.size() == 0 || catalog[0].size() < 2) {
+    throw ArcException(
+        "ConjunctionScreener exception: Catalog must contain ephemerides with "
+        "at least two points");
+  }
+  this->threshold = threshold;
+  this->margin = 1000.0;
+  this->threads = 0;
+  this->n_objects = catalog.size();
+  this->central_body = catalog[0].central_body;
+  this->epochs = std::vector<DateTime>{};
+  for (size_t k = 0; k < catalog[0].size(); k++) {
+    this->epochs.push_back(catalog[0].state_epoch(k));
+  }
+  size_t n_epochs = epochs.size();
+  this->states = std::vector<double>(n_epochs * n_objects * STATE_SIZE);
+  for (size_t obj = 0; obj < n_objects; obj++) {
+    Ephemeris &ephem = catalog[obj];
+    if (ephem.size() != n_epochs) {
+      std::stringstream msg;
+      msg << "ConjunctionScreener exception: Ephemeris " << obj << " has "
+          << ephem.size() << " points, expected " << n_epochs;
+      throw ArcException(msg.str());
+    }
+    double offset = ephem.epoch.difference(epochs[0]);
+    const double *offsets = ephem.offsets();
+    for (size_t k = 0; k < n_epochs; k++) {
+      if (ephem.central_body.id() != central_body.id() ||
+          fabs(offset + offsets[k] - epochs[k].difference(epochs[0])) >
+            1e-3) {
+        std::stringstream msg;
+        msg << "ConjunctionScreener exception: Ephemeris " << obj
+            << " does not share the epochs and central body of the catalog";
+        throw ArcException(msg.str());
+      }
+    }
+    // Interleave the state columns by epoch
+    for (size_t c = 0; c < STATE_SIZE; c++) {
+      const double *column = ephem.component((int)c);
+      for (size_t k = 0; k < n_epochs; k++) {
+        states[(k * n_objects + obj) * STATE_SIZE + c] = column[k];
+      }
+    }
+  }
+}
+
+// Screen a single interval between ephemeris points
+void ConjunctionScreener::screen_interval(size_t k,
+                                          std::vector<Conjunction> &found) {
+  double dt = epochs[k + 1].difference(epochs[k]);
+  const double *s0 = &states[k * n_objects * STATE_SIZE];
+  const double *s1 = &states[(k + 1) * n_objects * STATE_SIZE];
+  // Bound the motion of each object over the interval by a box around the
+  // chord, padded by the deviation of the curved path from the chord
+  // (|a| dt^2 / 8) and half of the screening distance
+  std::vector<double> lo(n_objects * 3), hi(n_objects * 3);
+  std::vector<double> extents(n_objects);
+  for (size_t obj = 0; obj < n_objects; obj++) {
+    const double *a = &s0[obj * STATE_SIZE];
+    const double *b = &s1[obj * STATE_SIZE];
+    double r_min = std::min(sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]),
+                            sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]));
+    double sag = central_body.mu() / (r_min * r_min) * dt * dt / 8.0;
+    double pad = sag + 0.5 * (threshold + margin);
+    double extent = 0.0;
+    for (int i = 0; i < 3; i++) {
+      lo[obj * 3 + i] = std::min(a[i], b[i]) - pad;
+      hi[obj * 3 + i] = std::max(a[i], b[i]) + pad;
+      extent = std::max(extent, hi[obj * 3 + i] - lo[obj * 3 + i]);
+    }
+    extents[obj] = extent;
+  }
+  // Size the cells from the threshold plus the displacement over the step of
+  // a typical (median) object, so a few fast objects span more cells instead
+  // of coarsening the grid for the whole catalog; the cells stay large enough
+  // that no box spans more than MAX_CELL_SPAN + 1 cells along an axis
+  double max_extent = *std::max_element(extents.begin(), extents.end());
+  std::nth_element(extents.begin(), extents.begin() + n_objects / 2,
+                   extents.end());
+  double cell = std::max(extents[n_objects / 2], max_extent / MAX_CELL_SPAN);
+  std::vector<std::pair<std::uint64_t, size_t>> entries;
+  entries.reserve(n_objects * 8);
+  for (size_t obj = 0; obj < n_objects; obj++) {
+    std::int64_t c_lo[3], c_hi[3];
+    for (int i = 0; i < 3; i++) {
+      c_lo[i] = (std::int64_t)floor(lo[obj * 3 + i] / cell);
+      c_hi[i] = (std::int64_t)floor(hi[obj * 3 + i] / cell);
+    }
+    for (std::int64_t x = c_lo[0]; x <= c_hi[0]; x++) {
+      for (std::int64_t y = c_lo[1]; y <= c_hi[1]; y++) {
+        for (std::int64_t z = c_lo[2]; z <= c_hi[2]; z++) {
+          entries.push_back(std::make_pair(cell_key(x, y, z), obj));
+        }
+      }
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+  // Osculating orbit shapes, computed on first use
+  std::vector<OrbitShape> shapes(n_objects);
+  std::vector<bool> has_shape(n_objects, false);
+  double filter_distance = threshold + margin;
+  size_t last = epochs.size() - 2;
+  // Pair the objects sharing each cell
+  size_t run_begin = 0;
+  while (run_begin < entries.size()) {
+    std::uint64_t key = entries[run_begin].first;
+    size_t run_end = run_begin;
+    while (run_end < entries.size() && entries[run_end].first == key) {
+      run_end++;
+    }
+    for (size_t m = run_begin; m < run_end; m++) {
+      for (size_t n = m + 1; n < run_end; n++) {
+        size_t a = entries[m].second;
+        size_t b = entries[n].second;
+        // Boxes must overlap, and the pair is only handled in the cell holding
+        // the lowest corner of the overlap (pairs sharing several cells are
+        // screened once)
+        bool overlap = true;
+        std::int64_t owner[3];
+        for (int i = 0; i < 3 && overlap; i++) {
+          double o_lo = std::max(lo[a * 3 + i], lo[b * 3 + i]);
+          double o_hi = std::min(hi[a * 3 + i], hi[b * 3 + i]);
+          overlap = o_lo <= o_hi;
+          owner[i] = (std::int64_t)floor(o_lo / cell);
+        }
+        if (!overlap || cell_key(owner[0], owner[1], owner[2]) != key) {
+          continue;
+        }
+        // Prefilters on the osculating orbits at the start of the interval
+        for (size_t obj : {a, b}) {
+          if (!has_shape[obj]) {
+            shapes[obj] = orbit_shape(&s0[obj * STATE_SIZE], central_body.mu());
+            has_shape[obj] = true;
+          }
+        }
+        if (!apsides_overlap(shapes[a], shapes[b], filter_distance) ||
+            !paths_overlap(shapes[a], shapes[b], filter_distance)) {
+          continue;
+        }
+        // Refine the time of closest approach (zero of the range rate)
+        const double *a0 = &s0[a * STATE_SIZE], *a1 = &s1[a * STATE_SIZE];
+        const double *b0 = &s0[b * STATE_SIZE], *b1 = &s1[b * STATE_SIZE];
+        double f0 = range_rate(a0, a1, b0, b1, dt, 0.0);
+        double f1 = range_rate(a0, a1, b0, b1, dt, 1.0);
+        double tau;
+        if (f0 < 0.0 && f1 >= 0.0) {
+          // Closing at the start and opening at the end, use the Illinois
+          // variant of regula falsi
+          double t_lo = 0.0, t_hi = 1.0;
+          double f_lo = f0, f_hi = f1;
+          int side = 0;
+          tau = 0.0;
+          for (int iter = 0; iter < 100; iter++) {
+            tau = (t_lo * f_hi - t_hi * f_lo) / (f_hi - f_lo);
+            double f = range_rate(a0, a1, b0, b1, dt, tau);
+            if (f < 0.0) {
+              t_lo = tau;
+              f_lo = f;
+              if (side == -1) {
+                f_hi /= 2.0;
+              }
+              side = -1;
+            } else {
+              t_hi = tau;
+              f_hi = f;
+              if (side == 1) {
+                f_lo /= 2.0;
+              }
+              side = 1;
+            }
+            if ((t_hi - t_lo) * dt < 1e-6 || f == 0.0) {
+              break;
+            }
+          }
+        } else if (k == 0 && f0 >= 0.0) {
+          // Already opening at the start of the ephemerides
+          tau = 0.0;
+        } else if (k == last && f1 < 0.0) {
+          // Still closing at the end of the ephemerides
+          tau = 1.0;
+        } else {
+          continue;
+        }
+        double dr[3], dv[3];
+        hermite_relative(a0, a1, b0, b1, dt, tau, dr, dv);
+        double miss = sqrt(dr[0] * dr[0] + dr[1] * dr[1] + dr[2] * dr[2]);
+        if (miss <= threshold) {
+          double speed = sqrt(dv[0] * dv[0] + dv[1] * dv[1] + dv[2] * dv[2]);
+          found.push_back(Conjunction{std::min(a, b), std::max(a, b),
+                                      epochs[k].increment(tau * dt), miss,
+                                      speed});
+        }
+      }
+    }
+    run_begin = run_end;
+  }
+}
+
+// Screen the catalog for close approaches
+std::vector<Conjunction> ConjunctionScreener::screen() {
+  size_t n_intervals = epochs.size() - 1;
+  // Conjunctions found in each interval, each written by a single worker
+  std::vector<std::vector<Conjunction>> found(n_intervals);
+  parallel_for(n_intervals, threads, [&](size_t begin, size_t end) {
+    for (size_t k = begin; k < end; k++) {
+      screen_interval(k, found[k]);
+    }
+  });
+  std::vector<Conjunction> conjunctions;
+  for (std::vector<Conjunction> &interval : found) {
+    // Order within an interval by time of closest approach, then by pair
+    std::sort(interval.begin(), interval.end(),
+              [](Conjunction &c_1, Conjunction &c_2) {
+                double dt = c_1.tca.difference(c_2.tca);
+                if (dt != 0.0) {
+                  return dt < 0.0;
+                }
+                if (c_1.primary != c_2.primary) {
+                  return c_1.primary < c_2.primary;
+                }
+                return c_1.secondary < c_2.secondary;
+              });
+    conjunctions.insert(conjunctions.end(), interval.begin(), interval.end());
+  }
+  return conjunctions;
+}
+
+// Write conjunctions to a text report
+void write_conjunctions(std::vector<Conjunction> &conjunctions,
+                        std::vector<std::string> &names, const char filename[]) {
+  std::vector<std::string> lines;
+  lines.push_back("# Arc conjunction report");
+  std::stringstream count;
+  count << "# Conjunctions " << conjunctions.size();
+  lines.push_back(count.str());
+  lines.push_back(
+      "# TCA (UTC), primary, secondary, miss distance (m), relative speed "
+      "(m/s)");
+  for (Conjunction &c : conjunctions) {
+    std::stringstream line;
+    line << c.tca.to_iso() << " " << names[c.primary] << " "
+         << names[c.secondary] << std::setprecision(6) << std::fixed << " "
+         << c.miss_distance << " " << c.relative_speed;
+    lines.push_back(line.str());
+  }
+  try {
+    write_lines_to_file(lines, filename);
+  } catch (ArcException err) {
+    std::cout << err.what() << std::endl;
+    std::stringstream msg;
+    msg << "conjunction::write_conjunctions exception: Writing report to file '"
+        << filename << "' failed";
+    throw ArcException(msg.str());
+  }
+}
\ No newline at end of file
@@ -6,6 +6,42 @@
 
 #include <sstream>
 
+// Body registry, in handle order, using parameters derived from:
+// - NASA Space Science Data Coordinated Archive
+// - EGM-2008 (NGA) for Earth
+extern const BodyConstants BODY_REGISTRY[BODY_COUNT] = {
+  // Sun
+  body_constants(10, 132712440018000003072.0, 695700000.0, 695700000.0,
+                 Vector3{ 0, 0, 2.8653296490574722e-06 }),
+  // Mercury
+  body_constants(199, 22032000000000.0, 2439700.0, 2439700.0,
+                 Vector3{ 0, 0, 1.240013030109886e-06 }),
+  // Venus
+  body_constants(299, 324859000000000.0, 6051800.0, 6051800.0,
+                 Vector3{ 0, 0, -2.992398738488947e-07 }),
+  // Earth
+  body_constants(399, 398600441800000.0, 6378137.0, 6356752.3,
+                 Vector3{ 0, 0, 7.292115024135738e-05 }),
+  // Luna
+  body_constants(301, 4904869500000.0, 1738100.0, 1736000.0,
+                 Vector3{ 0, 0, 2.6616995272150692e-06 }),
+  // Mars
+  body_constants(499, 42828370000000.0, 3396200.0, 3376200.0,
+                 Vector3{ 0, 0, 7.088218111185524e-05 }),
+  // Jupiter
+  body_constants(599, 126686534900000000.0, 71492000.0, 66854000.0,
+                 Vector3{ 0, 0, 0.00017734058128229425 }),
+  // Saturn
+  body_constants(699, 37931187900000000.0, 60268000.0, 54364000.0,
+                 Vector3{ 0, 0, 0.00017070904264420285 }),
+  // Uranus
+  body_constants(799, 5793939900000000.0, 25559000.0, 24973000.0,
+                 Vector3{ 0, 0, -0.00010123766537166816 }),
+  // Neptune
+  body_constants(899, 6836529900000000.0, 24764000.0, 24341000.0,
+                 Vector3{ 0, 0, 0.00010833825276190748 })
+};
+
 // Get the common name of a body by NAIF ID
 std::string get_body_name(int id) {
   switch (id) {
@@ -77,25 +113,12 @@ Celestial body methods
 */
 
 // Get the body's common name
-std::string CelestialBody::get_name() { return get_body_name(id); }
-
-// Return the ratio between this body's polar and equatorial radii
-double CelestialBody::flattening() {
-  return (radius_equator - radius_polar) / radius_equator;
-}
-
-// Return the ratio between this body's polar and equatorial radii
-double CelestialBody::j2() {
-  double rot_mag = rotation.mag();
-  double fltng = flattening();
-  double j2 = (2.0*fltng/3.0) - (pow(radius_equator, 3)*pow(rot_mag, 2))/(3*mu);
-  return j2;
-}
+std::string CelestialBody::get_name() const { return get_body_name(id()); }
 
 // Obtain the ICRF state of this body at an epoch
-ICRF CelestialBody::propagate(DateTime& epoch) {
+ICRF CelestialBody::propagate(DateTime& epoch) const {
   // Get the planet state from the body propagation handler
-  return BODY_PROPAGATOR.get_state(id, epoch);
+  return BODY_PROPAGATOR.get_state(id(), epoch);
 }
 
 /*
@@ -104,7 +127,7 @@ CelestialBody operator functions
 
 // I/O stream
 std::ostream& operator<<(std::ostream& out, CelestialBody& body) {
-  out << "[CelestialBody] { ID: " << body.id << ", Name: " << body.get_name()
+  out << "[CelestialBody] { ID: " << body.id() << ", Name: " << body.get_name()
       << " }";
   return out;
 }
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include <cip_series.h>
+#include <exceptions.h>
+#include <file_io.h>
+#include <math_utils.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+// Polynomial parts of X, Y, and s + XY/2 (microarcseconds)
+static constexpr double CIP_POLYNOMIALS[3][6] = {
+  { -16617.0, 2004191898.0, -429782.9, -198618.34, 7.578, 5.9285 },
+  { -6951.0, -25896.0, -22407274.7, 1900.59, 1112.526, 0.1358 },
+  { 94.0, 3808.65, -122.68, -72574.11, 27.98, 15.62 }
+};
+
+// Lunisolar (Delaunay) argument polynomials (arcseconds)
+static constexpr double DELAUNAY_POLYS[5][5] = {
+  // Moon anomaly (l)
+  { 485868.249036, 1717915923.2178, 31.8792, 0.051635, -0.00024470 },
+  // Sun anomaly (l')
+  { 1287104.793048, 129596581.0481, -0.5532, 0.000136, -0.00001149 },
+  // Moon argument of latitude (F)
+  { 335779.526232, 1739527262.8478, -12.7512, -0.001037, 0.00000417 },
+  // Moon elongation from the Sun (D)
+  { 1072260.703692, 1602961601.2090, -6.3706, 0.006593, -0.00003169 },
+  // Moon RAAN (Omega)
+  { 450160.398036, -6962890.5431, 7.4722, 0.007702, -0.00005939 }
+};
+
+// Planetary mean longitudes, Mercury through Neptune, and the general
+// precession in longitude (radians)
+static constexpr double PLANETARY_POLYS[9][3] = {
+  { 4.402608842, 2608.7903141574, 0.0 },
+  { 3.176146697, 1021.3285546211, 0.0 },
+  { 1.753470314, 628.3075849991, 0.0 },
+  { 6.203480913, 334.0612426700, 0.0 },
+  { 0.599546497, 52.9690962641, 0.0 },
+  { 0.874016757, 21.3299104960, 0.0 },
+  { 5.481293872, 7.4781598567, 0.0 },
+  { 5.311886287, 3.8133035638, 0.0 },
+  { 0.0, 0.02438175, 0.00000538691 }
+};
+
+// Smallest amplitude of the LUNISOLAR_SERIES truncation (microarcseconds)
+static const double LUNISOLAR_THRESHOLD = 100.0;
+
+// Node index marking an empty cache slot
+static const int64_t EMPTY_NODE = INT64_MIN;
+
+// Shared CIP model instance
+CipModel CIP_MODEL{};
+
+// Convert microarcseconds to radians
+static double uas_to_radians(double uas) {
+  return arcsec_to_radians(uas * 1e-6);
+}
+
+// Calculate the fundamental arguments of the IAU 2006/2000A series in radians
+std::array<double, CIP_ARGUMENT_COUNT> cip_arguments(double t) {
+  std::array<double, CIP_ARGUMENT_COUNT> args;
+  for (int k = 0; k < 5; k++) {
+    // Reduce to one revolution before converting, keeping precision
+    args[k] = arcsec_to_radians(fmod(eval_poly(t, DELAUNAY_POLYS[k]),
+                                     1296000.0));
+  }
+  for (int k = 0; k < 9; k++) {
+    args[5 + k] = fmod(eval_poly(t, PLANETARY_POLYS[k]), 2.0 * M_PI);
+  }
+  return args;
+}
+
+// Read the terms of an IERS Conventions table
+static std::vector<CipTerm> read_cip_table(const char filename[]) {
+  std::vector<std::string> lines = read_lines_from_file(filename);
+  std::vector<CipTerm> terms{};
+  int power = 0;
+  for (std::string &l : lines) {
+    // Terms follow a "j = <power>" heading
+    const char *heading = strstr(l.c_str(), "j =");
+    if (heading != NULL) {
+      power = atoi(heading + 3);
+      continue;
+    }
+    // Term lines hold an index, the sine and cosine coefficients, and the
+    // multipliers of the fundamental arguments
+    const char *start = l.c_str();
+    char *end;
+    double values[3 + CIP_ARGUMENT_COUNT];
+    int count = 0;
+    while (count < 3 + CIP_ARGUMENT_COUNT) {
+      values[count] = strtod(start, &end);
+      if (end == start) {
+        break;
+      }
+      start = end;
+      count += 1;
+    }
+    if (count < 3 + CIP_ARGUMENT_COUNT) {
+      continue;
+    }
+    if (power < 0 || power >= CIP_POWER_COUNT) {
+      std::stringstream msg;
+      msg << "CipModel::load_series exception: Unsupported power of time "
+          << power << " in '" << filename << "'";
+      throw ArcException(msg.str());
+    }
+    CipTerm term;
+    term.power = power;
+    term.sin_coeff = values[1];
+    term.cos_coeff = values[2];
+    for (int k = 0; k < CIP_ARGUMENT_COUNT; k++) {
+      term.multipliers[k] = (int)values[3 + k];
+    }
+    terms.push_back(term);
+  }
+  if (terms.size() == 0) {
+    std::stringstream msg;
+    msg << "CipModel::load_series exception: No series terms in '"
+        << filename << "'";
+    throw ArcException(msg.str());
+  }
+  return terms;
+}
+
+/*
+CipModel methods
+*/
+
+// Default constructor
+CipModel::CipModel()
+  : argument_count{ 0 }, truncation{ FULL_SERIES }, threshold{ 0.0 },
+    cache_step{ CIP_CACHE_STEP } {
+  clear_cache();
+}
+
+// Load the X, Y, and s + XY/2 series from IERS Conventions tables
+void CipModel::load_series(const char x_filename[], const char y_filename[],
+                           const char s_filename[]) {
+  std::array<std::vector<CipTerm>, 3> loaded{
+    { read_cip_table(x_filename), read_cip_table(y_filename),
+      read_cip_table(s_filename) } };
+  terms = loaded;
+  build_series();
+}
+
+// Check whether the series have been loaded
+bool CipModel::loaded() { return terms[0].size() > 0; }
+
+// Select the terms of the series to evaluate
+void CipModel::set_truncation(SeriesTruncation truncation, double threshold) {
+  this->truncation = truncation;
+  this->threshold = threshold;
+  build_series();
+}
+
+// Get the number of active periodic terms
+size_t CipModel::term_count() {
+  return series[0].argument.size() + series[1].argument.size() +
+         series[2].argument.size();
+}
+
+// Set the spacing of the interpolation cache
+void CipModel::set_cache_step(double days) {
+  cache_step = days;
+  clear_cache();
+}
+
+// Rebuild the active series and shared arguments from the loaded terms
+void CipModel::build_series() {
+  std::map<std::array<int, CIP_ARGUMENT_COUNT>, uint32_t> arguments{};
+  for (int k = 0; k < CIP_ARGUMENT_COUNT; k++) {
+    multipliers[k].clear();
+  }
+  for (int n = 0; n < 3; n++) {
+    CipSeries &active = series[n];
+    active.argument.clear();
+    active.sin_coeff.clear();
+    active.cos_coeff.clear();
+    for (int j = 0; j < CIP_POWER_COUNT; j++) {
+      active.power_start[j] = active.argument.size();
+      for (CipTerm &term : terms[n]) {
+        if (term.power != j) {
+          continue;
+        }
+        double amplitude = sqrt(term.sin_coeff * term.sin_coeff +
+                                term.cos_coeff * term.cos_coeff);
+        bool keep = true;
+        if (truncation == LUNISOLAR_SERIES) {
+          for (int k = 5; k < CIP_ARGUMENT_COUNT; k++) {
+            keep = keep && term.multipliers[k] == 0;
+          }
+          keep = keep && amplitude >= LUNISOLAR_THRESHOLD;
+        }
+        else if (truncation == THRESHOLD_SERIES) {
+          keep = amplitude >= threshold;
+        }
+        if (!keep) {
+          continue;
+        }
+        // Reuse the argument of an earlier term with the same multipliers
+        std::map<std::array<int, CIP_ARGUMENT_COUNT>, uint32_t>::iterator
+          found = arguments.find(term.multipliers);
+        uint32_t index;
+        if (found != arguments.end()) {
+          index = found->second;
+        }
+        else {
+          index = (uint32_t)arguments.size();
+          arguments[term.multipliers] = index;
+          for (int k = 0; k < CIP_ARGUMENT_COUNT; k++) {
+            multipliers[k].push_back(term.multipliers[k]);
+          }
+        }
+        active.argument.push_back(index);
+        active.sin_coeff.push_back(uas_to_radians(term.sin_coeff));
+        active.cos_coeff.push_back(uas_to_radians(term.cos_coeff));
+      }
+    }
+    active.power_start[CIP_POWER_COUNT] = active.argument.size();
+  }
+  argument_count = arguments.size();
+  clear_cache();
+}
+
+// Mark every cache node as empty
+void CipModel::clear_cache() {
+  for (CacheNode &node : cache) {
+    node.version = 0;
+    node.index = EMPTY_NODE;
+  }
+}
+
+// Evaluate the series directly
+CipCoordinates CipModel::evaluate(double t) {
+  if (!loaded()) {
+    throw ArcException(
+      "CipModel::evaluate exception: IAU 2006/2000A series are not loaded");
+  }
+  // Sum the multiples of each fundamental argument, one argument at a time
+  // so the inner loop runs over contiguous multipliers
+  std::array<double, CIP_ARGUMENT_COUNT> fundamental = cip_arguments(t);
+  std::vector<double> phase(argument_count, 0.0);
+  for (int k = 0; k < CIP_ARGUMENT_COUNT; k++) {
+    const double *m = multipliers[k].data();
+    double f = fundamental[k];
+    for (size_t i = 0; i < argument_count; i++) {
+      phase[i] += m[i] * f;
+    }
+  }
+  std::vector<double> sin_phase(argument_count);
+  std::vector<double> cos_phase(argument_count);
+  for (size_t i = 0; i < argument_count; i++) {
+    sin_phase[i] = sin(phase[i]);
+    cos_phase[i] = cos(phase[i]);
+  }
+  // Sum the terms of each power of time, then add them to the polynomial
+  std::array<double, 3> values;
+  for (int n = 0; n < 3; n++) {
+    CipSeries &active = series[n];
+    std::array<double, CIP_POWER_COUNT> sums;
+    for (int j = 0; j < CIP_POWER_COUNT; j++) {
+      double sum = 0.0;
+      for (size_t i = active.power_start[j]; i < active.power_start[j + 1];
+           i++) {
+        uint32_t a = active.argument[i];
+        sum += active.sin_coeff[i] * sin_phase[a] +
+               active.cos_coeff[i] * cos_phase[a];
+      }
+      sums[j] = sum;
+    }
+    double periodic = sums[CIP_POWER_COUNT - 1];
+    for (int j = CIP_POWER_COUNT - 2; j >= 0; j--) {
+      periodic = sums[j] + t * periodic;
+    }
+    values[n] = uas_to_radians(eval_poly(t, CIP_POLYNOMIALS[n])) + periodic;
+  }
+  // The third series is s + XY/2
+  double x = values[0], y = values[1];
+  return CipCoordinates{ x, y, values[2] - x * y / 2.0 };
+}
+
+// Get the coordinates at a cache node, evaluating it on a miss
+CipCoordinates CipModel::cache_node(int64_t index) {
+  size_t slot = (size_t)(((index % (int64_t)CIP_CACHE_SIZE) +
+                          (int64_t)CIP_CACHE_SIZE) % (int64_t)CIP_CACHE_SIZE);
+  CacheNode &node = cache[slot];
+  // A hit is valid if no writer started or finished while it was read
+  uint64_t version = node.version.load(std::memory_order_acquire);
+  if (version % 2 == 0 &&
+      node.index.load(std::memory_order_relaxed) == index) {
+    CipCoordinates hit{ node.x.load(std::memory_order_relaxed),
+                        node.y.load(std::memory_order_relaxed),
+                        node.s.load(std::memory_order_relaxed) };
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (node.version.load(std::memory_order_relaxed) == version) {
+      return hit;
+    }
+  }
+  // Evaluate outside the lock, so threads missing different nodes overlap
+  CipCoordinates coordinates = evaluate(index * cache_step / 36525.0);
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  uint64_t written = node.version.load(std::memory_order_relaxed);
+  node.version.store(written + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  node.index.store(index, std::memory_order_relaxed);
+  node.x.store(coordinates.x, std::memory_order_relaxed);
+  node.y.store(coordinates.y, std::memory_order_relaxed);
+  node.s.store(coordinates.s, std::memory_order_relaxed);
+  node.version.store(written + 2, std::memory_order_release);
+  return coordinates;
+}
+
+// Get the CIP coordinates, interpolated from the cache when it is enabled
+CipCoordinates CipModel::coordinates(double t) {
+  if (cache_step <= 0.0) {
+    return evaluate(t);
+  }
+  // Interpolate with the two nodes on each side of the epoch
+  double u = t * 36525.0 / cache_step;
+  int64_t index = (int64_t)floor(u);
+  double p = u - index;
+  double w[4] = {
+    -p * (p - 1.0) * (p - 2.0) / 6.0,
+    (p + 1.0) * (p - 1.0) * (p - 2.0) / 2.0,
+    -(p + 1.0) * p * (p - 2.0) / 2.0,
+    (p + 1.0) * p * (p - 1.0) / 6.0
+  };
+  CipCoordinates interpolated{ 0.0, 0.0, 0.0 };
+  for (int i = 0; i < 4; i++) {
+    CipCoordinates node = cache_node(index - 1 + i);
+    interpolated.x += w[i] * node.x;
+    interpolated.y += w[i] * node.y;
+    interpolated.s += w[i] * node.s;
+  }
+  return interpolated;
+}
\ No newline at end of file
@@ -3,106 +3,226 @@
 #include <earth_model.h>
 #include <math_utils.h>
 
-#include <vector>
+#include <exceptions.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+// Rate of the Earth Rotation Angle in radians per second
+static const double ERA_RATE = 2.0 * M_PI * 1.00273781191135448 / 86400.0;
+
+// TIO locator rate (arcseconds per Julian century)
+static const double S_PRIME_RATE = -47e-6;
+
+// Earth orientation model of the ITRF/ICRF rotation
+static EarthModel earth_model = IAU_1980;
 
 // Return Earth's rotation vector, in radians per second
-Vector3 earth_rotation(DateTime &epoch) {
+Vector3 earth_rotation(DateTime & /* epoch */) {
   // Earth rotation vector
-  return EARTH.rotation;
-  // return EARTH.rotation.scale(1.0 - finals.lod / 86400.0);
+  return EARTH.rotation();
+  // return EARTH.rotation().scale(1.0 - finals.lod / 86400.0);
+};
+
+// Precession polynomials in Julian centuries (degrees)
+static constexpr double ZETA_POLY[] = { 0.0, 0.6406161, 0.0000839, 5.0e-6 };
+static constexpr double THETA_POLY[] = { 0.0, 0.556753, -0.0001185, -1.16e-5 };
+static constexpr double ZED_POLY[] = { 0.0, 0.6406161, 0.0003041, 5.1e-6 };
+
+// Mean obliquity polynomial in Julian centuries (degrees)
+static constexpr double MEAN_EPS_POLY[] = {
+  23.439291, -0.013004, -1.64e-7, 5.04e-7
+};
+
+// Fundamental argument polynomials in Julian centuries (degrees)
+static constexpr double NUTATION_ARG_POLYS[5][4] = {
+  // Moon anomaly
+  { 134.96340251, 1325.0 * 360.0 + 198.8675605, 0.0088553, 1.4343e-5 },
+  // Sun anomaly
+  { 357.52910918, 99.0 * 360.0 + 359.0502911, -0.0001537, 3.8e-8 },
+  // Moon latitude
+  { 93.27209062, 1342.0 * 360.0 + 82.0174577, -0.003542, -2.88e-7 },
+  // Moon elongation from the Sun
+  { 297.85019547, 1236.0 * 360.0 + 307.1114469, -0.0017696, 1.831e-6 },
+  // Moon RAAN
+  { 125.04455501, -(5.0 * 360.0 + 134.1361851), 0.0020756, 2.139e-6 }
 };
 
 // Calculate the zeta, theta, and zed angles of precession in radians
 std::array<double, 3> earth_precession(DateTime &epoch) {
   // Algorithim requires epoch in TDB scale, expressed in Julian Centuries
-  double t = epoch.tdb().julian_centuries();
+  return earth_precession(epoch.tdb().julian_centuries());
+}
+
+// Calculate the zeta, theta, and zed angles of precession in radians
+std::array<double, 3> earth_precession(double t) {
   // Evaluate precession polynomials using Julian centuries value
-  double zeta =
-      eval_poly(t, std::vector<double>{0.0, 0.6406161, 0.0000839, 5.0e-6});
-  double theta =
-      eval_poly(t, std::vector<double>{0.0, 0.556753, -0.0001185, -1.16e-5});
-  double zed =
-      eval_poly(t, std::vector<double>{0.0, 0.6406161, 0.0003041, 5.1e-6});
+  double zeta = eval_poly(t, ZETA_POLY);
+  double theta = eval_poly(t, THETA_POLY);
+  double zed = eval_poly(t, ZED_POLY);
   // Convert polynomial outputs (degrees) to radians and return
   return std::array<double, 3>{radians(zeta), radians(theta), radians(zed)};
 }
 
+// Calculate the fundamental arguments of the nutation series in radians
+std::array<double, 5> nutation_arguments(double t) {
+  std::array<double, 5> args;
+  for (int k = 0; k < 5; k++) {
+    args[k] = radians(eval_poly(t, NUTATION_ARG_POLYS[k]));
+  }
+  return args;
+}
+
 // Calculate the delta psi, delta epsilon, and mean epsilon angles of nutation in radians
 std::array<double, 3> earth_nutation(DateTime &epoch, int n) {
-    double r = 360.0;
-    // Algorithim requires epoch in TDB scale, expressed in Julian Centuries
-    double t = epoch.tdb().julian_centuries();
-    // Compute value of Mean Epsilon
-    double mean_eps = eval_poly(t, std::vector<double> {
-      23.439291,
-      -0.013004,
-      -1.64e-7,
-      5.04e-7
-    });
-    mean_eps = radians(mean_eps);
-    // Moon Anomaly
-    double moon_anom = eval_poly(t, std::vector<double> {
-      134.96340251,
-      1325.0 * r + 198.8675605,
-      0.0088553,
-      1.4343e-5
-    });
-    // Moon Latitude
-    double moon_lat = eval_poly(t, std::vector<double> {
-      93.27209062,
-      1342.0 * r + 82.0174577,
-      -0.003542,
-      -2.88e-7
-    });
-    // Moon RAAN
-    double moon_raan = eval_poly(t, std::vector<double> {
-      125.04455501,
-      -(5.0 * r + 134.1361851),
-      0.0020756,
-      2.139e-6
-    });
-    // Sun anomaly
-    double sun_anom = eval_poly(t, std::vector<double> {
-      357.52910918,
-      99.0 * r + 359.0502911,
-      -0.0001537,
-      3.8e-8
-    });
-    // Sun Longitude
-    double sun_e_long = eval_poly(t, std::vector<double> {
-      297.85019547,
-      1236.0 * r + 307.1114469,
-      -0.0017696,
-      1.831e-6
-    });
-    // Compute values of Delta-Psi and Delta-Epsilon
-    double delta_psi = 0.0;
-    double delta_eps = 0.0;
-    // Iterate through the IAU 1980 nutation values
-    for (int i = 0; i < n; i++) {
-      std::array<double, 9> ln = IAU_1980_VALUES[i];
-      double a1 = ln[0];
-      double a2 = ln[1];
-      double a3 = ln[2];
-      double a4 = ln[3];
-      double a5 = ln[4];
-      double Ai = ln[5];
-      double Bi = ln[6];
-      double Ci = ln[7];
-      double Di = ln[8];
-      // Build the nutation argument
-      double arg = radians(a1 * moon_anom + a2 * sun_anom + a3 * moon_lat +
-                           a4 * sun_e_long + a5 * moon_raan);
-      // Coefficients
-      double sin_c = Ai + Bi * t;
-      double cos_c = Ci + Di * t;
-      // Compute delta psi
-      delta_psi += sin_c * sin(arg);
-      delta_eps += cos_c * cos(arg);
+  // Algorithim requires epoch in TDB scale, expressed in Julian Centuries
+  return earth_nutation(epoch.tdb().julian_centuries(), n);
+}
+
+// Calculate the delta psi, delta epsilon, and mean epsilon angles of nutation in radians
+std::array<double, 3> earth_nutation(double t, int n) {
+  // Compute value of Mean Epsilon
+  double mean_eps = radians(eval_poly(t, MEAN_EPS_POLY));
+  // Cosine and sine of each multiple of each fundamental argument, built
+  // from the single angle with cos((m+1)x) = cos(mx)cos(x) - sin(mx)sin(x)
+  // and sin((m+1)x) = sin(mx)cos(x) + cos(mx)sin(x)
+  std::array<double, 5> args = nutation_arguments(t);
+  double cos_m[5][NUTATION_MAX_MULTIPLIER + 1];
+  double sin_m[5][NUTATION_MAX_MULTIPLIER + 1];
+  for (int k = 0; k < 5; k++) {
+    double cos_x = cos(args[k]);
+    double sin_x = sin(args[k]);
+    cos_m[k][0] = 1.0;
+    sin_m[k][0] = 0.0;
+    for (int m = 1; m <= NUTATION_MAX_MULTIPLIER; m++) {
+      cos_m[k][m] = cos_m[k][m - 1] * cos_x - sin_m[k][m - 1] * sin_x;
+      sin_m[k][m] = sin_m[k][m - 1] * cos_x + cos_m[k][m - 1] * sin_x;
     }
-    // Convert results from 0.0001 arcseconds to radians
-    delta_psi = marcsec_to_radians(delta_psi);
-    delta_eps = marcsec_to_radians(delta_eps);
-    // Return complete nutation array
-    return std::array<double, 3>{delta_psi, delta_eps, mean_eps};
+  }
+  // Compute values of Delta-Psi and Delta-Epsilon
+  double delta_psi = 0.0;
+  double delta_eps = 0.0;
+  // Iterate through the IAU 1980 nutation values
+  for (int i = 0; i < n; i++) {
+    const NutationTerm &term = IAU_1980_VALUES[i];
+    // Build the cosine and sine of the nutation argument by adding the
+    // multiples of each fundamental argument
+    double cos_arg = 1.0;
+    double sin_arg = 0.0;
+    for (int k = 0; k < 5; k++) {
+      int m = term.multipliers[k];
+      if (m == 0) {
+        continue;
+      }
+      double cos_k = cos_m[k][m < 0 ? -m : m];
+      double sin_k = m < 0 ? -sin_m[k][-m] : sin_m[k][m];
+      double cos_sum = cos_arg * cos_k - sin_arg * sin_k;
+      sin_arg = sin_arg * cos_k + cos_arg * sin_k;
+      cos_arg = cos_sum;
+    }
+    // Coefficients
+    delta_psi += (term.a + term.b * t) * sin_arg;
+    delta_eps += (term.c + term.d * t) * cos_arg;
+  }
+  // Convert results from 0.0001 arcseconds to radians
+  delta_psi = marcsec_to_radians(delta_psi);
+  delta_eps = marcsec_to_radians(delta_eps);
+  // Return complete nutation array
+  return std::array<double, 3>{delta_psi, delta_eps, mean_eps};
+}
+
+// Calculate the rotation from true of date (TOD) to ICRF
+static Rotation tod_to_icrf(std::array<double, 3> &prec,
+                            std::array<double, 3> &nutn) {
+  double zeta = prec[0], theta = prec[1], zed = prec[2];
+  double d_psi = nutn[0], d_eps = nutn[1], m_eps = nutn[2];
+  double epsilon = d_eps + m_eps;
+  // Nutation (TOD to MOD), then precession (MOD to ICRF)
+  return rotation_x(epsilon)
+    .then(rotation_z(d_psi))
+    .then(rotation_x(-m_eps))
+    .then(rotation_z(zed))
+    .then(rotation_y(-theta))
+    .then(rotation_z(zeta));
+}
+
+// Select the Earth orientation model of the ITRF/ICRF rotation
+void set_earth_model(EarthModel model) {
+  if (model == IAU_2006 && !CIP_MODEL.loaded()) {
+    throw ArcException(
+      "earth_model::set_earth_model exception: IAU 2006/2000A series must be "
+      "loaded before selecting the model");
+  }
+  earth_model = model;
+}
+
+// Get the Earth orientation model of the ITRF/ICRF rotation
+EarthModel get_earth_model() { return earth_model; }
+
+// Calculate the rotation from CIRS to ICRF at TT Julian centuries
+static Rotation cirs_to_icrf(double t) {
+  CipCoordinates cip = CIP_MODEL.coordinates(t);
+  double x = cip.x, y = cip.y;
+  // Matrix moving the celestial pole to the CIP, then the CIO locator
+  double a = 1.0 / (1.0 + sqrt(1.0 - x * x - y * y));
+  Matrix3 pole{ Vector3{ 1.0 - a * x * x, -a * x * y, x },
+                Vector3{ -a * x * y, 1.0 - a * y * y, y },
+                Vector3{ -x, -y, 1.0 - a * (x * x + y * y) } };
+  return rotation_z(cip.s).then(Rotation{ pole, Matrix3{} });
+}
+
+// Calculate the rotation from CIRS to ICRF
+Rotation cirs_to_icrf(DateTime &epoch) {
+  return cirs_to_icrf(epoch.tt().julian_centuries());
+}
+
+// Calculate the rotation from ITRF to ICRF with IAU 2006/2000A (CIO based)
+static Rotation itrf_to_icrf_2006(DateTime &epoch) {
+  // Get finals.all data
+  std::array<double, 7> finals = DATA_FILES.get_finals(epoch.mjd());
+  double pm_x = finals[1], pm_y = finals[2];
+  double t = epoch.tt().julian_centuries();
+  double s_prime = arcsec_to_radians(S_PRIME_RATE * t);
+  // Polar motion (ITRF to TIRS), then the Earth Rotation Angle (TIRS to
+  // CIRS), then the CIP and CIO (CIRS to ICRF)
+  return rotation_x(pm_y)
+    .then(rotation_y(pm_x))
+    .then(rotation_z(-s_prime))
+    .then(rotation_z(-epoch.era_angle(), -ERA_RATE))
+    .then(cirs_to_icrf(t));
+}
+
+// Calculate the rotation from the Earth-fixed ITRF to ICRF
+Rotation itrf_to_icrf(DateTime &epoch) {
+  if (earth_model == IAU_2006) {
+    return itrf_to_icrf_2006(epoch);
+  }
+  // Get finals.all data
+  std::array<double, 7> finals = DATA_FILES.get_finals(epoch.mjd());
+  double pm_x = finals[1], pm_y = finals[2];
+  // Get rotation, precession and nutation values at epoch
+  Vector3 rot = earth_rotation(epoch);
+  double t = epoch.tdb().julian_centuries();
+  std::array<double, 3> prec = earth_precession(t);
+  std::array<double, 3> nutn = earth_nutation(t);
+  double d_psi = nutn[0], epsilon = nutn[1] + nutn[2];
+  // Polar motion (ITRF to PEF), then the apparent sidereal angle, which
+  // advances at the Earth's rotation rate (PEF to TOD)
+  double ast = epoch.gmst_angle() + d_psi * cos(epsilon);
+  return rotation_y(pm_x)
+    .then(rotation_x(pm_y))
+    .then(rotation_z(-ast, -rot.z))
+    .then(tod_to_icrf(prec, nutn));
+}
+
+// Calculate the rotation from TEME to ICRF
+Rotation teme_to_icrf(DateTime &epoch) {
+  // Get precession and nutation values at epoch
+  double t = epoch.tdb().julian_centuries();
+  std::array<double, 3> prec = earth_precession(t);
+  std::array<double, 3> nutn = earth_nutation(t);
+  double d_psi = nutn[0], epsilon = nutn[1] + nutn[2];
+  // Rotate to TOD by the equation of the equinoxes
+  double eq_equinox = d_psi * cos(epsilon);
+  return rotation_z(-eq_equinox).then(tod_to_icrf(prec, nutn));
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <batch_conversion.h>
+#include <earth_model.h>
+#include <parallel.h>
+
+#include <algorithm>
+#include <cstddef>
+
+// Order epochs by time scale, then by time
+static bool epoch_less(const DateTime &a, const DateTime &b) {
+  if (a.scale != b.scale) {
+    return a.scale < b.scale;
+  }
+  if (a.whole_seconds != b.whole_seconds) {
+    return a.whole_seconds < b.whole_seconds;
+  }
+  return a.fraction < b.fraction;
+}
+
+// Check whether two epochs are identical
+static bool epoch_equal(const DateTime &a, const DateTime &b) {
+  return a.scale == b.scale && a.whole_seconds == b.whole_seconds &&
+         a.fraction == b.fraction;
+}
+
+/*
+Compose the ITRF to ICRF rotation once per distinct epoch of the states
+
+@param states States whose epochs to rotate at
+@param threads Number of worker threads
+@param epoch_index Output index into the returned rotations of each state
+@returns (std::vector<rotations::Rotation>) Rotation of each distinct epoch
+*/
+template <class T>
+static std::vector<Rotation> epoch_rotations(std::vector<T> &states,
+                                             unsigned threads,
+                                             std::vector<size_t> &epoch_index) {
+  size_t count = states.size();
+  std::vector<size_t> order(count);
+  for (size_t i = 0; i < count; i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&states](size_t a, size_t b) {
+    return epoch_less(states[a].epoch, states[b].epoch);
+  });
+  std::vector<DateTime> epochs{};
+  epoch_index.resize(count);
+  for (size_t i : order) {
+    if (epochs.size() == 0 || !epoch_equal(epochs.back(), states[i].epoch)) {
+      epochs.push_back(states[i].epoch);
+    }
+    epoch_index[i] = epochs.size() - 1;
+  }
+  std::vector<Rotation> rotations(epochs.size());
+  parallel_for(epochs.size(), threads,
+               [&epochs, &rotations](size_t begin, size_t end) {
+    for (size_t u = begin; u < end; u++) {
+      rotations[u] = itrf_to_icrf(epochs[u]);
+    }
+  });
+  return rotations;
+}
+
+// Rotate ICRF states into ITRF
+std::vector<ITRF> to_itrf(std::vector<ICRF> &states, unsigned threads) {
+  std::vector<size_t> epoch_index;
+  std::vector<Rotation> rotations =
+    epoch_rotations(states, threads, epoch_index);
+  for (Rotation &rotation : rotations) {
+    rotation = rotation.inverse();
+  }
+  std::vector<ITRF> fixed(states.size());
+  parallel_for(states.size(), threads, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      Rotation &rotation = rotations[epoch_index[i]];
+      ICRF &state = states[i];
+      Vector3 pos = rotation.apply(state.position);
+      Vector3 vel = rotation.apply_velocity(state.position, state.velocity);
+      fixed[i] = ITRF{ state.central_body, state.epoch, pos, vel };
+    }
+  });
+  return fixed;
+}
+
+// Rotate ITRF states into ICRF
+std::vector<ICRF> to_icrf(std::vector<ITRF> &states, unsigned threads) {
+  std::vector<size_t> epoch_index;
+  std::vector<Rotation> rotations =
+    epoch_rotations(states, threads, epoch_index);
+  std::vector<ICRF> inertial(states.size());
+  parallel_for(states.size(), threads, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      Rotation &rotation = rotations[epoch_index[i]];
+      ITRF &state = states[i];
+      Vector3 pos = rotation.apply(state.position);
+      Vector3 vel = rotation.apply_velocity(state.position, state.velocity);
+      inertial[i] = ICRF{ state.central_body, state.epoch, pos, vel };
+    }
+  });
+  return inertial;
+}
+
+// Convert ITRF states to geodetic coordinates
+std::vector<Geodetic> to_geodetic(std::vector<ITRF> &states,
+                                  unsigned threads) {
+  std::vector<Geodetic> geodetic(states.size());
+  parallel_for(states.size(), threads, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      geodetic[i] = Geodetic{ states[i] };
+    }
+  });
+  return geodetic;
+}
+
+// Convert ICRF states to geodetic coordinates
+std::vector<Geodetic> to_geodetic(std::vector<ICRF> &states,
+                                  unsigned threads) {
+  std::vector<size_t> epoch_index;
+  std::vector<Rotation> rotations =
+    epoch_rotations(states, threads, epoch_index);
+  std::vector<Geodetic> geodetic(states.size());
+  parallel_for(states.size(), threads, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      // Only the position is needed, which the transpose rotates
+      ICRF &state = states[i];
+      Vector3 pos = rotations[epoch_index[i]].matrix.transpose()
+        .multiply(state.position);
+      Vector3 vel{};
+      ITRF fixed{ state.central_body, state.epoch, pos, vel };
+      geodetic[i] = Geodetic{ fixed };
+    }
+  });
+  return geodetic;
+}
\ No newline at end of file
@@ -16,7 +16,7 @@ Cartesian::Cartesian() {
 }
 
 // Direct constructor
-Cartesian::Cartesian(CelestialBody& body, DateTime& epoch, Vector3& pos,
+Cartesian::Cartesian(CelestialBody body, DateTime& epoch, Vector3& pos,
   Vector3& vel) {
   this->central_body = body;
   this->epoch = epoch;
@@ -33,7 +33,7 @@ Cartesian::Cartesian(KeplerianElements& el) {
     (el.a * (1.0 - pow(el.e, 2.0))) / (1.0 + el.e * cos(el.v)));
   // Compute PQW Velocity vector
   Vector3 v_pqw = Vector3{ sin(-el.v), el.e + cos(el.v), 0.0 }.scale(
-    sqrt(el.central_body.mu / (el.a * pow(1.0 - el.e, 2.0))));
+    sqrt(el.central_body.mu() / (el.a * (1.0 - pow(el.e, 2.0)))));
   // Rotate PQW Position
   Vector3 r_final = r_pqw.rot_z(-el.w).rot_x(-el.i).rot_z(-el.o);
   // Rotate PQW Velocity
@@ -0,0 +1,110 @@
+#include <exceptions.h>
+#include <file_io.h>
+#include <geodetic.h>
+#include <itrf.h>
+#include <math_utils.h>
+
+#include <iomanip>
+#include <sstream>
+
+#include <math.h>
+
+/*
+Geodetic class methods
+*/
+
+// Default constructor
+Geodetic::Geodetic()
+  : central_body{ EARTH }, epoch{}, latitude{ 0.0 }, longitude{ 0.0 },
+    altitude{ 0.0 } {}
+
+// Direct constructor
+Geodetic::Geodetic(CelestialBody body, DateTime &epoch, double latitude,
+                   double longitude, double altitude)
+  : central_body{ body }, epoch{ epoch }, latitude{ latitude },
+    longitude{ longitude }, altitude{ altitude } {}
+
+// Constructor from ITRF
+Geodetic::Geodetic(ITRF &fixed) {
+  this->central_body = fixed.central_body;
+  this->epoch = fixed.epoch;
+  double a = central_body.radius_equator();
+  double f = central_body.flattening();
+  double e2 = f * (2.0 - f);
+  double e4 = e2 * e2;
+  double x = fixed.position.x, y = fixed.position.y, z = fixed.position.z;
+  double rho = sqrt(x * x + y * y);
+  // Vermeille's solution of the quartic for the latitude
+  double p = (rho * rho) / (a * a);
+  double q = (1.0 - e2) * (z * z) / (a * a);
+  double r = (p + q - e4) / 6.0;
+  double s = e4 * p * q / (4.0 * r * r * r);
+  double t = cbrt(1.0 + s + sqrt(s * (2.0 + s)));
+  double u = r * (1.0 + t + 1.0 / t);
+  double v = sqrt(u * u + e4 * q);
+  double w = e2 * (u + v - q) / (2.0 * v);
+  double k = sqrt(u + v + w * w) - w;
+  double d = k * rho / (k + e2);
+  double dz = sqrt(d * d + z * z);
+  this->latitude = 2.0 * atan2(z, d + dz);
+  this->longitude = atan2(y, x);
+  this->altitude = (k + e2 - 1.0) / k * dz;
+}
+
+// Calculate the body-fixed position of these coordinates
+Vector3 Geodetic::to_position() {
+  double a = central_body.radius_equator();
+  double f = central_body.flattening();
+  double e2 = f * (2.0 - f);
+  double sin_lat = sin(latitude);
+  double cos_lat = cos(latitude);
+  // Radius of curvature in the prime vertical
+  double n = a / sqrt(1.0 - e2 * sin_lat * sin_lat);
+  return Vector3{ (n + altitude) * cos_lat * cos(longitude),
+                  (n + altitude) * cos_lat * sin(longitude),
+                  (n * (1.0 - e2) + altitude) * sin_lat };
+}
+
+// Create a text ground track from geodetic coordinates
+std::vector<std::string> format_ground_track(std::vector<Geodetic> &track) {
+  std::vector<std::string> lines;
+  lines.push_back("# Arc ground track");
+  lines.push_back(
+      "# Epoch (UTC), geodetic latitude and longitude (deg), altitude (m)");
+  for (Geodetic &geo : track) {
+    std::stringstream line;
+    line << geo.epoch.to_iso() << std::setprecision(14) << std::scientific
+         << " " << degrees(geo.latitude) << " " << degrees(geo.longitude)
+         << " " << geo.altitude;
+    lines.push_back(line.str());
+  }
+  return lines;
+}
+
+// Write geodetic coordinates to a text ground track
+void write_ground_track(std::vector<Geodetic> &track, const char filename[]) {
+  std::vector<std::string> lines = format_ground_track(track);
+  try {
+    write_lines_to_file(lines, filename);
+  } catch (ArcException err) {
+    std::cout << err.what() << std::endl;
+    std::stringstream msg;
+    msg << "geodetic::write_ground_track exception: Writing ground track to "
+        << "file '" << filename << "' failed";
+    throw ArcException(msg.str());
+  }
+}
+
+/*
+Geodetic operator functions
+*/
+
+// I/O stream
+std::ostream& operator << (std::ostream &out, Geodetic& geo) {
+  out << "[Geodetic]" << std::endl << " Central Body: " << geo.central_body
+      << std::endl << " Epoch: " << geo.epoch << std::endl
+      << " Latitude: " << geo.latitude << std::endl
+      << " Longitude: " << geo.longitude << std::endl
+      << " Altitude: " << geo.altitude;
+  return out;
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
-#include <data_files.h>
 #include <earth_model.h>
 #include <icrf.h>
 #include <itrf.h>
+#include <teme.h>
 
 /*
 ICRF class methods
@@ -23,7 +23,7 @@ system
 @param pos (vectors::Vector3) position vector of the state in meters
 @param vel (vectors::Vector3) velocity vector of the state in meters per second
 */
-ICRF::ICRF(CelestialBody& body, DateTime& epoch, Vector3& pos, Vector3& vel)
+ICRF::ICRF(CelestialBody body, DateTime& epoch, Vector3& pos, Vector3& vel)
   : Cartesian{ body, epoch, pos, vel } {};
 
 /*
@@ -34,34 +34,28 @@ Rotates an ITRF (Earth-centered, Earth-fixed) state into Earth-centered ICRF
 @param fixed ITRF state to rotate into ICRF
 */
 ICRF::ICRF(ITRF& fixed) {
-  // Get finals.all data
-  std::array<double, 7> finals = DATA_FILES.get_finals(fixed.epoch.mjd());
-  double pm_x = finals[1], pm_y = finals[2];
-  // Get rotation, precession and nutation values at epoch
-  Vector3 rot = earth_rotation(fixed.epoch);
-  std::array<double, 3> prec = earth_precession(fixed.epoch);
-  std::array<double, 3> nutn = earth_nutation(fixed.epoch);
-  double zeta = prec[0], theta = prec[1], zed = prec[2];
-  double d_psi = nutn[0], d_eps = nutn[1], m_eps = nutn[2];
-  double epsilon = d_eps + m_eps;
-  // Rotate to PEF
-  Vector3 r_pef = fixed.position.rot_y(pm_x).rot_x(pm_y);
-  Vector3 v_pef = fixed.velocity.rot_y(pm_x).rot_x(pm_y);
-  // Rotate to TOD
-  double ast = fixed.epoch.gmst_angle() + d_psi * cos(epsilon);
-  Vector3 r_tod = r_pef.rot_z(-ast);
-  Vector3 v_arg = rot.cross(r_pef);
-  Vector3 v_tod = v_pef.add(v_arg).rot_z(-ast);
-  // Rotate to MOD
-  Vector3 r_mod = r_tod.rot_x(epsilon).rot_z(d_psi).rot_x(-m_eps);
-  Vector3 v_mod = v_tod.rot_x(epsilon).rot_z(d_psi).rot_x(-m_eps);
-  // Rotate to ICRF
-  Vector3 r_icrf = r_mod.rot_z(zed).rot_y(-theta).rot_z(zeta);
-  Vector3 v_icrf = v_mod.rot_z(zed).rot_y(-theta).rot_z(zeta);
+  // Compose the full rotation once for position and velocity
+  Rotation rotation = itrf_to_icrf(fixed.epoch);
   this->central_body = fixed.central_body;
   this->epoch = fixed.epoch;
-  this->position = r_icrf;
-  this->velocity = v_icrf;
+  this->position = rotation.apply(fixed.position);
+  this->velocity = rotation.apply_velocity(fixed.position, fixed.velocity);
+}
+
+/*
+Constructor from TEME
+
+Rotates a TEME (SGP4 output) state into ICRF
+
+@param teme TEME state to rotate into ICRF
+*/
+ICRF::ICRF(TEME& teme) {
+  // Compose the full rotation once for position and velocity
+  Rotation rotation = teme_to_icrf(teme.epoch);
+  this->central_body = teme.central_body;
+  this->epoch = teme.epoch;
+  this->position = rotation.apply(teme.position);
+  this->velocity = rotation.apply(teme.velocity);
 }
 
 /*
@@ -80,7 +74,7 @@ Convert position/velocity vectors into the sun-centered ICRF frame
 */
 ICRF ICRF::to_solar() {
   // If this state is not already heliocentric
-  if (central_body.id != 10) {
+  if (central_body.id() != 10) {
     // This call will be recursive until we find a solar state
     ICRF body_icrf = central_body.propagate(epoch).to_solar();
     // Add the body's heliocentric state to this state and return
@@ -100,11 +94,11 @@ celestial body's position
 
 @param body Celestial body around which to center the new state
 */
-ICRF ICRF::change_central_body(CelestialBody& body) {
+ICRF ICRF::change_central_body(CelestialBody body) {
   // If the requested body does differ
-  if (central_body.id != body.id) {
+  if (central_body.id() != body.id()) {
     // If the requested body is the Sun
-    if (body.id == 10) {
+    if (body.id() == 10) {
       return to_solar();
     }
     // Get both states in heliocentric ICRF
@@ -1,9 +1,17 @@
 #include <cartesian.h>
+#include <ephemeris.h>
 #include <keplerian.h>
 #include <math_utils.h>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <vector>
+
+// Number of Danby corrections applied by the batch Kepler solver
+const int KEPLER_BATCH_ITERATIONS = 4;
+
+// Tolerance on the change in anomaly used by the scalar Kepler solver
+const double KEPLER_TOLERANCE = 1e-15;
 
 /*
 Keplerian elements methods
@@ -22,7 +30,7 @@ KeplerianElements::KeplerianElements() {
 }
 
 // Direct constructor
-KeplerianElements::KeplerianElements(CelestialBody &body, DateTime epoch,
+KeplerianElements::KeplerianElements(CelestialBody body, DateTime epoch,
   double a, double e, double i, double o,
   double w, double v) {
   this->central_body = body;
@@ -44,7 +52,7 @@ KeplerianElements::KeplerianElements(Cartesian &vector) {
   this->central_body = vector.central_body;
   this->epoch = vector.epoch;
   // Calculate Semi-major axis
-  double mu = vector.central_body.mu;
+  double mu = vector.central_body.mu();
   double energy = pow(v_mag, 2.0) / 2.0 - mu / r_mag;
   double a = -(mu / (2.0 * energy));
   this->a = a;
@@ -106,11 +114,31 @@ void KeplerianElements::print() {
   std::cout << " V: " << v * (180.0 / M_PI) << std::endl;
 }
 
-// Compute mean motion
+// Compute mean motion (valid for elliptic and hyperbolic orbits)
 double KeplerianElements::mean_motion() {
-  return sqrt(central_body.mu / pow(a, 3.0));
+  return sqrt(central_body.mu() / pow(fabs(a), 3.0));
+}
+
+// Compute the mean anomaly from the true anomaly
+double KeplerianElements::mean_anomaly() {
+  if (e < 1.0) {
+    double ecc_anom = atan2(sqrt(1.0 - e * e) * sin(v), e + cos(v));
+    return ecc_anom - e * sin(ecc_anom);
+  }
+  double hyp_anom = 2.0 * atanh(sqrt((e - 1.0) / (e + 1.0)) * tan(v / 2.0));
+  return e * sinh(hyp_anom) - hyp_anom;
 }
 
+// Compute the true anomaly corresponding to an eccentric anomaly
+double KeplerianElements::true_anomaly(double ecc_anom) {
+  if (e < 1.0) {
+    double true_anom =
+      atan2(sqrt(1.0 - e * e) * sin(ecc_anom), cos(ecc_anom) - e);
+    // Keep elliptic true anomalies in the range [0, 2pi)
+    return true_anom < 0.0 ? true_anom + 2.0 * M_PI : true_anom;
+  }
+  return 2.0 * atan(sqrt((e + 1.0) / (e - 1.0)) * tanh(ecc_anom / 2.0));
+}
 
 // Propagate the True Anomaly of the elements to a specified epoch
 // Ref: Montenbruck, O., & Gill, E. (2012). Prediction of Unperturbed Satellite Orbits.
@@ -118,36 +146,160 @@ double KeplerianElements::mean_motion() {
 KeplerianElements KeplerianElements::propagate_to(DateTime &t) {
   // Get delta between the requested time and the initial state epoch
   double delta = t.difference(epoch);
-  // Calculate mean motion
-  double n = mean_motion();
-  // Make an initial estimate of the Eccentric Anomaly and improve it using True
-  // Anomaly
-  double ecc_anom = acos((e + cos(v)) / (1.0 + e * cos(v)));
-  ecc_anom = match_half_plane(ecc_anom, v);
-  // Make an initial estimate of the Mean Anomaly and improve it using Eccentric
-  // Anomaly
-  double mean_anom = ecc_anom - e * sin(ecc_anom);
-  mean_anom = match_half_plane(mean_anom, ecc_anom);
-  mean_anom = fmod(mean_anom + n * delta, 2.0 * M_PI);
-  ecc_anom = mean_anom;
-  // Set up iteration variables
-  int iter = 0;
-  double ea_temp;
-  // Iterate on the Eccentric Anomaly to improve the estimate
-  while (iter < 32) {
-    ea_temp = mean_anom + e * sin(ecc_anom);
-    if (fabs(ea_temp - ecc_anom) < 1e-12) {
+  // Advance the mean anomaly and solve for the final eccentric anomaly
+  double mean_anom = mean_anomaly() + mean_motion() * delta;
+  double ecc_anom = solve_kepler(mean_anom, e);
+  // Create new Keplerian state
+  return KeplerianElements{ central_body, t, a, e, i, o, w,
+                            true_anomaly(ecc_anom) };
+}
+
+/*
+Kepler's equation solvers
+*/
+
+// Solve Kepler's equation for the eccentric anomaly
+double solve_kepler(double mean_anom, double e) {
+  if (e < 1.0) {
+    // Reduce the mean anomaly to [-pi, pi] and solve there, the starting
+    // value needs the sign of sin(M)
+    double m = remainder(mean_anom, 2.0 * M_PI);
+    double ecc_anom = m + (m < 0.0 ? -0.85 : 0.85) * e;
+    for (int iter = 0; iter < 16; iter++) {
+      double e_sin = e * sin(ecc_anom);
+      double e_cos = e * cos(ecc_anom);
+      double f = ecc_anom - e_sin - m;
+      double f_1 = 1.0 - e_cos;
+      double d_1 = -f / f_1;
+      double d_2 = -f / (f_1 + 0.5 * d_1 * e_sin);
+      double d_3 = -f / (f_1 + 0.5 * d_2 * e_sin + d_2 * d_2 * e_cos / 6.0);
+      ecc_anom += d_3;
+      if (fabs(d_3) < KEPLER_TOLERANCE) {
+        break;
+      }
+    }
+    // Restore the revolutions removed by the reduction
+    return ecc_anom + (mean_anom - m);
+  }
+  // Hyperbolic anomaly, starting from the asymptotic solution
+  double hyp_anom = (mean_anom < 0.0 ? -1.0 : 1.0) *
+                    log(2.0 * fabs(mean_anom) / e + 1.8);
+  for (int iter = 0; iter < 64; iter++) {
+    double e_sinh = e * sinh(hyp_anom);
+    double e_cosh = e * cosh(hyp_anom);
+    double f = e_sinh - hyp_anom - mean_anom;
+    double f_1 = e_cosh - 1.0;
+    double d_1 = -f / f_1;
+    double d_2 = -f / (f_1 + 0.5 * d_1 * e_sinh);
+    double d_3 = -f / (f_1 + 0.5 * d_2 * e_sinh + d_2 * d_2 * e_cosh / 6.0);
+    hyp_anom += d_3;
+    if (fabs(d_3) < KEPLER_TOLERANCE * fmax(1.0, fabs(hyp_anom))) {
       break;
     }
-    iter += 1;
-    ecc_anom = ea_temp;
   }
-  // Make an inital estimate of final True Anomaly and improve it using the
-  // final Eccentric anomaly
-  double v_final = acos((cos(ecc_anom) - e) / (1.0 - e * cos(ecc_anom)));
-  v_final = match_half_plane(v_final, ecc_anom);
-  // Create new Keplerian state
-  return KeplerianElements{ central_body, t, a, e, i, o, w, v_final };
+  return hyp_anom;
+}
+
+// Solve Kepler's equation for a batch of elliptic orbits
+void solve_kepler_batch(size_t n, const double mean_anom[], const double e[],
+                        double ecc_anom[]) {
+  // Reduce the mean anomalies once and set the starting values
+  std::vector<double> reduced(n);
+  for (size_t k = 0; k < n; k++) {
+    double m = remainder(mean_anom[k], 2.0 * M_PI);
+    reduced[k] = m;
+    ecc_anom[k] = m + copysign(0.85, m) * e[k];
+  }
+  // Apply a fixed number of corrections to every element
+  for (int iter = 0; iter < KEPLER_BATCH_ITERATIONS; iter++) {
+    for (size_t k = 0; k < n; k++) {
+      double m = reduced[k];
+      double e_sin = e[k] * sin(ecc_anom[k]);
+      double e_cos = e[k] * cos(ecc_anom[k]);
+      double f = ecc_anom[k] - e_sin - m;
+      double f_1 = 1.0 - e_cos;
+      double d_1 = -f / f_1;
+      double d_2 = -f / (f_1 + 0.5 * d_1 * e_sin);
+      ecc_anom[k] += -f / (f_1 + 0.5 * d_2 * e_sin + d_2 * d_2 * e_cos / 6.0);
+    }
+  }
+}
+
+/*
+Universal variable propagation
+*/
+
+// Stumpff functions c2(psi) and c3(psi)
+static void stumpff(double psi, double &c_2, double &c_3) {
+  if (psi > 1e-6) {
+    double sqrt_psi = sqrt(psi);
+    c_2 = (1.0 - cos(sqrt_psi)) / psi;
+    c_3 = (sqrt_psi - sin(sqrt_psi)) / (psi * sqrt_psi);
+  } else if (psi < -1e-6) {
+    double sqrt_psi = sqrt(-psi);
+    c_2 = (1.0 - cosh(sqrt_psi)) / psi;
+    c_3 = (sinh(sqrt_psi) - sqrt_psi) / (-psi * sqrt_psi);
+  } else {
+    // Series expansions near the parabolic case
+    c_2 = 0.5 - psi / 24.0 + psi * psi / 720.0;
+    c_3 = 1.0 / 6.0 - psi / 120.0 + psi * psi / 5040.0;
+  }
+}
+
+// Propagate a two-body state using universal variables
+void propagate_universal(double mu, Vector3 &r_0, Vector3 &v_0, double dt,
+                         Vector3 &r, Vector3 &v) {
+  double sqrt_mu = sqrt(mu);
+  double r_0_mag = r_0.mag();
+  double rv_0 = r_0.dot(v_0) / sqrt_mu;
+  // Reciprocal of the semi-major axis
+  double alpha = 2.0 / r_0_mag - v_0.dot(v_0) / mu;
+  // Starting value of the universal variable
+  double chi;
+  if (alpha > 1e-12) {
+    // Whole revolutions do not change the state
+    double period = 2.0 * M_PI / (sqrt_mu * pow(alpha, 1.5));
+    dt = fmod(dt, period);
+    chi = sqrt_mu * dt * alpha;
+  } else if (alpha < -1e-12) {
+    double a = 1.0 / alpha;
+    double sign = dt < 0.0 ? -1.0 : 1.0;
+    chi = sign * sqrt(-a) *
+          log(-2.0 * mu * alpha * dt /
+              (r_0.dot(v_0) + sign * sqrt(-mu * a) * (1.0 - r_0_mag * alpha)));
+  } else {
+    chi = sqrt_mu * dt / r_0_mag;
+  }
+  // Newton iteration on the universal form of Kepler's equation
+  double psi = 0.0, c_2 = 0.5, c_3 = 1.0 / 6.0, r_mag = r_0_mag;
+  for (int iter = 0; iter < 64; iter++) {
+    psi = chi * chi * alpha;
+    stumpff(psi, c_2, c_3);
+    double chi_2 = chi * chi;
+    double t_n = chi_2 * chi * c_3 + rv_0 * chi_2 * c_2 +
+                 r_0_mag * chi * (1.0 - psi * c_3);
+    r_mag = chi_2 * c_2 + rv_0 * chi * (1.0 - psi * c_3) +
+            r_0_mag * (1.0 - psi * c_2);
+    double delta = (sqrt_mu * dt - t_n) / r_mag;
+    chi += delta;
+    if (fabs(delta) < 1e-12 * fmax(1.0, fabs(chi))) {
+      break;
+    }
+  }
+  // Lagrange coefficients
+  double chi_2 = chi * chi;
+  psi = chi_2 * alpha;
+  stumpff(psi, c_2, c_3);
+  r_mag = chi_2 * c_2 + rv_0 * chi * (1.0 - psi * c_3) +
+          r_0_mag * (1.0 - psi * c_2);
+  double f = 1.0 - chi_2 * c_2 / r_0_mag;
+  double g = dt - chi_2 * chi * c_3 / sqrt_mu;
+  double f_dot = sqrt_mu / (r_mag * r_0_mag) * chi * (psi * c_3 - 1.0);
+  double g_dot = 1.0 - chi_2 * c_2 / r_mag;
+  Vector3 v_g = v_0.scale(g);
+  Vector3 v_g_dot = v_0.scale(g_dot);
+  r = r_0.scale(f).add(v_g);
+  v = r_0.scale(f_dot).add(v_g_dot);
 }
 
 /*
@@ -163,4 +315,40 @@ KeplerianPropagator::KeplerianPropagator(KeplerianElements state) {
 ICRF KeplerianPropagator::propagate(DateTime &epoch) {
   KeplerianElements result = initial_state.propagate_to(epoch);
   return ICRF {result};
+}
+
+// Create an Ephemeris by propagating over an interval, solving Kepler's
+// equation for every epoch as a single batch
+Ephemeris KeplerianPropagator::step(DateTime &start, DateTime &stop,
+                                    double step) {
+  // Hyperbolic orbits are propagated one epoch at a time
+  if (initial_state.e >= 1.0) {
+    return Propagator::step(start, stop, step);
+  }
+  // Mean anomaly at every requested epoch
+  std::vector<DateTime> epochs{};
+  std::vector<double> mean_anom{};
+  double mean_anom_0 = initial_state.mean_anomaly();
+  double n = initial_state.mean_motion();
+  DateTime t = start;
+  while (stop.difference(t) >= 0.0) {
+    epochs.push_back(t);
+    mean_anom.push_back(mean_anom_0 + n * t.difference(initial_state.epoch));
+    t = t.increment(step);
+  }
+  std::vector<double> e(epochs.size(), initial_state.e);
+  std::vector<double> ecc_anom(epochs.size());
+  solve_kepler_batch(epochs.size(), mean_anom.data(), e.data(),
+                     ecc_anom.data());
+  // Convert each solution to an ICRF state
+  Ephemeris ephem{};
+  ephem.reserve(epochs.size());
+  for (size_t k = 0; k < epochs.size(); k++) {
+    KeplerianElements el = initial_state;
+    el.epoch = epochs[k];
+    el.v = initial_state.true_anomaly(ecc_anom[k]);
+    ICRF state{ el };
+    ephem.push_back(state);
+  }
+  return ephem;
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include <earth_model.h>
+#include <icrf.h>
+#include <teme.h>
+
+/*
+TEME class methods
+*/
+
+// Default constructor (call base class)
+TEME::TEME(){};
+
+// Direct constructor
+TEME::TEME(CelestialBody body, DateTime &epoch, Vector3 &pos, Vector3 &vel)
+    : Cartesian{body, epoch, pos, vel} {};
+
+// Constructor from ICRF
+TEME::TEME(ICRF &inertial) {
+  // Invert the composed TEME to ICRF rotation (a transpose)
+  Rotation rotation = teme_to_icrf(inertial.epoch).inverse();
+  this->central_body = inertial.central_body;
+  this->epoch = inertial.epoch;
+  this->position = rotation.apply(inertial.position);
+  this->velocity = rotation.apply(inertial.velocity);
+}
+
+/*
+TEME operator functions
+*/
+
+// I/O stream
+std::ostream &operator<<(std::ostream &out, TEME &teme) {
+  out << "[TEME]" << std::endl << " Central Body: " << teme.central_body << std::endl
+      << " Epoch: " << teme.epoch << std::endl << " Position: " << teme.position << std::endl
+      << " Velocity: " << teme.velocity;
+  return out;
+}
@@ -0,0 +1,166 @@
+#include <exceptions.h>
+#include <file_io.h>
+#include <tle.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+// Minutes per day
+const double MINUTES_PER_DAY = 1440.0;
+
+// Unix timestamp of 2000 Jan 1 00:00:00 UTC
+const double UNIX_2000 = 946684800.0;
+
+// Julian date of 2000 Jan 1 00:00:00 UTC
+const double JD_2000 = 2451544.5;
+
+// Julian date of 1950 Jan 0.0 UTC
+const double JD_1950 = 2433281.5;
+
+// Remove trailing whitespace and carriage returns from a line
+static std::string trim_line(std::string line) {
+  size_t end = line.find_last_not_of(" \t\r\n");
+  return end == std::string::npos ? "" : line.substr(0, end + 1);
+}
+
+// Parse a fixed-width numeric field
+static double parse_field(std::string &line, size_t start, size_t length,
+                          const char field[]) {
+  std::string text = line.substr(start, length);
+  const char *begin = text.c_str();
+  char *end;
+  double value = strtod(begin, &end);
+  // Allow trailing padding, but require at least one digit
+  if (end == begin || text.find_first_not_of(" ", end - begin) != std::string::npos) {
+    std::stringstream msg;
+    msg << "TwoLineElement exception: Unable to parse " << field << " from '"
+        << text << "'";
+    throw ArcException(msg.str());
+  }
+  return value;
+}
+
+// Parse a fixed-width field with an assumed leading decimal point and a
+// trailing power of ten exponent (e.g. " 28098-4" is 0.28098e-4)
+static double parse_exponent_field(std::string &line, size_t start,
+                                   const char field[]) {
+  std::string text = line.substr(start, 8);
+  double sign = text[0] == '-' ? -1.0 : 1.0;
+  std::string mantissa = "0." + text.substr(1, 5);
+  std::string exponent = text.substr(6, 2);
+  double m = parse_field(mantissa, 0, mantissa.size(), field);
+  double e = parse_field(exponent, 0, exponent.size(), field);
+  return sign * m * pow(10.0, e);
+}
+
+/*
+TwoLineElement class methods
+*/
+
+// Default constructor
+TwoLineElement::TwoLineElement() {
+  this->name = "";
+  this->satnum = "";
+  this->epoch = DateTime{};
+  this->epoch_ds50 = 0.0;
+  this->ndot = 0.0;
+  this->nddot = 0.0;
+  this->bstar = 0.0;
+  this->inclination = 0.0;
+  this->raan = 0.0;
+  this->eccentricity = 0.0;
+  this->arg_perigee = 0.0;
+  this->mean_anomaly = 0.0;
+  this->mean_motion = 0.0;
+}
+
+// Constructor from the two element lines
+TwoLineElement::TwoLineElement(std::string line_1, std::string line_2) {
+  line_1 = trim_line(line_1);
+  line_2 = trim_line(line_2);
+  if (line_1.size() < 61 || line_1[0] != '1' || line_2.size() < 63 ||
+      line_2[0] != '2') {
+    std::stringstream msg;
+    msg << "TwoLineElement exception: Malformed element set" << std::endl
+        << " " << line_1 << std::endl << " " << line_2;
+    throw ArcException(msg.str());
+  }
+  this->name = "";
+  this->satnum = line_1.substr(2, 5);
+  // Epoch, as a two-digit year (57-99 are 1957-1999) and fractional day of year
+  int year = (int)parse_field(line_1, 18, 2, "epoch year");
+  year += year < 57 ? 2000 : 1900;
+  double day = parse_field(line_1, 20, 12, "epoch day");
+  double jd_jan_1 = 367.0 * year - floor(7.0 * year / 4.0) + 30.0 + 1.0 + 1721013.5;
+  this->epoch_ds50 = (jd_jan_1 - JD_1950) + (day - 1.0);
+  double unix_epoch = ((jd_jan_1 - JD_2000) + (day - 1.0)) * 86400.0 + UNIX_2000;
+  this->epoch = DateTime{unix_epoch - UNIX_J2000, UTC};
+  // Mean motion derivatives and drag term
+  double rad_per_rev = 2.0 * M_PI;
+  this->ndot = parse_field(line_1, 33, 10, "mean motion derivative") * rad_per_rev /
+               (MINUTES_PER_DAY * MINUTES_PER_DAY);
+  this->nddot = parse_exponent_field(line_1, 44, "mean motion second derivative") *
+                rad_per_rev / pow(MINUTES_PER_DAY, 3);
+  this->bstar = parse_exponent_field(line_1, 53, "drag term");
+  // Mean elements
+  double deg_to_rad = M_PI / 180.0;
+  this->inclination = parse_field(line_2, 8, 8, "inclination") * deg_to_rad;
+  this->raan = parse_field(line_2, 17, 8, "right ascension") * deg_to_rad;
+  std::string ecc = "0." + line_2.substr(26, 7);
+  this->eccentricity = parse_field(ecc, 0, ecc.size(), "eccentricity");
+  this->arg_perigee = parse_field(line_2, 34, 8, "argument of perigee") * deg_to_rad;
+  this->mean_anomaly = parse_field(line_2, 43, 8, "mean anomaly") * deg_to_rad;
+  this->mean_motion = parse_field(line_2, 52, 11, "mean motion") * rad_per_rev /
+                      MINUTES_PER_DAY;
+}
+
+// Read a file of two-line element sets
+std::vector<TwoLineElement> read_tle_file(const char filepath[]) {
+  std::vector<std::string> lines = read_lines_from_file(filepath);
+  std::vector<TwoLineElement> elements{};
+  std::string title = "";
+  for (size_t i = 0; i < lines.size(); i++) {
+    std::string line = trim_line(lines[i]);
+    if (line.empty()) {
+      continue;
+    }
+    if (line[0] == '1' && line.size() >= 61 && i + 1 < lines.size()) {
+      TwoLineElement tle{line, lines[i + 1]};
+      tle.name = title;
+      elements.push_back(tle);
+      title = "";
+      i++;
+    } else {
+      // Title line of the three-line format (optionally prefixed with "0 ")
+      title = line.size() > 2 && line.substr(0, 2) == "0 " ? line.substr(2) : line;
+    }
+  }
+  if (elements.empty()) {
+    std::stringstream msg;
+    msg << "read_tle_file exception: No element sets found in '" << filepath
+        << "'";
+    throw ArcException(msg.str());
+  }
+  return elements;
+}
+
+/*
+TwoLineElement operator functions
+*/
+
+// I/O stream
+std::ostream &operator<<(std::ostream &out, TwoLineElement &tle) {
+  out << "[TwoLineElement]" << std::endl << " Catalog Number: " << tle.satnum
+      << std::endl << " Epoch: " << tle.epoch << std::endl
+      << " Inclination: " << tle.inclination << std::endl
+      << " RAAN: " << tle.raan << std::endl
+      << " Eccentricity: " << tle.eccentricity << std::endl
+      << " Argument of Perigee: " << tle.arg_perigee << std::endl
+      << " Mean Anomaly: " << tle.mean_anomaly << std::endl
+      << " Mean Motion: " << tle.mean_motion << std::endl
+      << " B*: " << tle.bstar;
+  return out;
+}
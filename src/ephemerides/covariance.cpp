@@ -0,0 +1,95 @@
+#include <covariance.h>
+#include <exceptions.h>
+#include <file_io.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/*
+CovarianceEphemeris class methods
+*/
+
+// Default constructor
+CovarianceEphemeris::CovarianceEphemeris() {
+  this->epochs = std::vector<DateTime>{};
+  this->covariances = std::vector<Matrix6>{};
+  this->epoch = DateTime{};
+  this->central_body = SUN;
+}
+
+// Direct constructor
+CovarianceEphemeris::CovarianceEphemeris(std::vector<DateTime> &epochs,
+                                         std::vector<Matrix6> &covariances,
+                                         CelestialBody central_body) {
+  this->epochs = epochs;
+  this->covariances = covariances;
+  this->epoch = epochs.size() > 0 ? epochs[0] : DateTime{};
+  this->central_body = central_body;
+}
+
+// Create ASCII covariance ephemeris in STK format (.e)
+std::vector<std::string> CovarianceEphemeris::format_stk() {
+  // Create the vector of lines and write the header
+  std::vector<std::string> lines;
+  lines.push_back(std::string{"stk.v.11.0"});
+  lines.push_back(std::string{"# WrittenBy Arc"});
+  lines.push_back(std::string{"BEGIN Ephemeris"});
+
+  // Number of covariance points line
+  std::stringstream n_points;
+  n_points << "NumberOfCovariancePoints " << covariances.size();
+  lines.push_back(n_points.str());
+
+  // Scenario epoch line
+  char epoch_buffer[CIVIL_BUFFER_SIZE];
+  epoch.write_civil(STK_DATE, epoch_buffer);
+  std::stringstream epoch_str;
+  epoch_str << "ScenarioEpoch " << epoch_buffer;
+  lines.push_back(epoch_str.str());
+
+  // Central body line
+  std::stringstream body_str;
+  body_str << "CentralBody " << central_body.get_name();
+  lines.push_back(body_str.str());
+
+  // Build the covariance points
+  lines.push_back("CoordinateSystem ICRF");
+  lines.push_back("CovarianceFormat LowerTriangular");
+  lines.push_back("CovarianceTimePosVel");
+
+  for (size_t i = 0; i < covariances.size(); i++) {
+    // Calculate time since epoch
+    double tplus = epochs[i].difference(epoch);
+
+    // Stream t+ and the lower triangle of the covariance into each line
+    std::stringstream point_line;
+    point_line << std::setprecision(14) << std::scientific << tplus;
+    for (int row = 0; row < 6; row++) {
+      for (int col = 0; col <= row; col++) {
+        point_line << " " << covariances[i].elements[row][col];
+      }
+    }
+
+    // Add the line to the lines vector
+    lines.push_back(point_line.str());
+  }
+
+  lines.push_back("END Ephemeris");
+  return lines;
+}
+
+// Write covariance ephemeris to file using STK format
+void CovarianceEphemeris::write_stk(const char filename[]) {
+  try {
+    std::vector<std::string> lines = format_stk();
+    write_lines_to_file(lines, filename);
+  } catch (ArcException err) {
+    std::cout << err.what() << std::endl;
+    std::stringstream msg;
+    msg << "CovarianceEphemeris::write_stk exception: Writing covariance to "
+           "file '"
+        << filename << "' failed";
+    throw ArcException(msg.str());
+  }
+}
\ No newline at end of file
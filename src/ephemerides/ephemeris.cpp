@@ -1,17 +1,23 @@
+#include <batch_conversion.h>
 #include <ephemeris.h>
 #include <exceptions.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 
+// Number of arena columns (epoch offset, then the six state components)
+static const size_t EPHEMERIS_COLUMNS = 7;
+
 /*
 Standalone ephemeris file parsers
 */
 
 // Parse ephemeris from STK format
 void parse_stk(std::vector<std::string> &lines, Ephemeris &ephem) {
-  ephem.states = std::vector<ICRF>{};
+  ephem.resize(0);
   bool ephem_section = false;
   for (std::string line : lines) {
     // Check for epoch
@@ -19,7 +25,7 @@ void parse_stk(std::vector<std::string> &lines, Ephemeris &ephem) {
       std::string datestr =
           line.substr(line.find("ScenarioEpoch") + 14, line.size() - 1);
       if (datestr.size() > 0) {
-        ephem.epoch = DateTime{datestr, std::string{"%d %b %Y %H:%M:%S"}};
+        ephem.epoch = DateTime{datestr.c_str(), datestr.size(), STK_DATE};
       }
       // Check for central body
     } else if (line.find("CentralBody") != std::string::npos) {
@@ -28,16 +34,19 @@ void parse_stk(std::vector<std::string> &lines, Ephemeris &ephem) {
       ephem.central_body = get_body_by_name(bodystr);
     } else if (line.find("END Ephemeris") != std::string::npos) {
       ephem_section = false;
+    } else if (line.find("NumberOfEphemerisPoints") != std::string::npos) {
+      // Allocate the columns once when the file states its length
+      long points = atol(line.c_str() + line.find("NumberOfEphemerisPoints") +
+                         23);
+      if (points > 0) {
+        ephem.reserve((size_t)points);
+      }
     } else if (ephem_section == true) {
       // Parse a state
-      float tplus, x, y, z, vx, vy, vz;
-      sscanf(line.c_str(), "%f %f %f %f %f %f %f", &tplus, &x, &y, &z, &vx, &vy,
-             &vz);
-      DateTime new_epoch = ephem.epoch.increment(tplus);
-      Vector3 new_pos{x, y, z};
-      Vector3 new_vel{vx, vy, vz};
-      ephem.states.push_back(
-          ICRF{ephem.central_body, new_epoch, new_pos, new_vel});
+      double tplus, x, y, z, vx, vy, vz;
+      sscanf(line.c_str(), "%lf %lf %lf %lf %lf %lf %lf", &tplus, &x, &y, &z,
+             &vx, &vy, &vz);
+      ephem.push_back(tplus, Vector3{x, y, z}, Vector3{vx, vy, vz});
     } else if (line.find("EphemerisTimePosVel") != std::string::npos) {
       // Begin parsing states
       ephem_section = true;
@@ -45,22 +54,38 @@ void parse_stk(std::vector<std::string> &lines, Ephemeris &ephem) {
   }
 }
 
+// Number of states from start to stop (inclusive) at a fixed step
+size_t step_count(DateTime &start, DateTime &stop, double step) {
+  double span = stop.difference(start);
+  if (span < 0.0 || step <= 0.0) {
+    return 0;
+  }
+  return (size_t)floor(span / step) + 1;
+}
+
 /*
 Ephemeris class methods
 */
 
 // Default constructor
-Ephemeris::Ephemeris() {
-  this->states = std::vector<ICRF>{};
-  this->epoch = DateTime{};
-  this->central_body = SUN;
+Ephemeris::Ephemeris()
+  : epoch{}, central_body{ SUN }, arena{}, count{ 0 }, capacity{ 0 } {}
+
+// Constructor with reserved storage
+Ephemeris::Ephemeris(CelestialBody body, DateTime &epoch, size_t capacity)
+  : epoch{ epoch }, central_body{ body }, arena{}, count{ 0 },
+    capacity{ 0 } {
+  reserve(capacity);
 }
 
 // Direct constructor
-Ephemeris::Ephemeris(std::vector<ICRF> &states) {
-  this->states = states;
-  this->epoch = states[0].epoch;
-  this->central_body = states[0].central_body;
+Ephemeris::Ephemeris(std::vector<ICRF> &states)
+  : epoch{ states[0].epoch }, central_body{ states[0].central_body },
+    arena{}, count{ 0 }, capacity{ 0 } {
+  reserve(states.size());
+  for (ICRF &state : states) {
+    push_back(state);
+  }
 }
 
 // Constructor using file path
@@ -68,14 +93,20 @@ Ephemeris::Ephemeris(const char filepath[]) {
   // Set defaults
   this->central_body = SUN;
   this->epoch = DateTime{};
-  this->states = std::vector<ICRF>{};
+  this->count = 0;
+  this->capacity = 0;
   try {
     // Read in the lines from the file (will throw on read error)
     std::vector<std::string> lines = read_lines_from_file(filepath);
     // If the file exists and we got lines back
     if (lines.size() > 0) {
+      // Skip any blank lines before the header
+      size_t first = 0;
+      while (first < lines.size() - 1 && lines[first].empty()) {
+        first++;
+      }
       // If this appears to be an STK ephemeris file
-      if (lines[0].find("stk") > 0) {
+      if (lines[first].find("stk") == 0) {
         parse_stk(lines, *this);
       }
     } else {
@@ -93,39 +124,141 @@ Ephemeris::Ephemeris(const char filepath[]) {
   }
 }
 
+// Get the number of states in the ephemeris
+size_t Ephemeris::size() { return count; }
+
+// Reserve storage for a number of states
+void Ephemeris::reserve(size_t capacity) {
+  if (capacity <= this->capacity) {
+    return;
+  }
+  // Move each column to its offset in the larger arena
+  std::vector<double> grown(EPHEMERIS_COLUMNS * capacity);
+  for (size_t c = 0; c < EPHEMERIS_COLUMNS; c++) {
+    std::copy(arena.begin() + c * this->capacity,
+              arena.begin() + c * this->capacity + count,
+              grown.begin() + c * capacity);
+  }
+  arena.swap(grown);
+  this->capacity = capacity;
+}
+
+// Resize the ephemeris, zeroing any added states
+void Ephemeris::resize(size_t count) {
+  reserve(count);
+  for (size_t c = 0; c < EPHEMERIS_COLUMNS; c++) {
+    double *column = arena.data() + c * capacity;
+    std::fill(column + std::min(count, this->count), column + count, 0.0);
+  }
+  this->count = count;
+}
+
+// Append a state
+void Ephemeris::push_back(double offset, const Vector3 &position,
+                          const Vector3 &velocity) {
+  if (count == capacity) {
+    reserve(std::max((size_t)16, 2 * capacity));
+  }
+  double *row = &arena[count];
+  row[0] = offset;
+  row[capacity] = position.x;
+  row[2 * capacity] = position.y;
+  row[3 * capacity] = position.z;
+  row[4 * capacity] = velocity.x;
+  row[5 * capacity] = velocity.y;
+  row[6 * capacity] = velocity.z;
+  count += 1;
+}
+
+// Append an ICRF state
+void Ephemeris::push_back(ICRF &state) {
+  if (count == 0) {
+    epoch = state.epoch;
+    central_body = state.central_body;
+  }
+  push_back(state.epoch.difference(epoch), state.position, state.velocity);
+}
+
+// Get the epoch offset column
+double* Ephemeris::offsets() { return arena.data(); }
+
+// Get a state component column
+double* Ephemeris::component(int index) {
+  return arena.data() + (index + 1) * capacity;
+}
+
+// Get the epoch of a state
+DateTime Ephemeris::state_epoch(size_t index) {
+  return epoch.increment(arena[index]);
+}
+
+// Get a state as ICRF
+ICRF Ephemeris::state(size_t index) {
+  const double *row = &arena[index];
+  DateTime at = epoch.increment(row[0]);
+  Vector3 position{ row[capacity], row[2 * capacity], row[3 * capacity] };
+  Vector3 velocity{ row[4 * capacity], row[5 * capacity],
+                    row[6 * capacity] };
+  return ICRF{ central_body, at, position, velocity };
+}
+
+// Get every state as ICRF
+std::vector<ICRF> Ephemeris::states() {
+  std::vector<ICRF> states{};
+  states.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    states.push_back(state(i));
+  }
+  return states;
+}
+
 // Use Keplerian estimation to obtain an interpolated ICRF
 ICRF Ephemeris::interpolate(DateTime &requested) {
-  // Single call to get number of states (for performance)
-  size_t ephem_size = states.size();
-  // Nearest (by epoch) state to requested time
-  ICRF nearest = states[0];
+  const double *offset = offsets();
+  // Seconds since the ephemeris epoch of the requested time
+  double requested_sec = requested.difference(epoch);
+  // Index of the nearest (by epoch) state to requested time
+  size_t nearest = 0;
   // If requested time is after last state
-  if (requested.difference(states[ephem_size - 1].epoch) >= 0.0) {
+  if (requested_sec >= offset[count - 1]) {
     // Set nearest to the last available state
-    nearest = states[ephem_size - 1];
+    nearest = count - 1;
     // If requested time is before first state
-  } else if (requested.difference(states[0].epoch) <= 0.0) {
+  } else if (requested_sec <= offset[0]) {
     // Set nearest to the first available state
-    nearest = states[0];
+    nearest = 0;
   } else {
     // Find the total time span (in seconds) of the available states
-    double span_sec = states[ephem_size - 1].epoch.difference(states[0].epoch);
+    double span_sec = offset[count - 1] - offset[0];
     // Find the expected number of seconds into the ephemeris the requested
     // epoch should be
-    double expected_sec = requested.difference(states[0].epoch);
+    double expected_sec = requested_sec - offset[0];
     // Expected percentage into the total ephemeris span
     double expected_per = expected_sec / span_sec;
     // Estimated index in ephemeris
-    int est_index = (int)(ephem_size * expected_per);
-    nearest = states[est_index];
+    nearest = (size_t)(count * expected_per);
   }
-  // Convert the nearest state to keplerian
-  KeplerianElements nearest_keplerian{nearest};
-  // Propagate the keplerian state to the requested time
-  KeplerianElements propagated_keplerian =
-      nearest_keplerian.propagate_to(requested);
-  // return the result in ICRF
-  return ICRF{propagated_keplerian};
+  // Propagate the nearest state to the requested time along its two-body
+  // orbit, avoiding a round trip through orbital elements
+  ICRF nearest_state = state(nearest);
+  Vector3 position, velocity;
+  propagate_universal(central_body.mu(), nearest_state.position,
+                      nearest_state.velocity,
+                      requested.difference(nearest_state.epoch), position,
+                      velocity);
+  return ICRF{central_body, requested, position, velocity};
+}
+
+// Rotate every state into ITRF
+std::vector<ITRF> Ephemeris::to_itrf(unsigned threads) {
+  std::vector<ICRF> inertial = states();
+  return ::to_itrf(inertial, threads);
+}
+
+// Convert every state to geodetic coordinates
+std::vector<Geodetic> Ephemeris::to_geodetic(unsigned threads) {
+  std::vector<ICRF> inertial = states();
+  return ::to_geodetic(inertial, threads);
 }
 
 // Create ASCII ephemeris in STK format (.e)
@@ -138,12 +271,14 @@ std::vector<std::string> Ephemeris::format_stk() {
 
   // Number of ephemeris points line
   std::stringstream n_points;
-  n_points << "NumberOfEphemerisPoints " << states.size();
+  n_points << "NumberOfEphemerisPoints " << count;
   lines.push_back(n_points.str());
 
   // Scenario epoch line
+  char epoch_buffer[CIVIL_BUFFER_SIZE];
+  epoch.write_civil(STK_DATE, epoch_buffer);
   std::stringstream epoch_str;
-  epoch_str << "ScenarioEpoch " << epoch.format_fractional("%d %b %Y %H:%M:%S");
+  epoch_str << "ScenarioEpoch " << epoch_buffer;
   lines.push_back(epoch_str.str());
 
   // Central body line
@@ -156,17 +291,15 @@ std::vector<std::string> Ephemeris::format_stk() {
   lines.push_back("EphemerisTimePosVel");
 
   // For each state in the state list
-  for (ICRF state : states) {
-    // Calculate time since epoch
-    double tplus = state.epoch.difference(epoch);
-
+  for (size_t i = 0; i < count; i++) {
     // Stream t+, rx, ry, rz, vx, vy, vz into each line
+    const double *row = &arena[i];
     std::stringstream point_line;
     point_line << std::setprecision(14);
-    point_line << std::scientific << tplus << " " << state.position.x << " "
-               << state.position.y << " " << state.position.z << " "
-               << state.velocity.x << " " << state.velocity.y << " "
-               << state.velocity.z;
+    point_line << std::scientific << row[0] << " " << row[capacity] << " "
+               << row[2 * capacity] << " " << row[3 * capacity] << " "
+               << row[4 * capacity] << " " << row[5 * capacity] << " "
+               << row[6 * capacity];
 
     // Add the line to the lines vector
     lines.push_back(point_line.str());
@@ -197,7 +330,7 @@ Ephemeris operator functions
 // I/O stream
 std::ostream &operator<<(std::ostream &out, Ephemeris &eph) {
   out << "[Ephemeris] { Epoch: " << eph.epoch.to_iso()
-      << ", Number of states: " << eph.states.size()
+      << ", Number of states: " << eph.size()
       << ", Central body: " << eph.central_body.get_name() << " }";
   return out;
 }
\ No newline at end of file
@@ -1,11 +1,16 @@
 #include <exceptions.h>
 #include <run_config.h>
+#include <run_server.h>
 
 #include <iostream>
+#include <string>
 
 void print_help() {
   std::cout << std::endl << "Usage:" << std::endl
             << "arc [options] <file>" << std::endl
+            << "arc --serve <socket> [<file>]" << std::endl
+            << "arc --send <socket> <file>" << std::endl
+            << "arc --stop <socket>" << std::endl
             << std::endl
             << "<file> must be a JSON file containing the run configuration "
                "for state propagation"
@@ -13,16 +18,46 @@ void print_help() {
             << std::endl
             << "Options: " << std::endl
             << " -help      Display this message" << std::endl
-            << " -echo      Echo all messages to stdout" << std::endl;
+            << " -echo      Echo all messages to stdout" << std::endl
+            << " --serve    Serve run configurations sent to the Unix "
+               "socket, keeping" << std::endl
+            << "            reference data loaded (<file> sets the reference "
+               "data)" << std::endl
+            << " --send     Run a configuration on a server, printing the "
+               "streamed" << std::endl
+            << "            products (output FILENAME \"-\")" << std::endl
+            << " --stop     Shut a server down" << std::endl;
 }
 
 int main(int argc, char* argv[]) {
   try {
+    std::string command = argc > 1 ? std::string{argv[1]} : std::string{};
     if (argc == 1) {
       throw ArcException("No run configuration file found.");
     } else if (std::string{argv[argc - 1]}.find("-help") != std::string::npos) {
       print_help();
       return 0;
+    } else if (command == "--serve") {
+      if (argc < 3) {
+        throw ArcException("No server socket given.");
+      }
+      RunServer server{ argv[2] };
+      if (argc > 3) {
+        server.configure(argv[3]);
+      }
+      server.serve();
+    } else if (command == "--send") {
+      if (argc < 4) {
+        throw ArcException("No server socket or run configuration file given.");
+      }
+      if (!send_run_config(argv[2], argv[3])) {
+        return 1;
+      }
+    } else if (command == "--stop") {
+      if (argc < 3) {
+        throw ArcException("No server socket given.");
+      }
+      stop_run_server(argv[2]);
     } else {
       // Run configuration file
       char* rc_filename = argv[argc - 1];
@@ -34,4 +69,4 @@ int main(int argc, char* argv[]) {
     return 1;
   }
   return 0;
-}
\ No newline at end of file
+}
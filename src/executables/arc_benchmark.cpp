@@ -0,0 +1,311 @@
+#include <bulirsch_stoer.h>
+#include <celestial.h>
+#include <datetime.h>
+#include <exceptions.h>
+#include <force_model.h>
+#include <gravity.h>
+#include <icrf.h>
+#include <keplerian.h>
+#include <math_utils.h>
+#include <rungekutta4.h>
+#include <sundman.h>
+#include <symplectic.h>
+#include <taylor.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Final position error (m) that a propagator must reach to be compared
+const double BENCHMARK_TOLERANCE = 1.0;
+
+/*
+Orbit used to compare propagators
+*/
+struct BenchmarkCase {
+  // Name of the case
+  std::string name;
+  // Initial state
+  ICRF state;
+  // Seconds to propagate
+  double duration;
+  // Description of the force model
+  std::string model;
+  // Force model used by every propagator
+  ForceModel forces;
+};
+
+/*
+Result of a single propagation
+*/
+struct BenchmarkResult {
+  // Integration step in seconds
+  double step;
+  // Number of force model evaluations
+  size_t evaluations;
+  // Final position error in meters
+  double error;
+  // Wall-clock time in seconds
+  double seconds;
+};
+
+// Central-body J2 force model
+ForceModel j2_forces(ICRF &state) {
+  ForceModel fm{};
+  fm.add_gravity(GravityModel{ state.central_body, J2, true, 2, 0 });
+  return fm;
+}
+
+// Point-mass Earth, Moon, and Sun force model
+ForceModel cislunar_forces(ICRF &state) {
+  CelestialBody moon = get_body_by_name("Moon");
+  CelestialBody sun = get_body_by_name("Sun");
+  ForceModel fm{};
+  fm.add_gravity(GravityModel{ state.central_body, J2, false, 0, 0 });
+  fm.add_gravity(GravityModel{ moon, J2, false, 0, 0 });
+  fm.add_gravity(GravityModel{ sun, J2, false, 0, 0 });
+  return fm;
+}
+
+// Propagate a case with a propagator and measure the cost and error
+template <class P>
+BenchmarkResult run_propagator(BenchmarkCase &bench, double step,
+                               ICRF &truth) {
+  P propagator{ bench.state, step, bench.forces };
+  DateTime stop = bench.state.epoch.increment(bench.duration);
+  auto start = std::chrono::steady_clock::now();
+  ICRF final_state = propagator.propagate(stop);
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  Vector3 diff = final_state.position - truth.position;
+  return BenchmarkResult{ step, propagator.force_model.evaluations, diff.mag(),
+                          elapsed.count() };
+}
+
+// Propagate a case with the Taylor integrator at a tolerance, reporting Taylor
+// steps in place of force evaluations
+BenchmarkResult run_taylor(BenchmarkCase &bench, double tolerance,
+                           ICRF &truth) {
+  TaylorPropagator propagator{ bench.state, bench.duration, bench.forces };
+  propagator.set_tolerance(tolerance);
+  DateTime stop = bench.state.epoch.increment(bench.duration);
+  auto start = std::chrono::steady_clock::now();
+  ICRF final_state = propagator.propagate(stop);
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  Vector3 diff = final_state.position - truth.position;
+  std::cout << "  " << std::left << std::setw(14) << "Taylor" << std::right
+            << std::setw(8) << std::scientific << std::setprecision(0)
+            << tolerance << std::setw(12) << propagator.order
+            << std::setw(12) << propagator.steps << std::setw(16)
+            << std::setprecision(3) << diff.mag() << std::setw(12)
+            << std::fixed << std::setprecision(4) << elapsed.count()
+            << std::endl;
+  return BenchmarkResult{ tolerance, propagator.steps, diff.mag(),
+                          elapsed.count() };
+}
+
+// Propagate a case with the Bulirsch-Stoer integrator at a tolerance
+BenchmarkResult run_bulirsch_stoer(BenchmarkCase &bench, double tolerance,
+                                   ICRF &truth) {
+  BulirschStoerPropagator propagator{ bench.state, bench.duration,
+                                      bench.forces };
+  propagator.set_tolerance(tolerance);
+  DateTime stop = bench.state.epoch.increment(bench.duration);
+  auto start = std::chrono::steady_clock::now();
+  ICRF final_state = propagator.propagate(stop);
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  Vector3 diff = final_state.position - truth.position;
+  std::cout << "  " << std::left << std::setw(14) << "Bulirsch-Stoer"
+            << std::right << std::setw(8) << std::scientific
+            << std::setprecision(0) << tolerance << std::setw(12)
+            << propagator.force_model.evaluations << std::setw(16)
+            << std::setprecision(3) << diff.mag() << std::setw(12)
+            << std::fixed << std::setprecision(4) << elapsed.count()
+            << std::endl;
+  return BenchmarkResult{ tolerance, propagator.force_model.evaluations,
+                          diff.mag(), elapsed.count() };
+}
+
+// Step through decreasing step sizes until the tolerance is met, printing
+// each result, and return the result that met it
+template <class P>
+BenchmarkResult compare(std::string method, BenchmarkCase &bench,
+                        ICRF &truth) {
+  std::vector<double> steps{ 3600.0, 1800.0, 900.0, 600.0, 300.0, 120.0,
+                             60.0, 30.0, 15.0, 10.0, 5.0, 2.0 };
+  BenchmarkResult result{};
+  for (double step : steps) {
+    result = run_propagator<P>(bench, step, truth);
+    std::cout << "  " << std::left << std::setw(14) << method << std::right
+              << std::setw(8) << std::fixed << std::setprecision(0) << step
+              << std::setw(12) << result.evaluations
+              << std::setw(16) << std::scientific << std::setprecision(3)
+              << result.error << std::setw(12) << std::fixed
+              << std::setprecision(4) << result.seconds << std::endl;
+    if (result.error < BENCHMARK_TOLERANCE) {
+      break;
+    }
+  }
+  return result;
+}
+
+// Specific orbital energy including the J2 potential (m^2/s^2)
+double j2_energy(ICRF &state) {
+  CelestialBody body = state.central_body;
+  double r = state.position.mag();
+  double z_r = state.position.z / r;
+  double potential = -body.mu() / r + body.mu() * body.j2() *
+    body.radius_equator() * body.radius_equator() * (3.0 * z_r * z_r - 1.0) /
+    (2.0 * r * r * r);
+  return 0.5 * state.velocity.dot(state.velocity) + potential;
+}
+
+// Propagate a case in hourly increments, printing the largest and final
+// relative energy errors
+template <class P>
+void energy_drift(std::string method, BenchmarkCase &bench, double step,
+                  P &propagator) {
+  double e_0 = j2_energy(bench.state);
+  double max_error = 0.0, error = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (double t = 3600.0; t <= bench.duration; t += 3600.0) {
+    DateTime epoch = bench.state.epoch.increment(t);
+    ICRF state = propagator.propagate(epoch);
+    error = fabs((j2_energy(state) - e_0) / e_0);
+    max_error = std::max(max_error, error);
+  }
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  std::cout << "  " << std::left << std::setw(14) << method << std::right
+            << std::setw(8) << std::fixed << std::setprecision(0) << step
+            << std::setw(12) << propagator.force_model.evaluations
+            << std::setw(16) << std::scientific << std::setprecision(3)
+            << max_error << std::setw(16) << error << std::setw(12)
+            << std::fixed << std::setprecision(4) << elapsed.count()
+            << std::endl;
+}
+
+// Run a symplectic method for the energy drift comparison
+void symplectic_drift(std::string method, BenchmarkCase &bench, double step,
+                      SymplecticSplitting splitting, int order) {
+  SymplecticPropagator propagator{ bench.state, step, bench.forces };
+  propagator.set_method(splitting, order);
+  energy_drift(method, bench, step, propagator);
+}
+
+// Build a case from Keplerian elements (distances in km, angles in degrees)
+BenchmarkCase keplerian_case(std::string name, double a, double e, double i,
+                             double o, double w, double duration,
+                             bool cislunar) {
+  CelestialBody earth = EARTH;
+  DateTime epoch{ std::string{ "2021-03-20T00:00:00.000000" } };
+  KeplerianElements el{ earth, epoch, a * 1000.0, e, radians(i),
+                        radians(o), radians(w), 0.0 };
+  ICRF state{ el };
+  if (cislunar) {
+    return BenchmarkCase{ name, state, duration, "Earth/Moon/Sun",
+                          cislunar_forces(state) };
+  }
+  return BenchmarkCase{ name, state, duration, "J2", j2_forces(state) };
+}
+
+int main() {
+  try {
+    std::vector<BenchmarkCase> cases{
+      keplerian_case("Molniya", 26554.0, 0.72, 63.4, 0.0, 270.0, 86400.0,
+                     false),
+      keplerian_case("GTO", 24396.137, 0.7283, 28.5, 0.0, 180.0, 86400.0,
+                     false),
+      keplerian_case("Translunar", 195539.0, 0.96585, 28.5, 0.0, 180.0,
+                     432000.0, true)
+    };
+    for (BenchmarkCase &bench : cases) {
+      // Reference trajectory from a very small fixed step
+      RungeKutta4 reference{ bench.state, 0.5, bench.forces };
+      DateTime stop = bench.state.epoch.increment(bench.duration);
+      ICRF truth = reference.propagate(stop);
+      std::cout << std::defaultfloat << std::setprecision(6) << bench.name
+                << " (" << bench.duration / 3600.0
+                << " h, " << bench.model << ", tolerance "
+                << BENCHMARK_TOLERANCE << " m)"
+                << std::endl;
+      std::cout << "  " << std::left << std::setw(14) << "method"
+                << std::right << std::setw(8) << "step" << std::setw(12)
+                << "evals" << std::setw(16) << "error (m)" << std::setw(12)
+                << "time (s)" << std::endl;
+      BenchmarkResult cowell = compare<RungeKutta4>("RK4", bench, truth);
+      BenchmarkResult sundman =
+        compare<SundmanPropagator>("RK4-Sundman", bench, truth);
+      std::cout << "  Force evaluations to reach tolerance: RK4 "
+                << cowell.evaluations << ", RK4-Sundman "
+                << sundman.evaluations << " ("
+                << std::fixed << std::setprecision(1) << (double)cowell.evaluations / sundman.evaluations
+                << "x fewer)" << std::endl;
+      // Errors below about 1e-5 m are limited by the reference trajectory
+      std::cout << "  " << std::left << std::setw(14) << "method"
+                << std::right << std::setw(8) << "tol" << std::setw(12)
+                << "evals" << std::setw(16) << "error (m)" << std::setw(12)
+                << "time (s)" << std::endl;
+      BenchmarkResult extrapolation{};
+      for (double tolerance : { 1e-6, 1e-8, 1e-10, 1e-12, 1e-14 }) {
+        BenchmarkResult result = run_bulirsch_stoer(bench, tolerance, truth);
+        if (extrapolation.evaluations == 0 &&
+            result.error < BENCHMARK_TOLERANCE) {
+          extrapolation = result;
+        }
+      }
+      std::cout << "  Force evaluations to reach tolerance: RK4 "
+                << cowell.evaluations << ", Bulirsch-Stoer "
+                << extrapolation.evaluations << std::endl;
+      // The Taylor integrator only models central-body gravity
+      bool is_aspherical = false;
+      if (!bench.forces.central_gravity_only(bench.state, is_aspherical)) {
+        std::cout << std::endl;
+        continue;
+      }
+      std::cout << "  " << std::left << std::setw(14) << "method"
+                << std::right << std::setw(8) << "tol" << std::setw(12)
+                << "order" << std::setw(12) << "steps" << std::setw(16)
+                << "error (m)" << std::setw(12) << "time (s)" << std::endl;
+      BenchmarkResult taylor{};
+      for (double tolerance : { 1e-6, 1e-9, 1e-12, 1e-15 }) {
+        BenchmarkResult result = run_taylor(bench, tolerance, truth);
+        if (taylor.evaluations == 0 && result.error < BENCHMARK_TOLERANCE) {
+          taylor = result;
+        }
+      }
+      std::cout << "  Time to reach tolerance: RK4 " << std::setprecision(4)
+                << cowell.seconds << " s, Bulirsch-Stoer "
+                << extrapolation.seconds << " s, Taylor " << taylor.seconds
+                << " s" << std::endl
+                << std::endl;
+    }
+    // Long-duration energy conservation with a conservative force model
+    BenchmarkCase leo = keplerian_case("LEO", 7000.0, 0.001, 51.6, 0.0, 0.0,
+                                       365.0 * 86400.0, false);
+    std::cout << std::defaultfloat << std::setprecision(6) << leo.name << " ("
+              << leo.duration / 86400.0 << " d, " << leo.model
+              << ", energy error)" << std::endl;
+    std::cout << "  " << std::left << std::setw(14) << "method" << std::right
+              << std::setw(8) << "step" << std::setw(12) << "evals"
+              << std::setw(16) << "max |dE/E|" << std::setw(16)
+              << "final |dE/E|" << std::setw(12) << "time (s)" << std::endl;
+    for (double step : { 120.0, 60.0 }) {
+      RungeKutta4 propagator{ leo.state, step, leo.forces };
+      energy_drift("RK4", leo, step, propagator);
+    }
+    symplectic_drift("Leapfrog", leo, 30.0, Leapfrog, 2);
+    symplectic_drift("Yoshida-4", leo, 60.0, Leapfrog, 4);
+    symplectic_drift("Yoshida-6", leo, 120.0, Leapfrog, 6);
+    symplectic_drift("WH-2", leo, 120.0, WisdomHolman, 2);
+    symplectic_drift("WH-4", leo, 240.0, WisdomHolman, 4);
+  } catch (const ArcException &err) {
+    std::cout << err.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
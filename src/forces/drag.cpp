@@ -1,6 +1,7 @@
 #include <drag.h>
 
 #include <cmath>
+#include <matrices.h>
 
 // 1976 Standard Exponential atmosphere values
 double std1976_values[28][3] = {
@@ -34,10 +35,9 @@ double std1976_values[28][3] = {
   {1000000, 3.019e-15, 268.0e+3}
 };
 
-// Standard 1976 Atmosphere density
-double density_std1976(ICRF& sc_state) {
-    // Approximate altitude at this position
-    double alt = sc_state.position.mag() - EARTH.radius_equator;
+// Standard 1976 Atmosphere values (base altitude, density, scale height) of the
+// layer containing an altitude
+double *std1976_layer(double alt) {
     // Values to use in the density calculation
     double *values = std1976_values[0];
     // If altitude is greater than the last available value
@@ -51,6 +51,15 @@ double density_std1976(ICRF& sc_state) {
             }
         }
     }
+    return values;
+}
+
+// Standard 1976 Atmosphere density
+double density_std1976(ICRF& sc_state) {
+    // Approximate altitude at this position
+    double alt = sc_state.position.mag() - EARTH.radius_equator();
+    // Values to use in the density calculation
+    double *values = std1976_layer(alt);
     // values[0]: Base altitude
     // values[1]: Density (kg/m^3)
     // values[2]: Scale height
@@ -89,11 +98,60 @@ Vector3 DragModel::acceleration(ICRF& sc_state) {
     // Get atmospheric density in kg/m^3
     double dens = get_density(sc_state);
     // Include body's rotation in relative velocity
-    Vector3 v_rel_a = central_body.rotation.inverse().cross(sc_state.position);
+    Vector3 v_rel_a = central_body.rotation().inverse().cross(sc_state.position);
     Vector3 v_rel = sc_state.velocity.add(v_rel_a);
     // Magnitude of the drag force 
     double f_mag = 0.5 * dens * ((cd * area) / mass) * pow(v_rel.mag(), 2);
     // The acceleration vector of the drag force in m/s^2
     // This is the inverse of normalized relative velocity vector, scaled to the magnitude of the drag
     return v_rel.inverse().unit().scale(f_mag);
+}
+
+// Add the partial derivatives of drag acceleration into a state Jacobian
+void DragModel::partials(ICRF& sc_state, Matrix6& jacobian) {
+    // Get atmospheric density in kg/m^3
+    double dens = get_density(sc_state);
+    // Gradient of the density is along the radial direction, with magnitude
+    // -density / scale height for the exponential atmosphere layers
+    double d_dens = 0.0;
+    if (density_model == Standard1976) {
+        double alt = sc_state.position.mag() - EARTH.radius_equator();
+        d_dens = -dens / std1976_layer(alt)[2];
+    }
+    Vector3 r_unit = sc_state.position.unit();
+    // Relative velocity including the body's rotation
+    Vector3 v_rel_a = central_body.rotation().inverse().cross(sc_state.position);
+    Vector3 v_rel = sc_state.velocity.add(v_rel_a);
+    double v_rel_mag = v_rel.mag();
+    double ballistic = 0.5 * ((cd * area) / mass);
+    double v[3] = {v_rel.x, v_rel.y, v_rel.z};
+    double r_hat[3] = {r_unit.x, r_unit.y, r_unit.z};
+    Vector3 w = central_body.rotation();
+    // Cross product matrix of the rotation vector, v_rel = v - [w]r
+    double w_cross[3][3] = {
+        {0.0, -w.z, w.y},
+        {w.z, 0.0, -w.x},
+        {-w.y, w.x, 0.0}
+    };
+    // Partials with respect to relative velocity
+    double d_vel[3][3];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            double identity = i == j ? 1.0 : 0.0;
+            d_vel[i][j] = -ballistic * dens *
+                          (v_rel_mag * identity + v[i] * v[j] / v_rel_mag);
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            // Position partials from the density gradient and from the
+            // position dependence of the relative velocity
+            double d_pos = -ballistic * v_rel_mag * v[i] * d_dens * r_hat[j];
+            for (int k = 0; k < 3; k++) {
+                d_pos -= d_vel[i][k] * w_cross[k][j];
+            }
+            jacobian.elements[3 + i][j] += d_pos;
+            jacobian.elements[3 + i][3 + j] += d_vel[i][j];
+        }
+    }
 }
\ No newline at end of file
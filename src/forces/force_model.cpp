@@ -5,27 +5,34 @@ Base force model class methods
 */
 
 // Default constructor
-ForceModel::ForceModel() { this->gravity_models = std::vector<GravityModel>{}; }
+ForceModel::ForceModel() {
+  this->gravity_models = std::vector<GravityModel>{};
+  this->has_drag = false;
+  this->has_srp = false;
+  this->body_cache.fill(BodyPositionCache{0, 0, 0.0, Vector3{}});
+  this->body_cache_next = 0;
+  this->evaluations = 0;
+}
 
 // Minimum constructor
-ForceModel::ForceModel(ICRF &state) {
+ForceModel::ForceModel(ICRF &state) : ForceModel{} {
   this->gravity_models =
       std::vector<GravityModel>{GravityModel{state.central_body, J2, false, 0, 0}};
-  this->drag_model = DragModel{};
 }
 
 // Direct constructor
-ForceModel::ForceModel(std::vector<GravityModel> gravity_models, DragModel drag_model) {
+ForceModel::ForceModel(std::vector<GravityModel> gravity_models, DragModel drag_model) : ForceModel{} {
   this->gravity_models = gravity_models;
   this->drag_model = drag_model;
+  this->has_drag = true;
 }
 
 // Add a new GravityModel to the list
 void ForceModel::add_gravity(GravityModel model) {
   // Check for existing model which matches the central body
-  for (int i = 0; i < gravity_models.size(); i++) {
+  for (size_t i = 0; i < gravity_models.size(); i++) {
     // If the matching central body is found
-    if (gravity_models[i].body.id == model.body.id) {
+    if (gravity_models[i].body.id() == model.body.id()) {
       // Replace it in place with the new model
       gravity_models[i] = model;
       // Exit the function to avoid adding it a second time
@@ -39,22 +46,103 @@ void ForceModel::add_gravity(GravityModel model) {
 // Change atmospheric drag model
 void ForceModel::set_drag_model(DragModel model) {
   drag_model = model;
+  has_drag = true;
 }
 
-// Add a new GravityModel to the list
+// Change solar radiation pressure model
+void ForceModel::set_srp_model(SolarRadiationModel model) {
+  srp_model = model;
+  has_srp = true;
+}
+
+// Get the position of a body relative to the central body of a spacecraft state
+Vector3 ForceModel::body_position(CelestialBody body, ICRF &state) {
+  // Search the cache for a position computed at this epoch
+  for (BodyPositionCache &entry : body_cache) {
+    if (entry.body_id == body.id() &&
+        entry.central_body_id == state.central_body.id() &&
+        entry.epoch == state.epoch.seconds_since_j2000()) {
+      return entry.position;
+    }
+  }
+  // Propagate the body and center it around the spacecraft's central body
+  ICRF body_state =
+      body.propagate(state.epoch).change_central_body(state.central_body);
+  // Replace the oldest cache entry
+  body_cache[body_cache_next] =
+      BodyPositionCache{body.id(), state.central_body.id(),
+                        state.epoch.seconds_since_j2000(), body_state.position};
+  body_cache_next = (body_cache_next + 1) % body_cache.size();
+  return body_state.position;
+}
+
+// Get total acceleration force at a given state
 Vector3 ForceModel::acceleration(ICRF &state) {
+  evaluations += 1;
   Vector3 acceleration, temp_accel;
   // Add gravity accelerations
-  for (GravityModel gm : gravity_models) {
-    temp_accel = gm.acceleration(state);
+  for (GravityModel &gm : gravity_models) {
+    if (gm.body.id() == state.central_body.id()) {
+      temp_accel = gm.acceleration(state);
+    } else {
+      // Third-body positions are shared with other models at the same epoch
+      Vector3 body_pos = body_position(gm.body, state);
+      temp_accel = gm.acceleration(state, body_pos);
+    }
     acceleration = acceleration.add(temp_accel);
   }
   // Add drag acceleration
-  temp_accel = drag_model.acceleration(state);
-  acceleration = acceleration.add(temp_accel);
+  if (has_drag) {
+    temp_accel = drag_model.acceleration(state);
+    acceleration = acceleration.add(temp_accel);
+  }
+  // Add solar radiation pressure acceleration
+  if (has_srp) {
+    Vector3 sun_pos = body_position(SUN, state);
+    temp_accel = srp_model.acceleration(state, sun_pos);
+    acceleration = acceleration.add(temp_accel);
+  }
   return acceleration;
 }
 
+// Determine whether the model is limited to central-body gravity
+bool ForceModel::central_gravity_only(ICRF &state, bool &is_aspherical) {
+  if (has_drag || has_srp || gravity_models.size() != 1 ||
+      gravity_models[0].body.id() != state.central_body.id()) {
+    return false;
+  }
+  is_aspherical = gravity_models[0].is_aspherical;
+  return true;
+}
+
+// Determine whether every modeled force is conservative
+bool ForceModel::is_conservative() {
+  return !has_drag && !has_srp;
+}
+
+// Get the Jacobian of the state derivative at a given state
+Matrix6 ForceModel::jacobian(ICRF &state) {
+  Matrix6 jac;
+  // Derivative of position is velocity
+  for (int i = 0; i < 3; i++) {
+    jac.elements[i][3 + i] = 1.0;
+  }
+  // Add gravity partials
+  for (GravityModel &gm : gravity_models) {
+    if (gm.body.id() == state.central_body.id()) {
+      gm.partials(state, jac);
+    } else {
+      Vector3 body_pos = body_position(gm.body, state);
+      gm.partials(state, body_pos, jac);
+    }
+  }
+  // Add drag partials
+  if (has_drag) {
+    drag_model.partials(state, jac);
+  }
+  return jac;
+}
+
 /*
 ForceModel operator functions
 */
@@ -65,5 +153,9 @@ std::ostream &operator<<(std::ostream &out, ForceModel &fm) {
   for (GravityModel gm : fm.gravity_models) {
     out << " - " << gm.body.get_name() << std::endl;
   }
+  out << " Atmospheric drag: " << (fm.has_drag ? "Enabled" : "Disabled")
+      << std::endl
+      << " Solar radiation pressure: " << (fm.has_srp ? "Enabled" : "Disabled")
+      << std::endl;
   return out;
 }
\ No newline at end of file
@@ -25,7 +25,7 @@ Direct constructor
 @param degree Geopotential model degree
 @param order Geopotential model order
 */
-GravityModel::GravityModel(CelestialBody &body, GeopotentialModel model,
+GravityModel::GravityModel(CelestialBody body, GeopotentialModel model,
                            bool is_aspherical, int degree, int order) {
   this->body = body;
   this->model = model;
@@ -42,26 +42,39 @@ Calculate acceleration due to gravity, assuming a spherical body
 */
 Vector3 GravityModel::spherical(ICRF &sc_state) {
   // If we are modelling central body gravity
-  if (sc_state.central_body.id == body.id) {
-    return sc_state.position.scale(-body.mu / pow(sc_state.position.mag(), 3));
+  if (sc_state.central_body.id() == body.id()) {
+    return sc_state.position.scale(-body.mu() / pow(sc_state.position.mag(), 3));
   } else {
     // Get the position of the body at the spacecraft state's epoch,
     // centered around the body the spacecraft is orbiting
     ICRF body_state = body.propagate(sc_state.epoch)
                           .change_central_body(sc_state.central_body);
-    Vector3 spacecraft_centered_pos =
-        body_state.position.change_origin(sc_state.position);
-    double a_den = pow(spacecraft_centered_pos.mag(), 3.0);
-    double b_den = pow(body_state.position.mag(), 3.0);
-    // If this is central body gravity, b_den will be zero, causing a
-    // singularity
-    if (b_den == 0.0) {
-      b_den = 1.0;
-    }
-    Vector3 b = body_state.position.scale(-1.0 / b_den);
-    Vector3 grav_vector = spacecraft_centered_pos.scale(1.0 / a_den).add(b);
-    return grav_vector.scale(body.mu);
+    return third_body(sc_state, body_state.position);
+  }
+}
+
+/*
+Calculate acceleration due to gravity of a spherical third body at a known
+position relative to the spacecraft's central body
+
+@param sc_state Spacecraft ICRF state at which to calculate body gravity
+@param body_position Position of the body relative to the spacecraft's central
+body
+@returns Vector of acceleration due to the third body given state, in m/s^2
+*/
+Vector3 GravityModel::third_body(ICRF &sc_state, Vector3 &body_position) {
+  Vector3 spacecraft_centered_pos =
+      body_position.change_origin(sc_state.position);
+  double a_den = pow(spacecraft_centered_pos.mag(), 3.0);
+  double b_den = pow(body_position.mag(), 3.0);
+  // If this is central body gravity, b_den will be zero, causing a
+  // singularity
+  if (b_den == 0.0) {
+    b_den = 1.0;
   }
+  Vector3 b = body_position.scale(-1.0 / b_den);
+  Vector3 grav_vector = spacecraft_centered_pos.scale(1.0 / a_den).add(b);
+  return grav_vector.scale(body.mu());
 }
 
 /*
@@ -80,7 +93,7 @@ Vector3 GravityModel::aspherical(ICRF &sc_state) {
     double rmag = sc_state.position.mag();
     // Leading coefficient (same for all elements)
     double coeff =
-        (3.0 / 2.0) * body.mu * j2 * pow(body.radius_equator, 2) / pow(rmag, 5);
+        (3.0 / 2.0) * body.mu() * j2 * body.radius_squared() / pow(rmag, 5);
     // Initial acceleration vector elements
     double a_x = 5.0 * pow(sc_state.position.z, 2) / pow(rmag, 2) - 1;
     double a_y = 5.0 * pow(sc_state.position.z, 2) / pow(rmag, 2) - 1;
@@ -114,6 +127,133 @@ Vector3 GravityModel::acceleration(ICRF &state) {
   return accel;
 }
 
+/*
+Calculate acceleration on a spacecraft due to gravity, given its ICRF state and
+the position of this model's body relative to the state's central body
+
+Avoids propagating the body again when its position at the state's epoch is
+already known
+
+@param sc_state Spacecraft ICRF state at which to calculate body gravity
+@param body_position Position of the body relative to the spacecraft's central
+body
+@returns Vector of total acceleration due to gravity at given state, in m/s^2
+*/
+Vector3 GravityModel::acceleration(ICRF &state, Vector3 &body_position) {
+  // Central body gravity does not depend on the body position
+  if (state.central_body.id() == body.id()) {
+    return acceleration(state);
+  }
+  // Empty acceleration vector
+  Vector3 accel;
+  // Get spherical gravity
+  Vector3 sph_grav = third_body(state, body_position);
+  accel = accel.add(sph_grav);
+  // If we are modeling aspherical effects
+  if (is_aspherical) {
+    Vector3 aspher = aspherical(state);
+    accel = accel.add(aspher);
+  }
+  return accel;
+}
+
+/*
+Add the partial derivatives of point-mass gravity with respect to position,
+given the spacecraft position relative to the body
+
+The lower-left block of the Jacobian receives -mu/r^3 * (I - 3 * r * r^T / r^2)
+
+@param relative_position Spacecraft position relative to the body
+@param jacobian State Jacobian to which the partials are added
+*/
+void GravityModel::spherical_partials(Vector3 &relative_position,
+                                      Matrix6 &jacobian) {
+  double r[3] = {relative_position.x, relative_position.y,
+                 relative_position.z};
+  double rmag_sq = relative_position.dot(relative_position);
+  double coeff = -body.mu() / (rmag_sq * sqrt(rmag_sq));
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      double identity = i == j ? 1.0 : 0.0;
+      jacobian.elements[3 + i][j] +=
+          coeff * (identity - 3.0 * r[i] * r[j] / rmag_sq);
+    }
+  }
+}
+
+/*
+Add the partial derivatives of the aspherical components of gravity with
+respect to position
+
+Differentiates the J2 acceleration used by GravityModel::aspherical
+
+@param sc_state Spacecraft ICRF state at which to calculate the partials
+@param jacobian State Jacobian to which the partials are added
+*/
+void GravityModel::aspherical_partials(ICRF &sc_state, Matrix6 &jacobian) {
+  if (model == J2) {
+    double r[3] = {sc_state.position.x, sc_state.position.y,
+                   sc_state.position.z};
+    double rmag_sq = sc_state.position.dot(sc_state.position);
+    double rmag = sqrt(rmag_sq);
+    // Leading coefficient, including the 1/r^5 dependence
+    double f = (3.0 / 2.0) * body.mu() * body.j2() *
+               body.radius_squared() / pow(rmag, 5);
+    // a_i = f * r_i * (g - c_i), with g = 5z^2/r^2
+    double g = 5.0 * r[2] * r[2] / rmag_sq;
+    double c[3] = {1.0, 1.0, 3.0};
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        double identity = i == j ? 1.0 : 0.0;
+        double z_term = j == 2 ? 10.0 * r[2] : 0.0;
+        // Derivatives of f (-5 f r_j / r^2) and g ((10 z dz - 2 g r_j) / r^2)
+        double d_f = -5.0 * r[j] * (g - c[i]);
+        double d_g = z_term - 2.0 * g * r[j];
+        jacobian.elements[3 + i][j] +=
+            f * (identity * (g - c[i]) + r[i] * (d_f + d_g) / rmag_sq);
+      }
+    }
+  }
+}
+
+/*
+Add the partial derivatives of central-body gravity acceleration with respect to
+spacecraft position into a state Jacobian
+
+@param state Spacecraft ICRF state at which to calculate the partials
+@param jacobian State Jacobian to which the partials are added
+*/
+void GravityModel::partials(ICRF &state, Matrix6 &jacobian) {
+  spherical_partials(state.position, jacobian);
+  if (is_aspherical) {
+    aspherical_partials(state, jacobian);
+  }
+}
+
+/*
+Add the partial derivatives of third-body gravity acceleration with respect to
+spacecraft position into a state Jacobian
+
+@param state Spacecraft ICRF state at which to calculate the partials
+@param body_position Position of the body relative to the spacecraft's central
+body
+@param jacobian State Jacobian to which the partials are added
+*/
+void GravityModel::partials(ICRF &state, Vector3 &body_position,
+                            Matrix6 &jacobian) {
+  // Central body gravity does not depend on the body position
+  if (state.central_body.id() == body.id()) {
+    partials(state, jacobian);
+    return;
+  }
+  // The indirect term does not depend on spacecraft position
+  Vector3 relative_position = state.position - body_position;
+  spherical_partials(relative_position, jacobian);
+  if (is_aspherical) {
+    aspherical_partials(state, jacobian);
+  }
+}
+
 /*
 GravityModel operator functions
 */
@@ -0,0 +1,90 @@
+#include <solar_radiation.h>
+
+#include <algorithm>
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+// Default constructor
+SolarRadiationModel::SolarRadiationModel() {
+    this->shadow_model = Conical;
+    this->mass = 1000;
+    this->area = 4;
+    this->cr = 1.2;
+}
+
+// Direct constructor
+SolarRadiationModel::SolarRadiationModel(ShadowModel model, double mass, double area, double cr) {
+    this->shadow_model = model;
+    this->mass = mass;
+    this->area = area;
+    this->cr = cr;
+}
+
+// Calculate the fraction of the solar disk visible from the spacecraft
+double SolarRadiationModel::illumination(ICRF& sc_state, Vector3& sun_position) {
+    // A heliocentric spacecraft has no occulting body
+    if (sc_state.central_body.id() == SUN.id()) {
+        return 1.0;
+    }
+    double body_radius = sc_state.central_body.radius_equator();
+    double sun_dist = sun_position.mag();
+    // Distance of the spacecraft along the Sun direction (negative behind the body)
+    double s = sc_state.position.dot(sun_position) / sun_dist;
+    // Spacecraft is on the sunlit side of the body
+    if (s >= 0.0) {
+        return 1.0;
+    }
+    // Squared distance of the spacecraft from the shadow axis
+    double axis_dist_sq = sc_state.position.dot(sc_state.position) - s * s;
+    // Radius of the penumbra cone at this distance behind the body, the
+    // cone half-angle given by sin(f) = (R_sun + R_body) / sun_dist
+    double k = (SUN.radius_equator() + body_radius) / sun_dist;
+    double penumbra_radius = (body_radius - s * k) / sqrt(1.0 - k * k);
+    // Spacecraft is outside of the penumbra cone, avoid any trigonometry
+    if (axis_dist_sq > penumbra_radius * penumbra_radius) {
+        return 1.0;
+    }
+    if (shadow_model == Cylindrical) {
+        return axis_dist_sq > body_radius * body_radius ? 1.0 : 0.0;
+    }
+    // Position of the Sun relative to the spacecraft
+    Vector3 sun_rel = sun_position - sc_state.position;
+    double sun_rel_mag = sun_rel.mag();
+    double sc_mag = sc_state.position.mag();
+    // Apparent radii of the Sun (a) and body (b), and their apparent separation (c)
+    double a = asin(SUN.radius_equator() / sun_rel_mag);
+    double b = asin(std::min(body_radius / sc_mag, 1.0));
+    double cos_c = -sc_state.position.dot(sun_rel) / (sc_mag * sun_rel_mag);
+    double c = acos(std::max(-1.0, std::min(cos_c, 1.0)));
+    if (c >= a + b) {
+        // Disks do not overlap
+        return 1.0;
+    } else if (c <= b - a) {
+        // Umbra
+        return 0.0;
+    } else if (c <= a - b) {
+        // Annular eclipse, body disk lies entirely within the solar disk
+        return 1.0 - (b * b) / (a * a);
+    }
+    // Penumbra, partial overlap of the two disks
+    double x = (c * c + a * a - b * b) / (2.0 * c);
+    double y = sqrt(std::max(a * a - x * x, 0.0));
+    double overlap = a * a * acos(x / a) + b * b * acos((c - x) / b) - c * y;
+    return 1.0 - overlap / (M_PI * a * a);
+}
+
+// Calculate the acceleration due to solar radiation pressure
+Vector3 SolarRadiationModel::acceleration(ICRF& sc_state, Vector3& sun_position) {
+    double nu = illumination(sc_state, sun_position);
+    if (nu == 0.0) {
+        return Vector3{};
+    }
+    // Position of the spacecraft relative to the Sun
+    Vector3 sun_to_sc = sc_state.position - sun_position;
+    double dist = sun_to_sc.mag();
+    // Pressure scaled by the inverse square of the distance from the Sun
+    double f_mag = nu * SOLAR_PRESSURE_AU * cr * (area / mass) *
+                   pow(ASTRONOMICAL_UNIT / dist, 2);
+    // Acceleration is directed away from the Sun
+    return sun_to_sc.scale(f_mag / dist);
+}
\ No newline at end of file
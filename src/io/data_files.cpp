@@ -1,4 +1,24 @@
 #include <data_files.h>
+#include <exceptions.h>
+#include <math_utils.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+// Compile-time checks of the built-in leap second table
+static constexpr bool leap_seconds_increasing(size_t i = 1) {
+  return i >= LEAP_SECOND_COUNT ||
+         (LEAP_SECONDS[i - 1].start < LEAP_SECONDS[i].start &&
+          leap_seconds_increasing(i + 1));
+}
+static_assert(leap_seconds_increasing(),
+              "Built-in leap seconds must be in increasing order");
+static_assert(builtin_leap_seconds(0.0) == 32.0,
+              "Built-in leap seconds must give TAI-UTC = 32 s at J2000");
+
+// Shared data file handler instance
+DataFileHandler DATA_FILES{};
 
 /*
 DataFileHandler methods
@@ -7,59 +27,139 @@ DataFileHandler methods
 // Default constructor
 DataFileHandler::DataFileHandler() {
   this->leap_seconds = std::vector<std::array<double, 2>>{};
+  for (size_t i = 0; i < LEAP_SECOND_COUNT; i++) {
+    leap_seconds.push_back(
+        std::array<double, 2>{LEAP_SECONDS[i].start, LEAP_SECONDS[i].offset});
+  }
+  build_leap_second_table();
   this->finals_data = std::vector<std::array<double, 7>>{};
 }
 
-// Read/parse the leap seconds file
-void DataFileHandler::parse_leap_seconds() {
-  // Read the leap second file
-  std::vector<std::string> lines = read_lines_from_file("data/leap_second.txt");
-  // Iterate through the leap seconds file
-  for (std::string l : lines) {
-    float secs, val;
-    // Grab the J2000+ seconds and leap values from the line
-    sscanf(l.c_str(), "%f %f", &secs, &val);
-    // Sanity check
-    if (secs != 0 && val != 0) {
-      // Add the values to the known leap seconds
-      std::array<double, 2> values{(double)secs, (double)val};
-      leap_seconds.push_back(values);
+// Rebuild the leap second segments from the leap_seconds vector
+void DataFileHandler::build_leap_second_table() {
+  leap_second_table.clear();
+  for (std::array<double, 2> &leap : leap_seconds) {
+    leap_second_table.push_back(OffsetSegment{leap[0], leap[1], 0.0});
+  }
+}
+
+// Replace the leap seconds with those of a leap seconds file
+void DataFileHandler::load_leap_seconds(const char filename[]) {
+  std::vector<std::string> lines = read_lines_from_file(filename);
+  std::vector<std::array<double, 2>> loaded{};
+  for (std::string &l : lines) {
+    // Grab the J2000+ seconds and leap values from the line (in double
+    // precision, a float cannot hold the seconds exactly)
+    const char *start = l.c_str();
+    char *end;
+    double secs = strtod(start, &end);
+    if (end == start) {
+      continue;
+    }
+    start = end;
+    double val = strtod(start, &end);
+    if (end == start) {
+      continue;
     }
+    if (loaded.size() > 0 && secs <= loaded[loaded.size() - 1][0]) {
+      std::stringstream msg;
+      msg << "DataFileHandler::load_leap_seconds exception: Leap seconds in '"
+          << filename << "' are not in increasing order";
+      throw ArcException(msg.str());
+    }
+    loaded.push_back(std::array<double, 2>{secs, val});
+  }
+  if (loaded.size() == 0) {
+    std::stringstream msg;
+    msg << "DataFileHandler::load_leap_seconds exception: No leap seconds in '"
+        << filename << "'";
+    throw ArcException(msg.str());
   }
+  leap_seconds = loaded;
+  build_leap_second_table();
 }
 
 // Get the number of leap seconds used in offset
 double DataFileHandler::get_leap_seconds(double seconds_since_j2000) {
-  // If the leap seconds file has not yet been read
-  if (leap_seconds.size() == 0) {
-    parse_leap_seconds();
+  // Zero before the first leap second, the last value after the last
+  return leap_second_table.offset(seconds_since_j2000);
+}
+
+// Read a fixed-width column of a finals.all line (1-based first column)
+static bool finals_column(const std::string &line, size_t first,
+                          size_t width, double &value) {
+  if (line.size() < first - 1 + width) {
+    return false;
   }
-  // If the requested time is after the last known leap second
-  if (seconds_since_j2000 > leap_seconds[leap_seconds.size() - 1][0]) {
-    // Return the latest leap second value
-    return leap_seconds[leap_seconds.size() - 1][1];
-  } else if (seconds_since_j2000 < leap_seconds[0][0]) {
-    // If the requested time is before the first known leap second
-    return 0.0;
-  } else {
-    // Iterate through the known leap seconds, excluding the last (case is
-    // handled in first conditional)
-    for (int i = 0; i < leap_seconds.size() - 2; i++) {
-      // If the timestamp is between the current epoch and the next
-      if (leap_seconds[i][0] <= seconds_since_j2000 &&
-          seconds_since_j2000 < leap_seconds[i + 1][0]) {
-        // Return the leap second value
-        return leap_seconds[i][1];
-      }
+  std::string field = line.substr(first - 1, width);
+  const char *start = field.c_str();
+  char *end;
+  value = strtod(start, &end);
+  return end != start;
+}
+
+// Replace the Earth orientation parameters with those of a finals.all file
+void DataFileHandler::load_finals(const char filename[]) {
+  std::vector<std::string> lines = read_lines_from_file(filename);
+  std::vector<std::array<double, 7>> loaded{};
+  for (std::string &l : lines) {
+    double mjd, pm_x, pm_y, ut1_utc;
+    // Days past the predictions list only their dates
+    if (!finals_column(l, 8, 8, mjd) || !finals_column(l, 19, 9, pm_x) ||
+        !finals_column(l, 38, 9, pm_y) || !finals_column(l, 59, 10, ut1_utc)) {
+      continue;
+    }
+    double lod = 0.0, d_psi = 0.0, d_eps = 0.0;
+    finals_column(l, 80, 7, lod);
+    finals_column(l, 98, 9, d_psi);
+    finals_column(l, 117, 9, d_eps);
+    if (loaded.size() > 0 && mjd <= loaded[loaded.size() - 1][0]) {
+      std::stringstream msg;
+      msg << "DataFileHandler::load_finals exception: Dates in '" << filename
+          << "' are not in increasing order";
+      throw ArcException(msg.str());
     }
-    // This condition should never be met, but to be safe, return something if
-    // every conditional fails
-    return 0.0;
+    // Polar motion in arcseconds, length of day in milliseconds, and the
+    // nutation corrections in milliarcseconds
+    loaded.push_back(std::array<double, 7>{
+        mjd, arcsec_to_radians(pm_x), arcsec_to_radians(pm_y), ut1_utc,
+        lod * 1e-3, marcsec_to_radians(d_psi),
+        marcsec_to_radians(d_eps)});
   }
+  if (loaded.size() == 0) {
+    std::stringstream msg;
+    msg << "DataFileHandler::load_finals exception: No Earth orientation "
+        << "parameters in '" << filename << "'";
+    throw ArcException(msg.str());
+  }
+  finals_data = loaded;
 }
 
 // Get the finals.all data at an epoch (modified Julian)
 std::array<double, 7> DataFileHandler::get_finals(double mjd) {
-  // Placeholder
-  return std::array<double, 7>{0, 0, 0, 0, 0, 0, 0};
+  if (finals_data.size() == 0) {
+    return std::array<double, 7>{0, 0, 0, 0, 0, 0, 0};
+  }
+  // First entry after the epoch
+  std::vector<std::array<double, 7>>::iterator next = std::upper_bound(
+      finals_data.begin(), finals_data.end(), mjd,
+      [](double value, const std::array<double, 7> &entry) {
+        return value < entry[0];
+      });
+  // Hold the first and last entries outside the table
+  if (next == finals_data.begin()) {
+    return finals_data[0];
+  }
+  if (next == finals_data.end()) {
+    return finals_data[finals_data.size() - 1];
+  }
+  std::array<double, 7> &before = *(next - 1);
+  std::array<double, 7> &after = *next;
+  double fraction = (mjd - before[0]) / (after[0] - before[0]);
+  std::array<double, 7> finals;
+  finals[0] = mjd;
+  for (size_t i = 1; i < finals.size(); i++) {
+    finals[i] = before[i] + fraction * (after[i] - before[i]);
+  }
+  return finals;
 }
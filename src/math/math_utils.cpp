@@ -23,20 +23,6 @@ double marcsec_to_radians(double marcsec) {
     return marcsec * (1.0 / 60.0 / 60.0 / 10000.0) * M_PI / 180;
 }
 
-// Evaluate a polynomial given a variable (x) and its coefficients
-// Exponents start at zero and increase to the order given by the length of
-// 'coeffs'
-double eval_poly(double x, std::vector<double> coeffs) {
-  // Total value of the expression
-  double output = 0.0;
-  // Add the value of ax^i to the output variable,
-  // where a is the value stored in coeffs[i]
-  for (int n = 0; n < coeffs.size(); n++) {
-    output += coeffs[n] * pow(x, n);
-  }
-  return output;
-}
-
 // Return the angle (original or inverse) that exists in the half plane of the
 // match argument (m)
 double match_half_plane(double angle, double m) {
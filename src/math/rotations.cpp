@@ -0,0 +1,197 @@
+#include <rotations.h>
+
+#include <math.h>
+
+/*
+Quaternion methods
+*/
+
+// Default constructor
+Quaternion::Quaternion() : w{ 1.0 }, x{ 0.0 }, y{ 0.0 }, z{ 0.0 } {}
+
+// Constructor using components
+Quaternion::Quaternion(double w, double x, double y, double z)
+  : w{ w }, x{ x }, y{ y }, z{ z } {}
+
+// Constructor using a rotation matrix
+Quaternion::Quaternion(const Matrix3& m) {
+  // Start from the largest component to avoid dividing by a small number
+  const double (&e)[3][3] = m.elements;
+  double trace = e[0][0] + e[1][1] + e[2][2];
+  if (trace >= e[0][0] && trace >= e[1][1] && trace >= e[2][2]) {
+    double s = 2.0 * sqrt(1.0 + trace);
+    w = 0.25 * s;
+    x = (e[2][1] - e[1][2]) / s;
+    y = (e[0][2] - e[2][0]) / s;
+    z = (e[1][0] - e[0][1]) / s;
+  }
+  else if (e[0][0] >= e[1][1] && e[0][0] >= e[2][2]) {
+    double s = 2.0 * sqrt(1.0 + e[0][0] - e[1][1] - e[2][2]);
+    w = (e[2][1] - e[1][2]) / s;
+    x = 0.25 * s;
+    y = (e[0][1] + e[1][0]) / s;
+    z = (e[0][2] + e[2][0]) / s;
+  }
+  else if (e[1][1] >= e[2][2]) {
+    double s = 2.0 * sqrt(1.0 + e[1][1] - e[0][0] - e[2][2]);
+    w = (e[0][2] - e[2][0]) / s;
+    x = (e[0][1] + e[1][0]) / s;
+    y = 0.25 * s;
+    z = (e[1][2] + e[2][1]) / s;
+  }
+  else {
+    double s = 2.0 * sqrt(1.0 + e[2][2] - e[0][0] - e[1][1]);
+    w = (e[1][0] - e[0][1]) / s;
+    x = (e[0][2] + e[2][0]) / s;
+    y = (e[1][2] + e[2][1]) / s;
+    z = 0.25 * s;
+  }
+}
+
+// Multiply by another Quaternion (this * q)
+Quaternion Quaternion::multiply(const Quaternion& q) const {
+  return Quaternion{ w * q.w - x * q.x - y * q.y - z * q.z,
+                     w * q.x + x * q.w + y * q.z - z * q.y,
+                     w * q.y - x * q.z + y * q.w + z * q.x,
+                     w * q.z + x * q.y - y * q.x + z * q.w };
+}
+
+// Calculate the conjugate
+Quaternion Quaternion::conjugate() const {
+  return Quaternion{ w, -x, -y, -z };
+}
+
+// Scale to unit magnitude
+Quaternion Quaternion::normalize() const {
+  double mag = sqrt(w * w + x * x + y * y + z * z);
+  return Quaternion{ w / mag, x / mag, y / mag, z / mag };
+}
+
+// Rotate a Vector3
+Vector3 Quaternion::rotate(const Vector3& v) const {
+  // v + 2w(u x v) + 2u x (u x v), with u the vector part
+  Vector3 u{ x, y, z };
+  Vector3 t = u.cross(v).scale(2.0);
+  return v + t * w + u.cross(t);
+}
+
+// Convert to the equivalent rotation matrix
+Matrix3 Quaternion::to_matrix() const {
+  double xx = x * x, yy = y * y, zz = z * z;
+  double xy = x * y, xz = x * z, yz = y * z;
+  double wx = w * x, wy = w * y, wz = w * z;
+  Matrix3 m;
+  m.elements[0][0] = 1.0 - 2.0 * (yy + zz);
+  m.elements[0][1] = 2.0 * (xy - wz);
+  m.elements[0][2] = 2.0 * (xz + wy);
+  m.elements[1][0] = 2.0 * (xy + wz);
+  m.elements[1][1] = 1.0 - 2.0 * (xx + zz);
+  m.elements[1][2] = 2.0 * (yz - wx);
+  m.elements[2][0] = 2.0 * (xz - wy);
+  m.elements[2][1] = 2.0 * (yz + wx);
+  m.elements[2][2] = 1.0 - 2.0 * (xx + yy);
+  return m;
+}
+
+/*
+Rotation methods
+*/
+
+// Default constructor
+Rotation::Rotation() : matrix{ 1.0 }, rate{} {}
+
+// Constructor using a matrix and its rate
+Rotation::Rotation(const Matrix3& matrix, const Matrix3& rate)
+  : matrix{ matrix }, rate{ rate } {}
+
+// Compose with a rotation applied after this one
+Rotation Rotation::then(const Rotation& next) const {
+  // d(N M)/dt = N' M + N M'
+  return Rotation{ next.matrix * matrix,
+                   next.rate * matrix + next.matrix * rate };
+}
+
+// Calculate the inverse rotation
+Rotation Rotation::inverse() const {
+  return Rotation{ matrix.transpose(), rate.transpose() };
+}
+
+// Rotate a position (or any fixed vector)
+Vector3 Rotation::apply(const Vector3& position) const {
+  return matrix.multiply(position);
+}
+
+// Rotate a velocity, including the rate of the rotation
+Vector3 Rotation::apply_velocity(const Vector3& position,
+                                 const Vector3& velocity) const {
+  const double (&m)[3][3] = matrix.elements;
+  const double (&d)[3][3] = rate.elements;
+  const Vector3 &r = position, &v = velocity;
+  return Vector3{
+    m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z +
+      d[0][0] * r.x + d[0][1] * r.y + d[0][2] * r.z,
+    m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z +
+      d[1][0] * r.x + d[1][1] * r.y + d[1][2] * r.z,
+    m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z +
+      d[2][0] * r.x + d[2][1] * r.y + d[2][2] * r.z };
+}
+
+// Convert the rotation matrix to a quaternion
+Quaternion Rotation::to_quaternion() const { return Quaternion{ matrix }; }
+
+/*
+Elementary frame rotations
+*/
+
+// Build an elementary rotation about one axis (0, 1, or 2)
+static Rotation elementary_rotation(int axis, double theta, double theta_rate) {
+  double cos_t = cos(theta);
+  double sin_t = sin(theta);
+  // The other two axes, in cyclic order
+  int i = (axis + 1) % 3, j = (axis + 2) % 3;
+  Matrix3 matrix;
+  matrix.elements[axis][axis] = 1.0;
+  matrix.elements[i][i] = cos_t;
+  matrix.elements[i][j] = sin_t;
+  matrix.elements[j][i] = -sin_t;
+  matrix.elements[j][j] = cos_t;
+  Matrix3 rate;
+  if (theta_rate != 0.0) {
+    rate.elements[i][i] = -sin_t * theta_rate;
+    rate.elements[i][j] = cos_t * theta_rate;
+    rate.elements[j][i] = -cos_t * theta_rate;
+    rate.elements[j][j] = -sin_t * theta_rate;
+  }
+  return Rotation{ matrix, rate };
+}
+
+// Rotate the coordinate frame about the x-axis
+Rotation rotation_x(double theta, double theta_rate) {
+  return elementary_rotation(0, theta, theta_rate);
+}
+
+// Rotate the coordinate frame about the y-axis
+Rotation rotation_y(double theta, double theta_rate) {
+  return elementary_rotation(1, theta, theta_rate);
+}
+
+// Rotate the coordinate frame about the z-axis
+Rotation rotation_z(double theta, double theta_rate) {
+  return elementary_rotation(2, theta, theta_rate);
+}
+
+/*
+Rotation operator functions
+*/
+
+// I/O stream
+std::ostream& operator << (std::ostream& out, const Quaternion& q) {
+  out << "[Quaternion] { W: " << q.w << ", X: " << q.x << ", Y: " << q.y
+      << ", Z: " << q.z << " }";
+  return out;
+}
+
+// Quaternion product
+Quaternion operator * (const Quaternion& q_1, const Quaternion& q_2) {
+  return q_1.multiply(q_2);
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include <parallel.h>
+
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Determine the number of worker threads to use
+unsigned worker_count(unsigned requested, size_t count) {
+  unsigned threads = requested;
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+  if (count < threads) {
+    threads = count > 0 ? (unsigned)count : 1;
+  }
+  return threads;
+}
+
+// Run a function over the index range [0, count) split into contiguous chunks
+void parallel_for(size_t count, unsigned threads,
+                  std::function<void(size_t, size_t)> fn) {
+  if (count == 0) {
+    return;
+  }
+  unsigned n_workers = worker_count(threads, count);
+  // Run on the calling thread if there is nothing to split
+  if (n_workers == 1) {
+    fn(0, count);
+    return;
+  }
+  // First exception thrown by any of the workers
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  std::vector<std::thread> workers;
+  size_t chunk = count / n_workers;
+  size_t remainder = count % n_workers;
+  size_t begin = 0;
+  for (unsigned w = 0; w < n_workers; w++) {
+    // Spread the remainder over the first chunks
+    size_t end = begin + chunk + (w < remainder ? 1 : 0);
+    workers.push_back(std::thread([&fn, &error, &error_mutex, begin, end]() {
+      try {
+        fn(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }));
+    begin = end;
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
\ No newline at end of file
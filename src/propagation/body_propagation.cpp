@@ -20,56 +20,38 @@ BodyPropagationHandler::BodyPropagationHandler() {
   this->neptune = Ephemeris{};
 }
 
+// Load an ephemeris file exactly once, even when called from several threads
+Ephemeris& BodyPropagationHandler::load_once(Ephemeris& ephem,
+                                             std::once_flag& loaded,
+                                             const char filepath[]) {
+  // If loading throws, the flag is left unset and the next call retries
+  std::call_once(loaded, [&ephem, filepath]() { ephem = Ephemeris{filepath}; });
+  return ephem;
+}
+
 // Returns a planetary ephemeris file, loading it from disk if necessary
 Ephemeris& BodyPropagationHandler::get_ephem(int id) {
   // TODO: Functionally determine ephemeris location
   // Use temporary ephemeris file locations (will be set by variable later)
   switch (id) {
     case 199:
-      if (mercury.states.size() == 0) {
-        mercury = Ephemeris{"data/planetary/mercury.txt"};
-      }
-      return mercury;
+      return load_once(mercury, mercury_loaded, "data/planetary/mercury.txt");
     case 299:
-      if (venus.states.size() == 0) {
-        venus = Ephemeris{"data/planetary/venus.txt"};
-      }
-      return venus;
+      return load_once(venus, venus_loaded, "data/planetary/venus.txt");
     case 399:
-      if (earth.states.size() == 0) {
-        earth = Ephemeris{"data/planetary/earth.txt"};
-      }
-      return earth;
+      return load_once(earth, earth_loaded, "data/planetary/earth.txt");
     case 301:
-      if (luna.states.size() == 0) {
-        luna = Ephemeris{"data/planetary/luna.txt"};
-      }
-      return luna;
+      return load_once(luna, luna_loaded, "data/planetary/luna.txt");
     case 499:
-      if (mars.states.size() == 0) {
-        mars = Ephemeris{"data/planetary/mars.txt"};
-      }
-      return mars;
+      return load_once(mars, mars_loaded, "data/planetary/mars.txt");
     case 599:
-      if (jupiter.states.size() == 0) {
-        jupiter = Ephemeris{"data/planetary/jupiter.txt"};
-      }
-      return jupiter;
+      return load_once(jupiter, jupiter_loaded, "data/planetary/jupiter.txt");
     case 699:
-      if (saturn.states.size() == 0) {
-        saturn = Ephemeris{"data/planetary/saturn.txt"};
-      }
-      return saturn;
+      return load_once(saturn, saturn_loaded, "data/planetary/saturn.txt");
     case 799:
-      if (uranus.states.size() == 0) {
-        uranus = Ephemeris{"data/planetary/uranus.txt"};
-      }
-      return uranus;
+      return load_once(uranus, uranus_loaded, "data/planetary/uranus.txt");
     case 899:
-      if (neptune.states.size() == 0) {
-        neptune = Ephemeris{"data/planetary/neptune.txt"};
-      }
-      return neptune;
+      return load_once(neptune, neptune_loaded, "data/planetary/neptune.txt");
     default:
       std::stringstream msg;
       msg << "BodyPropagator::get_ephem exception: No ephemeris found for NAIF "
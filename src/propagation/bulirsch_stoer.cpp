@@ -0,0 +1,159 @@
+#include <bulirsch_stoer.h>
+
+#include <exceptions.h>
+
+#include <algorithm>
+#include <math.h>
+
+/*
+Bulirsch-Stoer propagator methods
+*/
+
+// Direct constructor (default settings)
+BulirschStoerPropagator::BulirschStoerPropagator(ICRF initial_state)
+  : NumericalPropagator{ initial_state } {
+  this->step_size = 3600.0;
+  this->trial_step = step_size;
+  this->rejections = 0;
+  set_tolerance(1e-12);
+}
+
+// Direct constructor (full settings)
+BulirschStoerPropagator::BulirschStoerPropagator(ICRF initial_state,
+  double step_size, ForceModel force_model)
+  : NumericalPropagator{ initial_state, step_size, force_model } {
+  this->trial_step = step_size;
+  this->rejections = 0;
+  set_tolerance(1e-12);
+}
+
+// Change the tolerance and select the matching initial order
+void BulirschStoerPropagator::set_tolerance(double tolerance) {
+  if (!(tolerance > 0.0)) {
+    throw ArcException(
+      "BulirschStoerPropagator::set_tolerance exception: Tolerance must be "
+      "positive");
+  }
+  this->tolerance = std::max(tolerance, BS_MIN_TOLERANCE);
+  int column = (int)(-0.6 * log10(this->tolerance) + 0.5);
+  this->target_column = std::max(1, std::min(BS_MAX_COLUMNS - 2, column));
+}
+
+// Integrate the offset from a state over a step with the modified midpoint
+// rule
+Vector6 BulirschStoerPropagator::midpoint(ICRF &state, double step,
+  int substeps, Vector6 &f_0) {
+  double h = step / substeps;
+  Vector6 z_prev{};
+  Vector6 z = f_0.scale(h);
+  for (int m = 1; m < substeps; m++) {
+    Vector6 f = derivatives(state, m * h, z).scale(2.0 * h);
+    Vector6 z_next = z_prev.add(f);
+    z_prev = z;
+    z = z_next;
+  }
+  // Gragg's smoothing of the final point
+  Vector6 f = derivatives(state, step, z).scale(h);
+  Vector6 sum = z.add(z_prev);
+  sum = sum.add(f);
+  return sum.scale(0.5);
+}
+
+// Take one adaptive extrapolation step
+ICRF BulirschStoerPropagator::extrapolation_step(ICRF &state, double limit,
+  double &taken) {
+  // Substeps, cumulative force evaluations, step estimates, and work per
+  // second of each column
+  int n[BS_MAX_COLUMNS];
+  double evals[BS_MAX_COLUMNS], steps[BS_MAX_COLUMNS], work[BS_MAX_COLUMNS];
+  for (int k = 0; k < BS_MAX_COLUMNS; k++) {
+    n[k] = 2 * (k + 1);
+    evals[k] = (k == 0) ? n[k] + 1 : evals[k - 1] + n[k];
+  }
+  Vector6 table[BS_MAX_COLUMNS][BS_MAX_COLUMNS];
+  Vector6 zero{};
+  Vector6 f_0 = derivatives(state, 0.0, zero);
+  double scale_r = tolerance * state.position.mag();
+  double scale_v = tolerance * state.velocity.mag();
+  while (true) {
+    bool truncated = trial_step >= fabs(limit);
+    double step = truncated ? limit : copysign(trial_step, limit);
+    int last = std::min(target_column + 1, BS_MAX_COLUMNS - 1);
+    int accepted = -1;
+    for (int k = 0; k <= last; k++) {
+      table[k][0] = midpoint(state, step, n[k], f_0);
+      // Polynomial extrapolation in the squared substep size
+      for (int j = 1; j <= k; j++) {
+        double ratio = (double)n[k] / n[k - j];
+        Vector6 diff = table[k][j - 1] - table[k - 1][j - 1];
+        diff = diff / (ratio * ratio - 1.0);
+        table[k][j] = table[k][j - 1].add(diff);
+      }
+      if (k == 0) {
+        continue;
+      }
+      Vector6 delta = table[k][k] - table[k][k - 1];
+      double err_r = std::max(std::max(fabs(delta.a), fabs(delta.b)),
+                              fabs(delta.c)) / scale_r;
+      double err_v = std::max(std::max(fabs(delta.x), fabs(delta.y)),
+                              fabs(delta.z)) / scale_v;
+      double err = std::max(err_r, err_v);
+      // Step that would meet the tolerance with this column
+      double factor = 0.94 * pow(0.65 / err, 1.0 / (2 * k + 1));
+      if (!(factor == factor)) {
+        factor = 0.02;
+      }
+      factor = std::max(0.02, std::min(4.0, factor));
+      steps[k] = fabs(step) * factor;
+      work[k] = evals[k] / steps[k];
+      if (k >= target_column - 1 && err <= 1.0) {
+        accepted = k;
+        break;
+      }
+    }
+    if (accepted < 0) {
+      // Retry with the step suggested by the highest column
+      rejections += 1;
+      trial_step = std::min(steps[last], 0.5 * fabs(step));
+      continue;
+    }
+    // Choose the column for the next step by the work per second
+    int k = accepted;
+    double next_step = steps[k];
+    if (k >= 2 && work[k - 1] < 0.8 * work[k]) {
+      target_column = k - 1;
+      next_step = steps[k - 1];
+    }
+    else if (k + 1 <= BS_MAX_COLUMNS - 2 && (k == 1 || work[k] < 0.9 * work[k - 1])) {
+      target_column = k + 1;
+      next_step = steps[k] * evals[k + 1] / evals[k];
+    }
+    else {
+      target_column = k;
+    }
+    // A step shortened to meet the end of the integration says little
+    // about the step the dynamics allow
+    next_step = std::min(next_step, step_size);
+    trial_step = truncated ? std::max(trial_step, next_step) : next_step;
+    taken = step;
+    Vector6 pos_vel{ state.position, state.velocity };
+    std::array<Vector3, 2> final_vectors = (pos_vel + table[k][k]).split();
+    DateTime new_epoch = state.epoch.increment(step);
+    return ICRF{ state.central_body, new_epoch, final_vectors[0],
+                 final_vectors[1] };
+  }
+}
+
+// Step the integration a number of seconds forward/backward
+ICRF BulirschStoerPropagator::integrate(ICRF &state, double step) {
+  ICRF current = state;
+  double remaining = step;
+  while (remaining != 0.0) {
+    double taken = 0.0;
+    current = extrapolation_step(current, remaining, taken);
+    remaining = (taken == remaining) ? 0.0 : remaining - taken;
+  }
+  // Sub-steps are summed from the start to avoid accumulating epoch rounding
+  current.epoch = state.epoch.increment(step);
+  return current;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <encke.h>
+
+#include <keplerian.h>
+
+#include <math.h>
+
+/*
+Encke propagator methods
+*/
+
+// Direct constructor (default settings)
+EnckePropagator::EnckePropagator(ICRF initial_state)
+  : NumericalPropagator{ initial_state } {
+  this->reference_state = initial_state;
+  this->deviation = Vector6{};
+  this->rectify_tolerance = 1e-3;
+  this->rectifications = 0;
+}
+
+// Direct constructor (full settings)
+EnckePropagator::EnckePropagator(ICRF initial_state, double step_size,
+  ForceModel force_model)
+  : NumericalPropagator{ initial_state, step_size, force_model } {
+  this->reference_state = initial_state;
+  this->deviation = Vector6{};
+  this->rectify_tolerance = 1e-3;
+  this->rectifications = 0;
+}
+
+// Calculate the derivative of the deviation from a reference orbit
+Vector6 EnckePropagator::deviation_derivatives(ICRF &reference, double tau,
+  Vector6 &delta) {
+  double mu = reference.central_body.mu();
+  // Reference orbit at tau
+  Vector3 rho, rho_dot;
+  propagate_universal(mu, reference.position, reference.velocity, tau, rho,
+                      rho_dot);
+  std::array<Vector3, 2> vectors = delta.split();
+  Vector3 delta_r = vectors[0];
+  Vector3 delta_v = vectors[1];
+  // Full state
+  Vector3 r = rho.add(delta_r);
+  Vector3 v = rho_dot.add(delta_v);
+  DateTime epoch = reference.epoch.increment(tau);
+  ICRF state{ reference.central_body, epoch, r, v };
+  // Difference of the two-body accelerations, using Battin's f(q) to avoid
+  // subtracting nearly equal terms
+  double r_2 = r.dot(r);
+  Vector3 two_r_minus = r.scale(2.0);
+  two_r_minus = delta_r - two_r_minus;
+  double q = delta_r.dot(two_r_minus) / r_2;
+  double f_q = q * (3.0 + 3.0 * q + q * q) / (1.0 + pow(1.0 + q, 1.5));
+  double rho_mag = rho.mag();
+  Vector3 f_r = r.scale(f_q);
+  Vector3 two_body = delta_r.add(f_r).scale(-mu / (rho_mag * rho_mag * rho_mag));
+  // Perturbing acceleration is the full force model less the point-mass
+  // central body term
+  Vector3 central = r.scale(mu / (r_2 * sqrt(r_2)));
+  Vector3 perturbing = force_model.acceleration(state).add(central);
+  Vector3 accel = two_body.add(perturbing);
+  return Vector6{ delta_v, accel };
+}
+
+// Step the deviation from a reference orbit a number of seconds
+// forward/backward
+ICRF EnckePropagator::step_deviation(ICRF &reference, double tau,
+  Vector6 &delta, double step) {
+  Vector6 k1 = deviation_derivatives(reference, tau, delta).scale(step);
+  Vector6 w_k1 = k1 / 2.0;
+  Vector6 y2 = delta + w_k1;
+  Vector6 k2 = deviation_derivatives(reference, tau + step / 2.0, y2).scale(step);
+  Vector6 w_k2 = k2 / 2.0;
+  Vector6 y3 = delta + w_k2;
+  Vector6 k3 = deviation_derivatives(reference, tau + step / 2.0, y3).scale(step);
+  Vector6 y4 = delta + k3;
+  Vector6 k4 = deviation_derivatives(reference, tau + step, y4).scale(step);
+  // Start combined vector and add weighted values
+  k2 = k2 * 2;
+  k3 = k3 * 2;
+  Vector6 total = k1 + k2;
+  total = total + k3;
+  total = total + k4;
+  total = total / 6;
+  delta = delta + total;
+  // Full state is the reference orbit plus the deviation
+  Vector3 rho, rho_dot;
+  propagate_universal(reference.central_body.mu(), reference.position,
+                      reference.velocity, tau + step, rho, rho_dot);
+  std::array<Vector3, 2> vectors = delta.split();
+  Vector3 r = rho.add(vectors[0]);
+  Vector3 v = rho_dot.add(vectors[1]);
+  DateTime new_epoch = reference.epoch.increment(tau + step);
+  return ICRF{ reference.central_body, new_epoch, r, v };
+}
+
+// Propagate the inital state to specified epoch
+ICRF EnckePropagator::propagate(DateTime &epoch) {
+  // Do this until the requested epoch has been reached
+  while (epoch.equals(cache_state.epoch) != true) {
+    // Get the difference between the requested epoch and the cached epoch
+    double delta = epoch.difference(cache_state.epoch);
+    // Choose the smaller of the two (avoid overstepping the target epoch)
+    double mag = std::min(fabs(delta), step_size);
+    // Copy the sign to step in the correct direction
+    double step = copysign(mag, delta);
+    // Step the deviation from the reference orbit
+    double tau = cache_state.epoch.difference(reference_state.epoch);
+    cache_state = step_deviation(reference_state, tau, deviation, step);
+    // Land exactly on the requested epoch after the final step
+    if (mag == fabs(delta)) {
+      cache_state.epoch = epoch;
+    }
+    // Rectify once the deviation is no longer small
+    std::array<Vector3, 2> vectors = deviation.split();
+    Vector3 rho = cache_state.position - vectors[0];
+    if (vectors[0].mag() > rectify_tolerance * rho.mag()) {
+      reference_state = cache_state;
+      deviation = Vector6{};
+      rectifications += 1;
+    }
+  }
+  return cache_state;
+}
+
+// Step the integration a number of seconds forward/backward
+ICRF EnckePropagator::integrate(ICRF &state, double step) {
+  Vector6 delta{};
+  return step_deviation(state, 0.0, delta, step);
+}
\ No newline at end of file
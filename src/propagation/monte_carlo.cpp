@@ -0,0 +1,221 @@
+#include <monte_carlo.h>
+#include <exceptions.h>
+#include <file_io.h>
+#include <parallel.h>
+#include <rungekutta4.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <sstream>
+
+// Number of blocks into which trials are grouped for accumulation
+static const size_t MONTE_CARLO_BLOCKS = 32;
+
+/*
+State statistics methods
+*/
+
+// Default constructor
+StateStatistics::StateStatistics() {
+  this->epoch = DateTime{};
+  this->count = 0;
+  for (int i = 0; i < 6; i++) {
+    this->mean[i] = 0.0;
+  }
+  this->comoment = Matrix6{};
+}
+
+// Add a state to the statistics
+void StateStatistics::add(ICRF &state) {
+  double x[6] = {state.position.x, state.position.y, state.position.z,
+                 state.velocity.x, state.velocity.y, state.velocity.z};
+  count++;
+  // Deviation from the previous and the updated mean
+  double d_old[6], d_new[6];
+  for (int i = 0; i < 6; i++) {
+    d_old[i] = x[i] - mean[i];
+    mean[i] += d_old[i] / count;
+    d_new[i] = x[i] - mean[i];
+  }
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      comoment.elements[i][j] += d_old[i] * d_new[j];
+    }
+  }
+}
+
+// Combine with statistics accumulated from a separate set of states
+void StateStatistics::merge(StateStatistics &other) {
+  if (other.count == 0) {
+    return;
+  }
+  if (count == 0) {
+    // Keep this epoch, take everything else
+    count = other.count;
+    for (int i = 0; i < 6; i++) {
+      mean[i] = other.mean[i];
+    }
+    comoment = other.comoment;
+    return;
+  }
+  double total = (double)(count + other.count);
+  double delta[6];
+  for (int i = 0; i < 6; i++) {
+    delta[i] = other.mean[i] - mean[i];
+    mean[i] += delta[i] * other.count / total;
+  }
+  double weight = (double)count * other.count / total;
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      comoment.elements[i][j] +=
+          other.comoment.elements[i][j] + delta[i] * delta[j] * weight;
+    }
+  }
+  count += other.count;
+}
+
+// Calculate the sample covariance of the accumulated states
+Matrix6 StateStatistics::covariance() {
+  if (count < 2) {
+    return Matrix6{};
+  }
+  return comoment.scale(1.0 / (count - 1));
+}
+
+/*
+Monte Carlo propagator methods
+*/
+
+// Direct constructor
+MonteCarloPropagator::MonteCarloPropagator(ICRF initial_state, double step_size,
+                                           ForceModel force_model,
+                                           Dispersion dispersion,
+                                           size_t trials, std::uint64_t seed) {
+  this->initial_state = initial_state;
+  this->step_size = step_size;
+  this->force_model = force_model;
+  this->drag_model = DragModel{};
+  this->has_drag = false;
+  this->dispersion = dispersion;
+  this->trials = trials;
+  this->seed = seed;
+  this->threads = 0;
+}
+
+// Change the nominal drag model, enabling dispersion of its parameters
+void MonteCarloPropagator::set_drag_model(DragModel model) {
+  drag_model = model;
+  has_drag = true;
+  force_model.set_drag_model(model);
+}
+
+// Draw the initial state and force model of a trial
+void MonteCarloPropagator::sample(size_t trial, ICRF &state, ForceModel &fm) {
+  // Independent, reproducible stream for each (seed, trial) pair
+  std::seed_seq seq{(std::uint32_t)seed, (std::uint32_t)(seed >> 32),
+                    (std::uint32_t)trial,
+                    (std::uint32_t)((std::uint64_t)trial >> 32)};
+  std::mt19937_64 rng{seq};
+  std::normal_distribution<double> normal{0.0, 1.0};
+  // Draw in a fixed order so each trial is independent of the dispersions used
+  double draws[8];
+  for (int i = 0; i < 8; i++) {
+    draws[i] = normal(rng);
+  }
+  Vector3 d_pos{draws[0] * dispersion.position.x,
+                draws[1] * dispersion.position.y,
+                draws[2] * dispersion.position.z};
+  Vector3 d_vel{draws[3] * dispersion.velocity.x,
+                draws[4] * dispersion.velocity.y,
+                draws[5] * dispersion.velocity.z};
+  Vector3 pos = initial_state.position + d_pos;
+  Vector3 vel = initial_state.velocity + d_vel;
+  state = ICRF{initial_state.central_body, initial_state.epoch, pos, vel};
+  fm = force_model;
+  if (has_drag) {
+    DragModel drag = drag_model;
+    // Physical parameters cannot be negative, clip far tails of the draws
+    drag.cd = std::max(drag.cd + draws[6] * dispersion.drag_coeff, 0.0);
+    drag.area = std::max(drag.area + draws[7] * dispersion.area, 0.0);
+    fm.set_drag_model(drag);
+  }
+}
+
+// Propagate all trials over an interval and reduce them to statistics
+std::vector<StateStatistics> MonteCarloPropagator::step(DateTime &start,
+                                                        DateTime &stop,
+                                                        double step) {
+  // Output epochs
+  std::vector<DateTime> epochs;
+  DateTime t = start;
+  while (stop.difference(t) >= 0.0) {
+    epochs.push_back(t);
+    t = t.increment(step);
+  }
+  // Trials are split into a fixed number of blocks (independent of the number
+  // of threads), each block accumulating its own statistics
+  size_t n_blocks = std::min(trials, MONTE_CARLO_BLOCKS);
+  std::vector<std::vector<StateStatistics>> block_stats(
+      n_blocks, std::vector<StateStatistics>(epochs.size()));
+  parallel_for(n_blocks, threads, [&](size_t block_begin, size_t block_end) {
+    for (size_t b = block_begin; b < block_end; b++) {
+      size_t trial_begin = trials * b / n_blocks;
+      size_t trial_end = trials * (b + 1) / n_blocks;
+      for (size_t trial = trial_begin; trial < trial_end; trial++) {
+        ICRF trial_state;
+        ForceModel trial_fm;
+        sample(trial, trial_state, trial_fm);
+        RungeKutta4 propagator{trial_state, step_size, trial_fm};
+        for (size_t e = 0; e < epochs.size(); e++) {
+          ICRF state = propagator.propagate(epochs[e]);
+          block_stats[b][e].add(state);
+        }
+      }
+    }
+  });
+  // Merge the blocks in order
+  std::vector<StateStatistics> statistics(epochs.size());
+  for (size_t e = 0; e < epochs.size(); e++) {
+    statistics[e].epoch = epochs[e];
+    for (size_t b = 0; b < n_blocks; b++) {
+      statistics[e].merge(block_stats[b][e]);
+    }
+  }
+  return statistics;
+}
+
+// Write Monte Carlo statistics to a text summary
+void write_statistics(std::vector<StateStatistics> &statistics,
+                      const char filename[]) {
+  std::vector<std::string> lines;
+  lines.push_back("# Arc Monte Carlo summary");
+  std::stringstream trials;
+  trials << "# Trials " << (statistics.size() > 0 ? statistics[0].count : 0);
+  lines.push_back(trials.str());
+  lines.push_back(
+      "# Epoch (UTC), mean X Y Z VX VY VZ, standard deviation X Y Z VX VY VZ "
+      "(ICRF, m and m/s)");
+  for (StateStatistics &stats : statistics) {
+    Matrix6 cov = stats.covariance();
+    std::stringstream line;
+    line << stats.epoch.to_iso() << std::setprecision(14) << std::scientific;
+    for (int i = 0; i < 6; i++) {
+      line << " " << stats.mean[i];
+    }
+    for (int i = 0; i < 6; i++) {
+      line << " " << sqrt(cov.elements[i][i]);
+    }
+    lines.push_back(line.str());
+  }
+  try {
+    write_lines_to_file(lines, filename);
+  } catch (ArcException err) {
+    std::cout << err.what() << std::endl;
+    std::stringstream msg;
+    msg << "monte_carlo::write_statistics exception: Writing summary to file '"
+        << filename << "' failed";
+    throw ArcException(msg.str());
+  }
+}
\ No newline at end of file
@@ -2,23 +2,26 @@
 #include <ephemeris.h>
 #include <gravity.h>
 #include <drag.h>
+#include <exceptions.h>
 
 /*
 Base Propagator methods
 */
 
 // Return standard ICRF (this function overloaded by the derived class)
-ICRF Propagator::propagate(DateTime &epoch) { return ICRF{}; }
+ICRF Propagator::propagate(DateTime & /* epoch */) { return ICRF{}; }
 
 // Create an Ephemeris by propagating over an interval
 Ephemeris Propagator::step(DateTime &start, DateTime &stop, double step) {
+  Ephemeris ephem{};
+  ephem.reserve(step_count(start, stop, step));
   DateTime t = start;
-  std::vector<ICRF> states{};
   while (stop.difference(t) >= 0.0) {
-    states.push_back(propagate(t));
+    ICRF state = propagate(t);
+    ephem.push_back(state);
     t = t.increment(step);
   };
-  return Ephemeris{ states };
+  return ephem;
 }
 
 /*
@@ -31,6 +34,8 @@ NumericalPropagator::NumericalPropagator(ICRF initial_state) {
   this->step_size = 15.0;
   GravityModel central_grav {initial_state.central_body, J2, false, 0, 0};
   this->force_model = ForceModel {std::vector<GravityModel> {central_grav}, DragModel{}};
+  this->stm_cache_state = initial_state;
+  this->stm_cache = Matrix6{1.0};
 }
 
 // Direct constructor (full settings)
@@ -39,6 +44,8 @@ NumericalPropagator::NumericalPropagator(ICRF initial_state, double step_size, F
   this->cache_state = initial_state;
   this->step_size = step_size;
   this->force_model = force_model;
+  this->stm_cache_state = initial_state;
+  this->stm_cache = Matrix6{1.0};
 }
 
 // Calculate partial derivatives for numerical integration
@@ -57,6 +64,18 @@ Vector6 NumericalPropagator::derivatives(ICRF &state, double h, Vector6 &k) {
   return final;
 }
 
+// Calculate the derivative of the state transition matrix for numerical integration
+Matrix6 NumericalPropagator::variational(ICRF &state, double h, Vector6 &k, Matrix6 &stm) {
+  // Build the state at which to evaluate the force model Jacobian
+  DateTime new_epoch = state.epoch.increment(h);
+  Vector6 pos_vel = Vector6{state.position, state.velocity}.add(k);
+  std::array<Vector3, 2> vectors = pos_vel.split();
+  ICRF sample_state {state.central_body, new_epoch, vectors[0], vectors[1]};
+  // Variational equations: d(STM)/dt = A * STM
+  Matrix6 jacobian = force_model.jacobian(sample_state);
+  return jacobian.multiply(stm);
+}
+
 // Propagate the inital state to specified epoch
 ICRF NumericalPropagator::propagate(DateTime &epoch) {
   // Do this until the requested epoch has been reached
@@ -69,9 +88,64 @@ ICRF NumericalPropagator::propagate(DateTime &epoch) {
     double step = copysign(mag, delta);
     // Integrate the cached ICRf state +/- the step
     cache_state = integrate(cache_state, step);
+    // Land exactly on the requested epoch after the final step
+    if (mag == fabs(delta)) {
+      cache_state.epoch = epoch;
+    }
   }
   return cache_state;
 }
 
-// Step the integration a number of seconds forward/backward
-ICRF NumericalPropagator::integrate(ICRF &state, double step) { return state; }
\ No newline at end of file
+// Propagate the initial state and its state transition matrix to specified epoch
+ICRF NumericalPropagator::propagate_with_stm(DateTime &epoch, Matrix6 &stm) {
+  // Do this until the requested epoch has been reached
+  while (epoch.equals(stm_cache_state.epoch) != true) {
+    // Get the difference between the requested epoch and the cached epoch
+    double delta = epoch.difference(stm_cache_state.epoch);
+    // Choose the smaller of the two (avoid overstepping the target epoch)
+    double mag = std::min(fabs(delta), step_size);
+    // Copy the sign to step in the correct direction
+    double step = copysign(mag, delta);
+    // Integrate the cached state and state transition matrix +/- the step
+    stm_cache_state = integrate_with_stm(stm_cache_state, stm_cache, step);
+    // Land exactly on the requested epoch after the final step
+    if (mag == fabs(delta)) {
+      stm_cache_state.epoch = epoch;
+    }
+  }
+  stm = stm_cache;
+  return stm_cache_state;
+}
+
+// Propagate a batch of states to specified epoch
+void NumericalPropagator::propagate_batch(std::vector<ICRF> &states, DateTime &epoch) {
+  if (states.size() == 0) {
+    return;
+  }
+  // The batch shares a single epoch, so the first state tracks progress
+  while (epoch.equals(states[0].epoch) != true) {
+    // Get the difference between the requested epoch and the batch epoch
+    double delta = epoch.difference(states[0].epoch);
+    // Choose the smaller of the two (avoid overstepping the target epoch)
+    double mag = std::min(fabs(delta), step_size);
+    // Copy the sign to step in the correct direction
+    double step = copysign(mag, delta);
+    // Integrate every state in the batch +/- the same step
+    for (ICRF &state : states) {
+      state = integrate(state, step);
+      // Land exactly on the requested epoch after the final step
+      if (mag == fabs(delta)) {
+        state.epoch = epoch;
+      }
+    }
+  }
+}
+
+// Step the integration of the state and its state transition matrix a number of seconds forward/backward
+ICRF NumericalPropagator::integrate_with_stm(ICRF & /* state */,
+                                             Matrix6 & /* stm */,
+                                             double /* step */) {
+  throw ArcException(
+    "NumericalPropagator::integrate_with_stm exception: The state transition "
+    "matrix is not supported by this integrator");
+}
\ No newline at end of file
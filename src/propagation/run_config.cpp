@@ -1,19 +1,50 @@
+#include <bulirsch_stoer.h>
 #include <celestial.h>
+#include <conjunction.h>
+#include <covariance.h>
 #include <datetime.h>
 #include <ephemeris.h>
 #include <exceptions.h>
 #include <file_io.h>
 #include <force_model.h>
+#include <geodetic.h>
 #include <gravity.h>
 #include <drag.h>
+#include <earth_model.h>
+#include <encke.h>
 #include <icrf.h>
 #include <itrf.h>
+#include <matrices.h>
+#include <monte_carlo.h>
 #include <run_config.h>
 #include <rungekutta4.h>
+#include <semi_analytic.h>
+#include <sgp4.h>
+#include <solar_radiation.h>
+#include <sundman.h>
+#include <symplectic.h>
+#include <taylor.h>
+#include <time_scales.h>
+#include <tle.h>
+#include <unscented.h>
 #include <vectors.h>
 
+#include <fstream>
+#include <iomanip>
 #include <sstream>
 
+// Parse JSON representation of an initial two-line element set
+TwoLineElement parse_tle(nlohmann::json& json) {
+  nlohmann::json tle_json = json["INITIAL_STATE"]["TLE"];
+  if (tle_json["LINE_1"].is_null() || tle_json["LINE_2"].is_null()) {
+    throw ArcException(
+      "run_config::parse_tle exception: TLE requires LINE_1 and LINE_2");
+  }
+  std::string line_1 = tle_json["LINE_1"];
+  std::string line_2 = tle_json["LINE_2"];
+  return TwoLineElement{ line_1, line_2 };
+}
+
 // Parse JSON representation of initial ICRF state
 ICRF parse_state(nlohmann::json& json) {
   nlohmann::json state_json = json["INITIAL_STATE"];
@@ -54,6 +85,12 @@ ICRF parse_state(nlohmann::json& json) {
       throw ArcException(msg.str());
     }
   }
+  else if (!state_json["TLE"].is_null()) {
+    // Evaluate the element set at its epoch with SGP4
+    TwoLineElement tle = parse_tle(json);
+    SGP4Propagator propagator{ tle };
+    return propagator.propagate(tle.epoch);
+  }
   else {
     // Throw error if state type is not recognized
     throw ArcException(
@@ -61,6 +98,148 @@ ICRF parse_state(nlohmann::json& json) {
   }
 }
 
+// Parse JSON representation of the initial state covariance
+Matrix6 parse_covariance(nlohmann::json& json) {
+  nlohmann::json cov_json = json["COVARIANCE"];
+  // Only inertial covariances are supported
+  if (!cov_json["FRAME"].is_null()) {
+    std::string frame = cov_json["FRAME"];
+    if (frame != "ICRF" && frame != "J2000" && frame != "ECI") {
+      std::stringstream msg;
+      msg << "run_config::parse_covariance exception: Unsupported coordinate "
+        "frame '"
+        << frame << "'";
+      throw ArcException(msg.str());
+    }
+  }
+  nlohmann::json matrix = cov_json["MATRIX"];
+  if (!matrix.is_array() || matrix.size() != 6) {
+    throw ArcException(
+      "run_config::parse_covariance exception: MATRIX must have 6 rows");
+  }
+  Matrix6 cov;
+  for (int i = 0; i < 6; i++) {
+    if (!matrix[i].is_array() || matrix[i].size() != 6) {
+      throw ArcException(
+        "run_config::parse_covariance exception: MATRIX must have 6 columns");
+    }
+    for (int j = 0; j < 6; j++) {
+      cov.elements[i][j] = matrix[i][j];
+    }
+  }
+  return cov;
+}
+
+// Parse JSON representation of the Earth orientation model and apply it
+void parse_earth_orientation(nlohmann::json& json) {
+  if (json["MODEL"].is_null() || json["MODEL"] == "IAU_1980") {
+    set_earth_model(IAU_1980);
+    return;
+  }
+  if (json["MODEL"] != "IAU_2006") {
+    std::stringstream msg;
+    msg << "run_config::parse_earth_orientation exception: Unsupported "
+        << "Earth orientation model " << json["MODEL"];
+    throw ArcException(msg.str());
+  }
+  nlohmann::json files = json["SERIES_FILES"];
+  std::string x_file = DEFAULT_X_SERIES_FILE;
+  std::string y_file = DEFAULT_Y_SERIES_FILE;
+  std::string s_file = DEFAULT_S_SERIES_FILE;
+  if (!files["X"].is_null()) {
+    x_file = files["X"];
+  }
+  if (!files["Y"].is_null()) {
+    y_file = files["Y"];
+  }
+  if (!files["S"].is_null()) {
+    s_file = files["S"];
+  }
+  CIP_MODEL.load_series(x_file.c_str(), y_file.c_str(), s_file.c_str());
+  if (!json["TRUNCATION"].is_null()) {
+    if (json["TRUNCATION"] == "FULL") {
+      CIP_MODEL.set_truncation(FULL_SERIES);
+    }
+    else if (json["TRUNCATION"] == "LUNISOLAR") {
+      CIP_MODEL.set_truncation(LUNISOLAR_SERIES);
+    }
+    else if (json["TRUNCATION"] == "THRESHOLD") {
+      double threshold = 0.0;
+      if (!json["THRESHOLD"].is_null()) {
+        threshold = json["THRESHOLD"];
+      }
+      CIP_MODEL.set_truncation(THRESHOLD_SERIES, threshold);
+    }
+    else {
+      std::stringstream msg;
+      msg << "run_config::parse_earth_orientation exception: Unsupported "
+          << "series truncation " << json["TRUNCATION"];
+      throw ArcException(msg.str());
+    }
+  }
+  if (!json["CACHE_STEP"].is_null()) {
+    CIP_MODEL.set_cache_step(json["CACHE_STEP"]);
+  }
+  set_earth_model(IAU_2006);
+}
+
+// Parse JSON representation of the atmospheric drag model
+DragModel parse_drag(nlohmann::json& drag_settings) {
+  DragModel drag;
+  if (!drag_settings["MODEL"].is_null()) {
+    if (drag_settings["MODEL"] == "US_STANDARD_1976") {
+      drag.density_model = Standard1976;
+    }
+  }
+  if (!drag_settings["DRAG_COEFF"].is_null()) {
+    drag.cd = drag_settings["DRAG_COEFF"];
+  }
+  if (!drag_settings["AREA"].is_null()) {
+    drag.area = drag_settings["AREA"];
+  }
+  if (!drag_settings["MASS"].is_null()) {
+    drag.mass = drag_settings["MASS"];
+  }
+  return drag;
+}
+
+// Parse JSON representation of an X/Y/Z dispersion (zero if not given)
+Vector3 parse_dispersion_vector(nlohmann::json& json) {
+  Vector3 sigma;
+  if (!json.is_null()) {
+    if (!json["X"].is_null()) {
+      sigma.x = json["X"];
+    }
+    if (!json["Y"].is_null()) {
+      sigma.y = json["Y"];
+    }
+    if (!json["Z"].is_null()) {
+      sigma.z = json["Z"];
+    }
+  }
+  return sigma;
+}
+
+// Parse JSON representation of Monte Carlo dispersions
+Dispersion parse_dispersion(nlohmann::json& input, nlohmann::json& prop) {
+  Dispersion dispersion{ Vector3{}, Vector3{}, 0.0, 0.0 };
+  nlohmann::json state_disp = input["INITIAL_STATE"]["DISPERSION"];
+  if (!state_disp.is_null()) {
+    dispersion.position = parse_dispersion_vector(state_disp["POSITION"]);
+    dispersion.velocity = parse_dispersion_vector(state_disp["VELOCITY"]);
+  }
+  nlohmann::json drag_disp = prop["MODELS"]["ATMOSPHERE"]["DISPERSION"];
+  if (!drag_disp.is_null()) {
+    if (!drag_disp["DRAG_COEFF"].is_null()) {
+      dispersion.drag_coeff = drag_disp["DRAG_COEFF"];
+    }
+    if (!drag_disp["AREA"].is_null()) {
+      dispersion.area = drag_disp["AREA"];
+    }
+  }
+  return dispersion;
+}
+
 // Parse JSON representation of force models
 ForceModel parse_forces(nlohmann::json& prop) {
   ForceModel fm{};
@@ -98,38 +277,51 @@ ForceModel parse_forces(nlohmann::json& prop) {
       }
     }
     if (!models["ATMOSPHERE"].is_null()) {
-      nlohmann::json drag_settings = models["ATMOSPHERE"];
-      DragModel drag;
-      if (!drag_settings["MODEL"].is_null()) {
-        if (drag_settings["MODEL"] == "US_STANDARD_1976") {
-          drag.density_model = Standard1976;
+      fm.set_drag_model(parse_drag(models["ATMOSPHERE"]));
+    }
+    if (!models["SOLAR_RADIATION_PRESSURE"].is_null()) {
+      nlohmann::json srp_settings = models["SOLAR_RADIATION_PRESSURE"];
+      SolarRadiationModel srp;
+      if (!srp_settings["SHADOW_MODEL"].is_null()) {
+        if (srp_settings["SHADOW_MODEL"] == "CYLINDRICAL") {
+          srp.shadow_model = Cylindrical;
+        }
+        else if (srp_settings["SHADOW_MODEL"] == "CONICAL") {
+          srp.shadow_model = Conical;
+        }
+        else {
+          std::stringstream msg;
+          msg << "run_config::parse_forces exception: Unsupported shadow "
+              << "model " << srp_settings["SHADOW_MODEL"];
+          throw ArcException(msg.str());
         }
       }
-      if (!drag_settings["DRAG_COEFF"].is_null()) {
-        drag.cd = drag_settings["DRAG_COEFF"];
+      if (!srp_settings["REFLECT_COEFF"].is_null()) {
+        srp.cr = srp_settings["REFLECT_COEFF"];
       }
-      if (!drag_settings["AREA"].is_null()) {
-        drag.area = drag_settings["AREA"];
+      if (!srp_settings["AREA"].is_null()) {
+        srp.area = srp_settings["AREA"];
       }
-      if (!drag_settings["MASS"].is_null()) {
-        drag.mass = drag_settings["MASS"];
+      if (!srp_settings["MASS"].is_null()) {
+        srp.mass = srp_settings["MASS"];
       }
-      fm.set_drag_model(drag);
+      fm.set_srp_model(srp);
     }
   }
   return fm;
 }
 
-// Parse JSON representation of propagator options and build ephemeris
-Ephemeris parse_propagate(nlohmann::json& prop, ICRF& state, ForceModel fm) {
+// Parse JSON representation of the propagation interval and steps
+void parse_interval(nlohmann::json& prop, DateTime& start, DateTime& stop,
+  double& prop_step, double& int_step) {
   // Parse propagation start and stop times
   std::string start_str = prop["START_TIME"];
   std::string stop_str = prop["STOP_TIME"];
-  DateTime start{ start_str };
-  DateTime stop{ stop_str };
-  // Create step variable
-  double prop_step = 60;
-  double int_step = 15;
+  start = DateTime{ start_str };
+  stop = DateTime{ stop_str };
+  // Set step defaults
+  prop_step = 60;
+  int_step = 15;
   // Parse steps if given, otherwise leave at defaults
   if (!prop["PROPAGATION_STEP"].is_null()) {
     prop_step = prop["PROPAGATION_STEP"];
@@ -137,12 +329,109 @@ Ephemeris parse_propagate(nlohmann::json& prop, ICRF& state, ForceModel fm) {
   if (!prop["INTEGRATION_STEP"].is_null()) {
     int_step = prop["INTEGRATION_STEP"];
   }
+}
+
+// Parse JSON representation of semi-analytic propagator options
+SemiAnalyticPropagator parse_semi_analytic(nlohmann::json& prop, ICRF& state,
+  double int_step) {
+  // Semi-analytic defaults
+  int zonal_degree = 4;
+  int quadrature_points = 64;
+  bool osculating = false;
+  // Overwrite defaults if values exist
+  nlohmann::json sa_settings = prop["SEMI_ANALYTIC"];
+  if (!sa_settings.is_null()) {
+    if (!sa_settings["ZONAL_DEGREE"].is_null()) {
+      zonal_degree = sa_settings["ZONAL_DEGREE"];
+    }
+    if (!sa_settings["QUADRATURE_POINTS"].is_null()) {
+      quadrature_points = sa_settings["QUADRATURE_POINTS"];
+    }
+    if (!sa_settings["OSCULATING"].is_null()) {
+      osculating = sa_settings["OSCULATING"];
+    }
+  }
+  SemiAnalyticPropagator propagator{ state, int_step, zonal_degree,
+                                     quadrature_points, osculating };
+  // Averaged drag uses the same atmosphere settings as numerical propagation
+  if (!prop["MODELS"]["ATMOSPHERE"].is_null()) {
+    propagator.set_drag_model(parse_drag(prop["MODELS"]["ATMOSPHERE"]));
+  }
+  return propagator;
+}
+
+// Parse JSON representation of propagator options and build ephemeris
+Ephemeris parse_propagate(nlohmann::json& prop, ICRF& state, ForceModel fm) {
+  DateTime start, stop;
+  double prop_step, int_step;
+  parse_interval(prop, start, stop, prop_step, int_step);
   // Determine method of propagation and create the ephemeris
   if (!prop["METHOD"].is_null()) {
     if (prop["METHOD"] == "RUNGE_KUTTA_4") {
       RungeKutta4 propagator{ state, int_step, fm };
       return propagator.step(start, stop, prop_step);
     }
+    else if (prop["METHOD"] == "ENCKE") {
+      EnckePropagator propagator{ state, int_step, fm };
+      if (!prop["ENCKE"]["RECTIFY_TOLERANCE"].is_null()) {
+        propagator.rectify_tolerance = prop["ENCKE"]["RECTIFY_TOLERANCE"];
+      }
+      return propagator.step(start, stop, prop_step);
+    }
+    else if (prop["METHOD"] == "BULIRSCH_STOER") {
+      // INTEGRATION_STEP is the first trial step and bounds the adaptive step
+      BulirschStoerPropagator propagator{ state, int_step, fm };
+      if (!prop["BULIRSCH_STOER"]["TOLERANCE"].is_null()) {
+        propagator.set_tolerance(prop["BULIRSCH_STOER"]["TOLERANCE"]);
+      }
+      return propagator.step(start, stop, prop_step);
+    }
+    else if (prop["METHOD"] == "SUNDMAN") {
+      // INTEGRATION_STEP is the step taken at the semi-major axis radius
+      SundmanPropagator propagator{ state, int_step, fm };
+      if (!prop["SUNDMAN"]["POWER"].is_null()) {
+        propagator.sundman_power = prop["SUNDMAN"]["POWER"];
+      }
+      return propagator.step(start, stop, prop_step);
+    }
+    else if (prop["METHOD"] == "SYMPLECTIC") {
+      SymplecticPropagator propagator{ state, int_step, fm };
+      SymplecticSplitting splitting = Leapfrog;
+      int order = 2;
+      if (!prop["SYMPLECTIC"]["SPLITTING"].is_null()) {
+        if (prop["SYMPLECTIC"]["SPLITTING"] == "LEAPFROG") {
+          splitting = Leapfrog;
+        }
+        else if (prop["SYMPLECTIC"]["SPLITTING"] == "WISDOM_HOLMAN") {
+          splitting = WisdomHolman;
+        }
+        else {
+          std::stringstream msg;
+          msg << "run_config::parse_propagate exception: Unsupported symplectic "
+              << "splitting " << prop["SYMPLECTIC"]["SPLITTING"];
+          throw ArcException(msg.str());
+        }
+      }
+      if (!prop["SYMPLECTIC"]["ORDER"].is_null()) {
+        order = prop["SYMPLECTIC"]["ORDER"];
+      }
+      propagator.set_method(splitting, order);
+      return propagator.step(start, stop, prop_step);
+    }
+    else if (prop["METHOD"] == "TAYLOR") {
+      // INTEGRATION_STEP bounds the adaptive Taylor step
+      TaylorPropagator propagator{ state, int_step, fm };
+      if (!prop["TAYLOR"]["TOLERANCE"].is_null()) {
+        propagator.set_tolerance(prop["TAYLOR"]["TOLERANCE"]);
+      }
+      return propagator.step(start, stop, prop_step);
+    }
+    else if (prop["METHOD"] == "SEMI_ANALYTIC") {
+      // Mean elements are integrated with INTEGRATION_STEP (day-scale)
+      SemiAnalyticPropagator propagator =
+        parse_semi_analytic(prop, state, int_step);
+      return propagator.step(start, stop, prop_step);
+    }
     else {
       throw ArcException(
         "run_config::run_config_file exception: Unknown "
@@ -156,8 +445,156 @@ Ephemeris parse_propagate(nlohmann::json& prop, ICRF& state, ForceModel fm) {
   }
 }
 
+// Parse JSON representation of propagator options and build the ephemeris and
+// covariance ephemeris using the unscented transform
+Ephemeris parse_propagate_covariance(nlohmann::json& prop, ICRF& state,
+  Matrix6& covariance, ForceModel fm, CovarianceEphemeris& cov_ephem) {
+  DateTime start, stop;
+  double prop_step, int_step;
+  parse_interval(prop, start, stop, prop_step, int_step);
+  if (prop["METHOD"].is_null()) {
+    throw ArcException(
+      "run_config::run_config_file exception: No propagation "
+      "method selected");
+  }
+  // Sigma points are integrated with the fixed-step Runge-Kutta propagator
+  if (prop["METHOD"] != "RUNGE_KUTTA_4") {
+    throw ArcException(
+      "run_config::run_config_file exception: Covariance propagation "
+      "requires the RUNGE_KUTTA_4 method");
+  }
+  UnscentedPropagator propagator{ state, covariance, int_step, fm };
+  // Overwrite unscented transform defaults if values exist
+  if (!prop["UNSCENTED"].is_null()) {
+    nlohmann::json ut_settings = prop["UNSCENTED"];
+    if (!ut_settings["ALPHA"].is_null()) {
+      propagator.alpha = ut_settings["ALPHA"];
+    }
+    if (!ut_settings["BETA"].is_null()) {
+      propagator.beta = ut_settings["BETA"];
+    }
+    if (!ut_settings["KAPPA"].is_null()) {
+      propagator.kappa = ut_settings["KAPPA"];
+    }
+    if (!ut_settings["THREADS"].is_null()) {
+      propagator.threads = ut_settings["THREADS"];
+    }
+  }
+  return propagator.step(start, stop, prop_step, cov_ephem);
+}
+
+// Parse JSON representation of propagation options and propagate the initial
+// state with its state transition matrix
+Ephemeris parse_propagate_state_transition(nlohmann::json& prop, ICRF& state,
+  ForceModel fm, std::vector<Matrix6>& stms) {
+  DateTime start, stop;
+  double prop_step, int_step;
+  parse_interval(prop, start, stop, prop_step, int_step);
+  // Only the fixed-step Runge-Kutta propagator integrates the variational
+  // equations
+  if (prop["METHOD"] != "RUNGE_KUTTA_4") {
+    throw ArcException(
+      "run_config::parse_propagate_state_transition exception: The state "
+      "transition matrix requires the RUNGE_KUTTA_4 method");
+  }
+  RungeKutta4 propagator{ state, int_step, fm };
+  // The ephemeris states and matrices come from the same integration
+  Ephemeris ephem{};
+  size_t count = step_count(start, stop, prop_step);
+  ephem.reserve(count);
+  stms.clear();
+  stms.reserve(count);
+  for (DateTime t = start; stop.difference(t) >= 0.0;
+       t = t.increment(prop_step)) {
+    Matrix6 stm;
+    ICRF propagated = propagator.propagate_with_stm(t, stm);
+    ephem.push_back(propagated);
+    stms.push_back(stm);
+  }
+  return ephem;
+}
+
+// Parse JSON representation of Monte Carlo options and propagate the trials
+std::vector<StateStatistics> parse_propagate_monte_carlo(nlohmann::json& input,
+  nlohmann::json& prop, ICRF& state, ForceModel fm) {
+  DateTime start, stop;
+  double prop_step, int_step;
+  parse_interval(prop, start, stop, prop_step, int_step);
+  // Trials are integrated with the fixed-step Runge-Kutta propagator
+  if (prop["METHOD"] != "RUNGE_KUTTA_4") {
+    throw ArcException(
+      "run_config::run_config_file exception: Monte Carlo propagation "
+      "requires the RUNGE_KUTTA_4 method");
+  }
+  nlohmann::json mc_settings = prop["MONTE_CARLO"];
+  size_t trials = 100;
+  std::uint64_t seed = 0;
+  if (!mc_settings["TRIALS"].is_null()) {
+    trials = mc_settings["TRIALS"];
+  }
+  if (!mc_settings["SEED"].is_null()) {
+    seed = mc_settings["SEED"];
+  }
+  Dispersion dispersion = parse_dispersion(input, prop);
+  MonteCarloPropagator propagator{ state, int_step, fm, dispersion, trials, seed };
+  if (!mc_settings["THREADS"].is_null()) {
+    propagator.threads = mc_settings["THREADS"];
+  }
+  if (!prop["MODELS"]["ATMOSPHERE"].is_null()) {
+    propagator.set_drag_model(parse_drag(prop["MODELS"]["ATMOSPHERE"]));
+  }
+  return propagator.step(start, stop, prop_step);
+}
+
+// Parse JSON representation of SGP4 options and build the ephemeris of the
+// initial element set
+Ephemeris parse_propagate_sgp4(nlohmann::json& input, nlohmann::json& prop) {
+  DateTime start, stop;
+  double prop_step, int_step;
+  parse_interval(prop, start, stop, prop_step, int_step);
+  if (input["INITIAL_STATE"]["TLE"].is_null()) {
+    throw ArcException(
+      "run_config::run_config_file exception: SGP4 propagation requires "
+      "an initial TLE");
+  }
+  TwoLineElement tle = parse_tle(input);
+  SGP4Propagator propagator{ tle };
+  return propagator.step(start, stop, prop_step);
+}
+
+// Propagate every element set of a TLE file with SGP4 and write an ephemeris
+// for each
+void run_catalog(nlohmann::json& input, nlohmann::json& prop,
+  nlohmann::json& output) {
+  DateTime start, stop;
+  double prop_step, int_step;
+  parse_interval(prop, start, stop, prop_step, int_step);
+  if (prop["METHOD"] != "SGP4") {
+    throw ArcException(
+      "run_config::run_catalog exception: TLE files require the SGP4 "
+      "method");
+  }
+  std::string tle_file = input["TLE_FILE"];
+  std::vector<TwoLineElement> elements = read_tle_file(tle_file.c_str());
+  SGP4Catalog catalog{ elements };
+  if (!prop["SGP4"]["THREADS"].is_null()) {
+    catalog.threads = prop["SGP4"]["THREADS"];
+  }
+  std::vector<Ephemeris> ephemerides = catalog.step(start, stop, prop_step);
+  // Each ephemeris is written to <PREFIX><catalog number>.e
+  std::string prefix = "";
+  if (!output["EPHEMERIS"]["PREFIX"].is_null()) {
+    prefix = output["EPHEMERIS"]["PREFIX"];
+  }
+  for (size_t i = 0; i < ephemerides.size(); i++) {
+    std::string filename = prefix + elements[i].satnum + ".e";
+    ephemerides[i].write_stk(filename.c_str());
+  }
+}
+
 // Take the resulting trajectory from the run and produce requested products
-void post_process(Ephemeris ephem, nlohmann::json output) {
+void post_process(Ephemeris ephem, nlohmann::json output,
+  std::vector<std::string>& stream) {
   if (!output.is_null()) {
     if (!output["EPHEMERIS"].is_null()) {
       nlohmann::json ephem_json = output["EPHEMERIS"];
@@ -165,13 +602,33 @@ void post_process(Ephemeris ephem, nlohmann::json output) {
       if (!ephem_json["FILENAME"].is_null()) {
         filename = ephem_json["FILENAME"];
       }
-      if (!ephem_json["FORMAT"].is_null()) {
-        if (ephem_json["FORMAT"] == "STK") {
+      if (ephem_json["FORMAT"].is_null() || ephem_json["FORMAT"] == "STK") {
+        if (filename == STREAM_FILENAME) {
+          std::vector<std::string> lines = ephem.format_stk();
+          stream.insert(stream.end(), lines.begin(), lines.end());
+        }
+        else {
           ephem.write_stk(filename.c_str());
         }
       }
+    }
+    if (!output["GROUND_TRACK"].is_null()) {
+      nlohmann::json track_json = output["GROUND_TRACK"];
+      std::string filename = "arc_ground_track.txt";
+      if (!track_json["FILENAME"].is_null()) {
+        filename = track_json["FILENAME"];
+      }
+      unsigned threads = 0;
+      if (!track_json["THREADS"].is_null()) {
+        threads = track_json["THREADS"];
+      }
+      std::vector<Geodetic> track = ephem.to_geodetic(threads);
+      if (filename == STREAM_FILENAME) {
+        std::vector<std::string> lines = format_ground_track(track);
+        stream.insert(stream.end(), lines.begin(), lines.end());
+      }
       else {
-        ephem.write_stk(filename.c_str());
+        write_ground_track(track, filename.c_str());
       }
     }
   }
@@ -181,20 +638,215 @@ void post_process(Ephemeris ephem, nlohmann::json output) {
   }
 }
 
+// Take the resulting covariance ephemeris from the run and produce requested
+// products
+void post_process_covariance(CovarianceEphemeris cov_ephem, nlohmann::json output,
+  std::vector<std::string>& stream) {
+  if (!output["COVARIANCE"].is_null()) {
+    nlohmann::json cov_json = output["COVARIANCE"];
+    std::string filename = "arc_cov.out";
+    if (!cov_json["FILENAME"].is_null()) {
+      filename = cov_json["FILENAME"];
+    }
+    if (cov_json["FORMAT"].is_null() || cov_json["FORMAT"] == "STK") {
+      if (filename == STREAM_FILENAME) {
+        std::vector<std::string> lines = cov_ephem.format_stk();
+        stream.insert(stream.end(), lines.begin(), lines.end());
+      }
+      else {
+        cov_ephem.write_stk(filename.c_str());
+      }
+    }
+  }
+}
+
+// Take the resulting state transition matrices from the run and produce the
+// requested products
+void post_process_state_transition(Ephemeris& ephem,
+  std::vector<Matrix6>& stms, nlohmann::json output,
+  std::vector<std::string>& stream) {
+  std::vector<std::string> lines;
+  lines.push_back("# Arc state transition matrices");
+  lines.push_back(
+    "# Epoch (UTC), then the 6x6 matrix from the initial state by rows");
+  for (size_t k = 0; k < stms.size(); k++) {
+    std::stringstream line;
+    line << ephem.state_epoch(k).to_iso() << std::setprecision(14)
+         << std::scientific;
+    for (int i = 0; i < 6; i++) {
+      for (int j = 0; j < 6; j++) {
+        line << " " << stms[k].elements[i][j];
+      }
+    }
+    lines.push_back(line.str());
+  }
+  std::string filename = "arc_stm.out";
+  if (!output["STATE_TRANSITION"]["FILENAME"].is_null()) {
+    filename = output["STATE_TRANSITION"]["FILENAME"];
+  }
+  if (filename == STREAM_FILENAME) {
+    stream.insert(stream.end(), lines.begin(), lines.end());
+  }
+  else {
+    write_lines_to_file(lines, filename.c_str());
+  }
+}
+
+// Take the resulting Monte Carlo statistics from the run and produce requested
+// products
+void post_process_monte_carlo(std::vector<StateStatistics>& statistics,
+  CelestialBody central_body, nlohmann::json output,
+  std::vector<std::string>& stream) {
+  if (!output["MONTE_CARLO"].is_null()) {
+    std::string filename = "arc_mc.out";
+    if (!output["MONTE_CARLO"]["FILENAME"].is_null()) {
+      filename = output["MONTE_CARLO"]["FILENAME"];
+    }
+    write_statistics(statistics, filename.c_str());
+  }
+  if (!output["COVARIANCE"].is_null() && statistics.size() > 0) {
+    // Sample covariance of the trials at each epoch
+    std::vector<DateTime> epochs;
+    std::vector<Matrix6> covariances;
+    for (StateStatistics& stats : statistics) {
+      epochs.push_back(stats.epoch);
+      covariances.push_back(stats.covariance());
+    }
+    CovarianceEphemeris cov_ephem{ epochs, covariances, central_body };
+    post_process_covariance(cov_ephem, output, stream);
+  }
+}
+
+// Screen a catalog of ephemerides for conjunctions and produce the report
+void run_screening(nlohmann::json& screening, nlohmann::json& output) {
+  nlohmann::json files = screening["EPHEMERIDES"];
+  if (!files.is_array() || files.size() < 2) {
+    throw ArcException(
+      "run_config::run_screening exception: EPHEMERIDES must list at least "
+      "two ephemeris files");
+  }
+  std::vector<Ephemeris> catalog;
+  std::vector<std::string> names;
+  for (nlohmann::json& file : files) {
+    std::string filename = file;
+    catalog.push_back(Ephemeris{ filename.c_str() });
+    names.push_back(filename);
+  }
+  double threshold = 5000.0;
+  if (!screening["THRESHOLD"].is_null()) {
+    threshold = screening["THRESHOLD"];
+  }
+  ConjunctionScreener screener{ catalog, threshold };
+  if (!screening["MARGIN"].is_null()) {
+    screener.margin = screening["MARGIN"];
+  }
+  if (!screening["THREADS"].is_null()) {
+    screener.threads = screening["THREADS"];
+  }
+  // Release the parsed ephemerides, the screener keeps packed copies
+  catalog.clear();
+  std::vector<Conjunction> conjunctions = screener.screen();
+  std::string filename = "arc_conjunctions.out";
+  if (!output["CONJUNCTIONS"]["FILENAME"].is_null()) {
+    filename = output["CONJUNCTIONS"]["FILENAME"];
+  }
+  write_conjunctions(conjunctions, names, filename.c_str());
+}
+
+// Apply the reference data settings of a run configuration
+void apply_reference_data(nlohmann::json& input) {
+  // A leap seconds file replaces the built-in leap seconds
+  if (!input["LEAP_SECONDS_FILE"].is_null()) {
+    std::string leap_seconds_file = input["LEAP_SECONDS_FILE"];
+    TIME_SCALES.load_leap_seconds(leap_seconds_file.c_str());
+  }
+  // UT1-UTC and polar motion, from the shipped finals.all unless another
+  // file is given
+  if (!input["FINALS_FILE"].is_null()) {
+    std::string finals_file = input["FINALS_FILE"];
+    TIME_SCALES.load_earth_orientation(finals_file.c_str());
+  }
+  else if (std::ifstream(DEFAULT_FINALS_FILE).good()) {
+    TIME_SCALES.load_earth_orientation(DEFAULT_FINALS_FILE);
+  }
+  // Precession-nutation model of the ITRF/ICRF rotation
+  if (!input["EARTH_ORIENTATION"].is_null()) {
+    parse_earth_orientation(input["EARTH_ORIENTATION"]);
+  }
+}
+
+// Execute a run task using a parsed run configuration
+void run_config(nlohmann::json& json, std::vector<std::string>& stream,
+  bool reference_data) {
+  // Get conditions file sections
+  nlohmann::json input = json["ARC_RUN"]["INPUT"];
+  nlohmann::json prop = json["ARC_RUN"]["PROPAGATION"];
+  nlohmann::json output = json["ARC_RUN"]["OUTPUT"];
+  if (reference_data) {
+    apply_reference_data(input);
+  }
+  // Conjunction screening runs on existing ephemerides
+  if (!json["ARC_RUN"]["SCREENING"].is_null()) {
+    run_screening(json["ARC_RUN"]["SCREENING"], output);
+    return;
+  }
+  // Element sets are propagated analytically with SGP4
+  if (!input["TLE_FILE"].is_null()) {
+    run_catalog(input, prop, output);
+    return;
+  }
+  if (prop["METHOD"] == "SGP4") {
+    Ephemeris ephem = parse_propagate_sgp4(input, prop);
+    post_process(ephem, output, stream);
+    return;
+  }
+  ICRF initial_state = parse_state(input);
+  ForceModel fm = parse_forces(prop);
+  if (!prop["MONTE_CARLO"].is_null()) {
+    // Propagate the nominal trajectory, then the dispersed trials
+    if (!output["EPHEMERIS"].is_null()) {
+      Ephemeris ephem = parse_propagate(prop, initial_state, fm);
+      post_process(ephem, output, stream);
+    }
+    std::vector<StateStatistics> statistics =
+      parse_propagate_monte_carlo(input, prop, initial_state, fm);
+    post_process_monte_carlo(statistics, initial_state.central_body,
+      output, stream);
+  }
+  else if (!input["COVARIANCE"].is_null()) {
+    // Propagate the covariance alongside the initial state
+    Matrix6 covariance = parse_covariance(input);
+    CovarianceEphemeris cov_ephem;
+    Ephemeris ephem = parse_propagate_covariance(prop, initial_state,
+      covariance, fm, cov_ephem);
+    post_process(ephem, output, stream);
+    post_process_covariance(cov_ephem, output, stream);
+  }
+  else if (!output["STATE_TRANSITION"].is_null()) {
+    // Propagate the state transition matrix alongside the initial state
+    std::vector<Matrix6> stms;
+    Ephemeris ephem = parse_propagate_state_transition(prop, initial_state,
+      fm, stms);
+    post_process(ephem, output, stream);
+    post_process_state_transition(ephem, stms, output, stream);
+  }
+  else {
+    Ephemeris ephem = parse_propagate(prop, initial_state, fm);
+    post_process(ephem, output, stream);
+  }
+}
 
 // Execute a run task using a run configuration file
 void run_config_file(const char filepath[]) {
   try {
     // Read in JSON file
     nlohmann::json json = read_json_file(filepath);
-    // Get conditions file sections
-    nlohmann::json input = json["ARC_RUN"]["INPUT"];
-    nlohmann::json prop = json["ARC_RUN"]["PROPAGATION"];
-    nlohmann::json output = json["ARC_RUN"]["OUTPUT"];
-    ICRF initial_state = parse_state(input);
-    ForceModel fm = parse_forces(prop);
-    Ephemeris ephem = parse_propagate(prop, initial_state, fm);
-    post_process(ephem, output);
+    // Streamed products are printed once the run completes
+    std::vector<std::string> stream;
+    run_config(json, stream);
+    for (std::string& line : stream) {
+      std::cout << line << std::endl;
+    }
   }
   catch (ArcException err) {
     std::cout << err.what() << std::endl;
@@ -203,4 +855,4 @@ void run_config_file(const char filepath[]) {
       << "conditions file'" << filepath << "'";
     throw ArcException(msg.str());
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,401 @@
+#include <exceptions.h>
+#include <file_io.h>
+#include <parallel.h>
+#include <run_config.h>
+#include <run_server.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// INPUT settings holding process-wide reference data
+static const char *REFERENCE_KEYS[] = { "LEAP_SECONDS_FILE", "FINALS_FILE",
+                                        "EARTH_ORIENTATION" };
+
+// Request asking the server to shut down
+static const char SHUTDOWN_REQUEST[] = "{\"ARC_SERVER\":\"SHUTDOWN\"}";
+
+// Prefix of the status line ending every reply
+static const char REPLY_STATUS[] = "ARC_STATUS ";
+
+// Status line ending a successful reply
+static const char REPLY_OK[] = "ARC_STATUS OK";
+
+// Prefix of the status line ending a failed reply
+static const char REPLY_ERROR[] = "ARC_STATUS ERROR ";
+
+// Longest request the server reads (bytes)
+static const size_t MAX_REQUEST_SIZE = 1 << 20;
+
+#ifndef _WIN32
+// Fill in the address of a socket location
+static sockaddr_un socket_address(const char socket_path[]) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (strlen(socket_path) >= sizeof(address.sun_path)) {
+    std::stringstream msg;
+    msg << "run_server::socket_address exception: Socket path '"
+        << socket_path << "' is too long";
+    throw ArcException(msg.str());
+  }
+  strcpy(address.sun_path, socket_path);
+  return address;
+}
+
+// Write all of the text to a socket
+static bool send_all(int fd, const std::string &text) {
+  size_t sent = 0;
+  while (sent < text.size()) {
+    ssize_t n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    sent += (size_t)n;
+  }
+  return true;
+}
+
+// Outcome of reading a line from a socket
+enum LineStatus { LINE_READ, LINE_CLOSED, LINE_TOO_LONG };
+
+// Read the next line from a socket, keeping any following data in the buffer
+static LineStatus receive_line(int fd, std::string &buffer, std::string &line,
+                               size_t limit) {
+  size_t newline;
+  while ((newline = buffer.find('\n')) == std::string::npos) {
+    if (buffer.size() > limit) {
+      return LINE_TOO_LONG;
+    }
+    char chunk[4096];
+    ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return LINE_CLOSED;
+    }
+    buffer.append(chunk, (size_t)n);
+  }
+  if (newline > limit) {
+    return LINE_TOO_LONG;
+  }
+  line = buffer.substr(0, newline);
+  buffer.erase(0, newline + 1);
+  return LINE_READ;
+}
+
+// Connect to a server
+static int connect_server(const char socket_path[]) {
+  sockaddr_un address = socket_address(socket_path);
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 ||
+      connect(fd, (sockaddr *)&address, sizeof(address)) < 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    std::stringstream msg;
+    msg << "run_server::connect_server exception: No server at '"
+        << socket_path << "' (" << strerror(errno) << ")";
+    throw ArcException(msg.str());
+  }
+  return fd;
+}
+
+// Send a request and print the reply, returning its status line
+static std::string request_reply(const char socket_path[],
+                                 const std::string &request) {
+  int fd = connect_server(socket_path);
+  std::string buffer, line;
+  bool sent = send_all(fd, request + "\n");
+  while (sent && receive_line(fd, buffer, line,
+                              std::numeric_limits<size_t>::max()) ==
+                    LINE_READ) {
+    if (line.compare(0, strlen(REPLY_STATUS), REPLY_STATUS) == 0) {
+      close(fd);
+      return line;
+    }
+    std::cout << line << std::endl;
+  }
+  close(fd);
+  std::stringstream msg;
+  msg << "run_server::request_reply exception: Server at '" << socket_path
+      << "' closed the connection";
+  throw ArcException(msg.str());
+}
+#endif
+
+/*
+RunServer methods
+*/
+
+// Direct constructor
+RunServer::RunServer(const char socket_path[], unsigned threads)
+  : socket_path{ socket_path }, threads{ threads },
+    reference(nlohmann::json::object()), configured{ false }, listen_fd{ -1 },
+    running{ false } {}
+
+// Load the resident reference data from a run configuration file
+void RunServer::configure(const char filepath[]) {
+  nlohmann::json json = read_json_file(filepath);
+  nlohmann::json input = json["ARC_RUN"]["INPUT"];
+  apply_reference_data(input);
+  for (const char *key : REFERENCE_KEYS) {
+    reference[key] = input[key];
+  }
+  configured = true;
+  if (!json["ARC_RUN"]["SERVER"]["THREADS"].is_null()) {
+    threads = json["ARC_RUN"]["SERVER"]["THREADS"];
+  }
+}
+
+// Run a single request
+std::vector<std::string> RunServer::handle(const std::string &request) {
+  std::vector<std::string> reply;
+  std::string error;
+  try {
+    nlohmann::json json = nlohmann::json::parse(request);
+    if (json.is_object() && json["ARC_SERVER"] == "SHUTDOWN") {
+      stop();
+      reply.push_back(REPLY_OK);
+      return reply;
+    }
+    // Reference data is only read when the server starts
+    nlohmann::json input = json["ARC_RUN"]["INPUT"];
+    for (const char *key : REFERENCE_KEYS) {
+      if (!input[key].is_null() && input[key] != reference[key]) {
+        std::stringstream msg;
+        msg << "RunServer::handle exception: " << key << " differs from the "
+            << "reference data the server was started with";
+        throw ArcException(msg.str());
+      }
+    }
+    run_config(json, reply, false);
+    reply.push_back(REPLY_OK);
+    return reply;
+  } catch (const ArcException &err) {
+    error = err.what();
+  } catch (std::exception &err) {
+    error = err.what();
+  }
+  // Keep the reply to one status line
+  for (char &c : error) {
+    if (c == '\n' || c == '\r') {
+      c = ' ';
+    }
+  }
+  reply.clear();
+  reply.push_back(REPLY_ERROR + error);
+  return reply;
+}
+
+#ifndef _WIN32
+// Accept and serve connections until a client requests a shutdown
+void RunServer::serve() {
+  // Without a configuration file the default reference data is used
+  if (!configured) {
+    nlohmann::json input = nlohmann::json::object();
+    apply_reference_data(input);
+    configured = true;
+  }
+  sockaddr_un address = socket_address(socket_path.c_str());
+  listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    throw ArcException(
+      "RunServer::serve exception: Unable to create a socket");
+  }
+  // Replace the socket of a previous server, but never another kind of file
+  struct stat existing;
+  if (lstat(socket_path.c_str(), &existing) == 0) {
+    if (!S_ISSOCK(existing.st_mode)) {
+      close(listen_fd);
+      listen_fd = -1;
+      std::stringstream msg;
+      msg << "RunServer::serve exception: '" << socket_path
+          << "' exists and is not a socket";
+      throw ArcException(msg.str());
+    }
+    unlink(socket_path.c_str());
+  }
+  if (bind(listen_fd, (sockaddr *)&address, sizeof(address)) < 0 ||
+      listen(listen_fd, SOMAXCONN) < 0) {
+    std::stringstream msg;
+    msg << "RunServer::serve exception: Unable to listen on '"
+        << socket_path << "' (" << strerror(errno) << ")";
+    close(listen_fd);
+    listen_fd = -1;
+    throw ArcException(msg.str());
+  }
+  running = true;
+  unsigned count = worker_count(threads, std::numeric_limits<size_t>::max());
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < count; i++) {
+    workers.push_back(std::thread(&RunServer::work, this));
+  }
+  while (running) {
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+      // Stopping the server shuts the listening socket down
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      break;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      pending.push_back(fd);
+    }
+    queue_ready.notify_one();
+  }
+  running = false;
+  queue_ready.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  // Drop the connections no worker picked up
+  for (int fd : pending) {
+    close(fd);
+  }
+  pending.clear();
+  close(listen_fd);
+  listen_fd = -1;
+  unlink(socket_path.c_str());
+}
+
+// Stop accepting connections
+void RunServer::stop() {
+  std::lock_guard<std::mutex> lock(queue_mutex);
+  running = false;
+  if (listen_fd >= 0) {
+    shutdown(listen_fd, SHUT_RDWR);
+  }
+  // Open connections end once their current request is answered
+  for (int fd : active) {
+    shutdown(fd, SHUT_RD);
+  }
+  queue_ready.notify_all();
+}
+
+// Serve queued connections until the server stops
+void RunServer::work() {
+  for (;;) {
+    int fd;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex);
+      queue_ready.wait(lock, [this]() { return !running || !pending.empty(); });
+      if (!running) {
+        return;
+      }
+      fd = pending.front();
+      pending.pop_front();
+      active.insert(fd);
+    }
+    serve_connection(fd);
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      active.erase(fd);
+    }
+    close(fd);
+  }
+}
+
+// Serve the requests of one connection
+void RunServer::serve_connection(int fd) {
+  std::string buffer, request;
+  LineStatus status;
+  while ((status = receive_line(fd, buffer, request, MAX_REQUEST_SIZE)) ==
+         LINE_READ) {
+    if (request.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+    std::string text;
+    for (std::string &line : handle(request)) {
+      text += line;
+      text += '\n';
+    }
+    if (!send_all(fd, text)) {
+      return;
+    }
+  }
+  // The rest of an oversized request cannot be told from the next one, so
+  // the connection ends with the error
+  if (status == LINE_TOO_LONG) {
+    std::stringstream msg;
+    msg << REPLY_ERROR << "RunServer::serve_connection exception: Request "
+        << "exceeds " << MAX_REQUEST_SIZE << " bytes\n";
+    send_all(fd, msg.str());
+  }
+}
+
+// Send a run configuration file to a server and print the streamed products
+bool send_run_config(const char socket_path[], const char filepath[]) {
+  nlohmann::json json;
+  try {
+    json = read_json_file(filepath);
+  } catch (std::exception &err) {
+    std::stringstream msg;
+    msg << "run_server::send_run_config exception: Unable to read '"
+        << filepath << "' (" << err.what() << ")";
+    throw ArcException(msg.str());
+  }
+  std::string status = request_reply(socket_path, json.dump());
+  if (status != REPLY_OK) {
+    std::cout << status.substr(strlen(REPLY_ERROR)) << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Ask a server to shut down
+void stop_run_server(const char socket_path[]) {
+  request_reply(socket_path, SHUTDOWN_REQUEST);
+}
+#else
+// Accept and serve connections until a client requests a shutdown
+void RunServer::serve() {
+  throw ArcException(
+    "RunServer::serve exception: Unix domain sockets are not supported on "
+    "this platform");
+}
+
+// Stop accepting connections
+void RunServer::stop() { running = false; }
+
+// Serve queued connections until the server stops
+void RunServer::work() {}
+
+// Serve the requests of one connection
+void RunServer::serve_connection(int /* fd */) {}
+
+// Send a run configuration file to a server and print the streamed products
+bool send_run_config(const char /* socket_path */[],
+                     const char /* filepath */[]) {
+  throw ArcException(
+    "run_server::send_run_config exception: Unix domain sockets are not "
+    "supported on this platform");
+}
+
+// Ask a server to shut down
+void stop_run_server(const char /* socket_path */[]) {
+  throw ArcException(
+    "run_server::stop_run_server exception: Unix domain sockets are not "
+    "supported on this platform");
+}
+#endif
@@ -34,4 +34,47 @@ ICRF RungeKutta4::integrate(ICRF &state, double step) {
   // Build the new state and return
   DateTime new_epoch = state.epoch.increment(step);
   return ICRF {state.central_body, new_epoch, final_vectors[0], final_vectors[1]};
+}
+
+// Step the integration of the state and its state transition matrix a number of seconds forward/backward
+ICRF RungeKutta4::integrate_with_stm(ICRF &state, Matrix6 &stm, double step) {
+  // Take derivatives of the state and the state transition matrix together,
+  // evaluating the variational equations at each intermediate state
+  Vector6 k0 {};
+  Vector6 k1 = derivatives(state, 0.0, k0).scale(step);
+  Matrix6 m1 = variational(state, 0.0, k0, stm).scale(step);
+  Vector6 w_k1 = k1 / 2.0;
+  Matrix6 w_m1 = m1 / 2.0;
+  Matrix6 stm_2 = stm + w_m1;
+  Vector6 k2 = derivatives(state, step / 2.0, w_k1).scale(step);
+  Matrix6 m2 = variational(state, step / 2.0, w_k1, stm_2).scale(step);
+  Vector6 w_k2 = k2 / 2.0;
+  Matrix6 w_m2 = m2 / 2.0;
+  Matrix6 stm_3 = stm + w_m2;
+  Vector6 k3 = derivatives(state, step / 2.0, w_k2).scale(step);
+  Matrix6 m3 = variational(state, step / 2.0, w_k2, stm_3).scale(step);
+  Matrix6 stm_4 = stm + m3;
+  Vector6 k4 = derivatives(state, step, k3).scale(step);
+  Matrix6 m4 = variational(state, step, k3, stm_4).scale(step);
+  // Combine the weighted state transition matrix derivatives
+  m2 = m2 * 2;
+  m3 = m3 * 2;
+  Matrix6 m_total = m1 + m2;
+  m_total = m_total + m3;
+  m_total = m_total + m4;
+  m_total = m_total / 6;
+  stm = stm + m_total;
+  // Combine the weighted state derivatives
+  k2 = k2 * 2;
+  k3 = k3 * 2;
+  Vector6 total = k1 + k2;
+  total = total + k3;
+  total = total + k4;
+  total = total / 6;
+  // Add the total weighted velocity/acceleration vector
+  Vector6 pos_vel {state.position, state.velocity};
+  std::array<Vector3, 2> final_vectors = (pos_vel + total).split();
+  // Build the new state and return
+  DateTime new_epoch = state.epoch.increment(step);
+  return ICRF {state.central_body, new_epoch, final_vectors[0], final_vectors[1]};
 }
\ No newline at end of file
@@ -0,0 +1,484 @@
+#include <semi_analytic.h>
+
+#include <exceptions.h>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <sstream>
+
+/*
+Nonsingular element helpers
+*/
+
+// Orbital plane basis vectors (node direction, in-plane normal to the node,
+// and orbit normal) for an inclination and ascending node
+static void plane_basis(double i, double o, Vector3 &p, Vector3 &q,
+                        Vector3 &w) {
+  p = Vector3{ cos(o), sin(o), 0.0 };
+  q = Vector3{ -cos(i) * sin(o), cos(i) * cos(o), sin(i) };
+  w = Vector3{ sin(i) * sin(o), -sin(i) * cos(o), cos(i) };
+}
+
+// Solve the nonsingular form of Kepler's equation,
+// lambda = F - e_x sin(F) + e_y cos(F), for the eccentric argument of latitude
+static double eccentric_latitude(double lambda, double e_x, double e_y) {
+  double f = lambda;
+  for (int iter = 0; iter < 32; iter++) {
+    double delta = (f - e_x * sin(f) + e_y * cos(f) - lambda) /
+                   (1.0 - e_x * cos(f) - e_y * sin(f));
+    f -= delta;
+    if (fabs(delta) < 1e-14) {
+      break;
+    }
+  }
+  return f;
+}
+
+// Position and velocity in the orbital plane basis (node direction, in-plane
+// normal) of a set of nonsingular elements
+// Ref: Vallado, D. A. (2013). Equinoctial Elements. In Fundamentals of
+// astrodynamics and applications (pp. 108-111). Hawthorne, CA: Microcosm Press.
+static void plane_state(double mu, MeanElements &el, double &x, double &y,
+                        double &x_dot, double &y_dot) {
+  double a = el[0], e_x = el[1], e_y = el[2];
+  double eta = sqrt(1.0 - e_x * e_x - e_y * e_y);
+  double beta = 1.0 / (1.0 + eta);
+  double f = eccentric_latitude(el[5], e_x, e_y);
+  double cos_f = cos(f), sin_f = sin(f);
+  double r = a * (1.0 - e_x * cos_f - e_y * sin_f);
+  double n = sqrt(mu / (a * a * a));
+  x = a * ((1.0 - e_y * e_y * beta) * cos_f + e_x * e_y * beta * sin_f - e_x);
+  y = a * ((1.0 - e_x * e_x * beta) * sin_f + e_x * e_y * beta * cos_f - e_y);
+  x_dot = n * a * a / r *
+          (e_x * e_y * beta * cos_f - (1.0 - e_y * e_y * beta) * sin_f);
+  y_dot = n * a * a / r *
+          ((1.0 - e_x * e_x * beta) * cos_f - e_x * e_y * beta * sin_f);
+}
+
+/*
+Semi-analytic propagator methods
+*/
+
+// Direct constructor (default settings)
+SemiAnalyticPropagator::SemiAnalyticPropagator(ICRF initial_state)
+  : SemiAnalyticPropagator{ initial_state, 86400.0, 4, 64, false } {}
+
+// Direct constructor (full settings)
+SemiAnalyticPropagator::SemiAnalyticPropagator(ICRF initial_state,
+  double step_size, int zonal_degree, int quadrature_points, bool osculating) {
+  if (step_size <= 0.0 || quadrature_points < 4 || quadrature_points % 2 != 0 ||
+      (zonal_degree != 0 && (zonal_degree < 2 || zonal_degree > 4))) {
+    throw ArcException(
+      "SemiAnalyticPropagator::SemiAnalyticPropagator exception: Invalid "
+      "propagator settings");
+  }
+  this->initial_state = initial_state;
+  this->step_size = step_size;
+  this->zonal_degree = zonal_degree;
+  this->quadrature_points = quadrature_points;
+  this->osculating = osculating;
+  this->has_drag = false;
+  this->forward_decay = 0.0;
+  this->backward_decay = 0.0;
+  // Higher zonal harmonics are only defined for the Earth
+  CelestialBody body = initial_state.central_body;
+  this->j2 = zonal_degree >= 2 ? body.j2() : 0.0;
+  this->j3 = zonal_degree >= 3 && body.id() == EARTH.id() ? EARTH_J3 : 0.0;
+  this->j4 = zonal_degree >= 4 && body.id() == EARTH.id() ? EARTH_J4 : 0.0;
+  // Check that the nonsingular elements are defined for this orbit
+  Vector3 h = initial_state.position.cross(initial_state.velocity);
+  double energy = initial_state.velocity.dot(initial_state.velocity) / 2.0 -
+                  body.mu() / initial_state.position.mag();
+  if (energy >= 0.0 || sqrt(h.x * h.x + h.y * h.y) / h.mag() < 1e-6) {
+    throw ArcException(
+      "SemiAnalyticPropagator::SemiAnalyticPropagator exception: Orbit must "
+      "be bound and inclined");
+  }
+  this->initial_mean = mean_elements(initial_state);
+  MeanElementNode first{ 0.0, initial_mean,
+                         averaged_rates(initial_mean, initial_state.epoch) };
+  this->forward_nodes = std::vector<MeanElementNode>{ first };
+  this->backward_nodes = std::vector<MeanElementNode>{ first };
+}
+
+// Change atmospheric drag model
+void SemiAnalyticPropagator::set_drag_model(DragModel model) {
+  this->drag_model = model;
+  this->has_drag = true;
+  // Rates at the initial node include drag from now on
+  MeanElementNode first{ 0.0, initial_mean,
+                         averaged_rates(initial_mean, initial_state.epoch) };
+  this->forward_nodes = std::vector<MeanElementNode>{ first };
+  this->backward_nodes = std::vector<MeanElementNode>{ first };
+  this->forward_decay = 0.0;
+  this->backward_decay = 0.0;
+}
+
+// Calculate the perturbing acceleration (zonal gravity and drag) at a state
+// Ref: Vallado, D. A. (2013). Zonal Harmonics. In Fundamentals of
+// astrodynamics and applications (pp. 593-594). Hawthorne, CA: Microcosm Press.
+Vector3 SemiAnalyticPropagator::perturbation(ICRF &state) {
+  double mu = state.central_body.mu();
+  double radius = state.central_body.radius_equator();
+  double x = state.position.x, y = state.position.y, z = state.position.z;
+  double r_2 = x * x + y * y + z * z;
+  double r = sqrt(r_2);
+  // Square of the sine of the latitude
+  double s_2 = z * z / r_2;
+  double a_x = 0.0, a_y = 0.0, a_z = 0.0;
+  if (j2 != 0.0) {
+    double c = -1.5 * j2 * mu * radius * radius / (r_2 * r_2 * r);
+    a_x += c * x * (1.0 - 5.0 * s_2);
+    a_y += c * y * (1.0 - 5.0 * s_2);
+    a_z += c * z * (3.0 - 5.0 * s_2);
+  }
+  if (j3 != 0.0) {
+    double c = -2.5 * j3 * mu * pow(radius, 3) / (r_2 * r_2 * r_2 * r);
+    a_x += c * x * (3.0 * z - 7.0 * z * s_2);
+    a_y += c * y * (3.0 * z - 7.0 * z * s_2);
+    a_z += c * (6.0 * z * z - 7.0 * z * z * s_2 - 0.6 * r_2);
+  }
+  if (j4 != 0.0) {
+    double c = 1.875 * j4 * mu * pow(radius, 4) / (r_2 * r_2 * r_2 * r);
+    a_x += c * x * (1.0 - 14.0 * s_2 + 21.0 * s_2 * s_2);
+    a_y += c * y * (1.0 - 14.0 * s_2 + 21.0 * s_2 * s_2);
+    a_z += c * z * (5.0 - 70.0 / 3.0 * s_2 + 21.0 * s_2 * s_2);
+  }
+  Vector3 accel{ a_x, a_y, a_z };
+  if (has_drag) {
+    Vector3 drag = drag_model.acceleration(state);
+    accel = accel.add(drag);
+  }
+  return accel;
+}
+
+// Calculate the osculating element rates at a point on an orbit
+// Ref: Vallado, D. A. (2013). Gaussian Form of the Variation of Parameters.
+// In Fundamentals of astrodynamics and applications (pp. 636-640).
+// Hawthorne, CA: Microcosm Press.
+MeanElements SemiAnalyticPropagator::element_rates(MeanElements &elements,
+  DateTime &epoch) {
+  CelestialBody body = initial_state.central_body;
+  double mu = body.mu();
+  double a = elements[0], e_x = elements[1], e_y = elements[2];
+  double i = elements[3];
+  double eta = sqrt(1.0 - e_x * e_x - e_y * e_y);
+  double n = sqrt(mu / (a * a * a));
+  double p = a * eta * eta;
+  double h = sqrt(mu * p);
+  double cot_i = cos(i) / sin(i);
+  Vector3 p_hat, q_hat, w_hat;
+  plane_basis(i, elements[4], p_hat, q_hat, w_hat);
+  double x, y, x_dot, y_dot;
+  plane_state(mu, elements, x, y, x_dot, y_dot);
+  Vector3 pos_q = q_hat.scale(y);
+  Vector3 vel_q = q_hat.scale(y_dot);
+  Vector3 position = p_hat.scale(x).add(pos_q);
+  Vector3 velocity = p_hat.scale(x_dot).add(vel_q);
+  ICRF sample_state{ body, epoch, position, velocity };
+  Vector3 accel = perturbation(sample_state);
+  // Perturbing acceleration in the radial, along-track, and normal axes
+  double r = sqrt(x * x + y * y);
+  Vector3 r_hat = position.scale(1.0 / r);
+  Vector3 s_hat = w_hat.cross(r_hat);
+  double f_r = accel.dot(r_hat);
+  double f_s = accel.dot(s_hat);
+  double f_w = accel.dot(w_hat);
+  // Argument of latitude and true anomaly terms
+  double cos_u = x / r, sin_u = y / r;
+  double e_cos_v = e_x * cos_u + e_y * sin_u;
+  double e_sin_v = e_x * sin_u - e_y * cos_u;
+  double normal = r * sin_u * f_w / h;
+  MeanElements rates;
+  rates[0] = 2.0 * a * a / h * (e_sin_v * f_r + p / r * f_s);
+  rates[1] = (p * sin_u * f_r + ((p + r) * cos_u + r * e_x) * f_s) / h +
+             e_y * cot_i * normal;
+  rates[2] = (-p * cos_u * f_r + ((p + r) * sin_u + r * e_y) * f_s) / h -
+             e_x * cot_i * normal;
+  rates[3] = r * cos_u * f_w / h;
+  rates[4] = normal / sin(i);
+  rates[5] = n - 2.0 * eta * r / h * f_r -
+             (p * e_cos_v * f_r - (p + r) * e_sin_v * f_s) /
+               ((1.0 + eta) * h) -
+             cot_i * normal;
+  return rates;
+}
+
+// Calculate the harmonic coefficients of rates sampled at equally spaced mean
+// arguments of latitude
+void SemiAnalyticPropagator::harmonics(std::vector<MeanElements> &samples,
+  std::vector<MeanElements> &c, std::vector<MeanElements> &s) {
+  int count = quadrature_points / 2 - 1;
+  c.assign(count + 1, MeanElements{});
+  s.assign(count + 1, MeanElements{});
+  for (int k = 1; k <= count; k++) {
+    for (int j = 0; j < quadrature_points; j++) {
+      double angle = 2.0 * M_PI * ((j * k) % quadrature_points) /
+                     quadrature_points;
+      double cos_a = cos(angle) * 2.0 / quadrature_points;
+      double sin_a = sin(angle) * 2.0 / quadrature_points;
+      for (int el = 0; el < 6; el++) {
+        c[k][el] += samples[j][el] * cos_a;
+        s[k][el] += samples[j][el] * sin_a;
+      }
+    }
+  }
+}
+
+// Integrate the harmonics of the element rates over the mean argument of
+// latitude, giving the short-period variations at a point on the orbit
+MeanElements SemiAnalyticPropagator::variation(std::vector<MeanElements> &c,
+  std::vector<MeanElements> &s, double a, double lambda, bool mean_motion) {
+  double n = sqrt(initial_state.central_body.mu() / (a * a * a));
+  MeanElements variation{};
+  // Second integral of the semi-major axis variation, which perturbs the
+  // mean motion
+  double a_integral = 0.0;
+  for (size_t k = 1; k < c.size(); k++) {
+    double cos_k = cos(k * lambda);
+    double sin_k = sin(k * lambda);
+    for (int el = 0; el < 6; el++) {
+      variation[el] += (c[k][el] * sin_k - s[k][el] * cos_k) / (k * n);
+    }
+    a_integral -= (c[k][0] * cos_k + s[k][0] * sin_k) / (k * k * n);
+  }
+  if (mean_motion) {
+    variation[5] -= 1.5 / a * a_integral;
+  }
+  return variation;
+}
+
+// Sample the osculating element rates around the orbit of a set of mean
+// elements
+void SemiAnalyticPropagator::sample_rates(MeanElements &mean,
+  DateTime &epoch, std::vector<MeanElements> &samples) {
+  // Rates along the mean orbit, equally spaced in mean anomaly so equally
+  // spaced in time
+  std::vector<MeanElements> mean_samples(quadrature_points);
+  for (int j = 0; j < quadrature_points; j++) {
+    MeanElements point = mean;
+    point[5] = 2.0 * M_PI * j / quadrature_points;
+    mean_samples[j] = element_rates(point, epoch);
+  }
+  // Resample at the osculating elements of each point, which brings the
+  // coupling between the short-period terms (J2 squared) into the averages
+  std::vector<MeanElements> c, s;
+  harmonics(mean_samples, c, s);
+  samples.resize(quadrature_points);
+  for (int j = 0; j < quadrature_points; j++) {
+    double lambda = 2.0 * M_PI * j / quadrature_points;
+    MeanElements point = variation(c, s, mean[0], lambda, true);
+    for (int k = 0; k < 6; k++) {
+      point[k] += mean[k];
+    }
+    point[5] += lambda - mean[5];
+    samples[j] = element_rates(point, epoch);
+  }
+}
+
+// Calculate the orbit-averaged rates of a set of mean elements
+MeanElements SemiAnalyticPropagator::averaged_rates(MeanElements &mean,
+  DateTime &epoch) {
+  std::vector<MeanElements> samples;
+  sample_rates(mean, epoch, samples);
+  MeanElements rates{};
+  for (int j = 0; j < quadrature_points; j++) {
+    for (int k = 0; k < 6; k++) {
+      rates[k] += samples[j][k] / quadrature_points;
+    }
+  }
+  return rates;
+}
+
+// Calculate the short-period variations of the osculating elements about a
+// set of mean elements
+MeanElements SemiAnalyticPropagator::short_periodic(MeanElements &mean,
+  DateTime &epoch) {
+  std::vector<MeanElements> samples, c, s;
+  sample_rates(mean, epoch, samples);
+  harmonics(samples, c, s);
+  // The resampled mean argument of latitude rates already include the mean
+  // motion of the osculating semi-major axis
+  return variation(c, s, mean[0], mean[5], false);
+}
+
+// Convert an osculating state to mean elements
+MeanElements SemiAnalyticPropagator::mean_elements(ICRF &state) {
+  double mu = state.central_body.mu();
+  Vector3 r = state.position;
+  Vector3 v = state.velocity;
+  double r_mag = r.mag();
+  // Orbit plane
+  Vector3 h = r.cross(v);
+  double i = acos(h.z / h.mag());
+  double o = atan2(h.x, -h.y);
+  Vector3 p_hat, q_hat, w_hat;
+  plane_basis(i, o, p_hat, q_hat, w_hat);
+  // Eccentricity vector components in the orbit plane
+  Vector3 e_vec_a = r.scale(v.dot(v) - mu / r_mag);
+  Vector3 e_vec_b = v.scale(-r.dot(v));
+  Vector3 e_vec = e_vec_a.add(e_vec_b).scale(1.0 / mu);
+  double e_x = e_vec.dot(p_hat);
+  double e_y = e_vec.dot(q_hat);
+  double a = 1.0 / (2.0 / r_mag - v.dot(v) / mu);
+  // Eccentric argument of latitude from the in-plane position
+  double eta = sqrt(1.0 - e_x * e_x - e_y * e_y);
+  double beta = 1.0 / (1.0 + eta);
+  double x = r.dot(p_hat), y = r.dot(q_hat);
+  double cos_f =
+    e_x + ((1.0 - e_x * e_x * beta) * x - e_x * e_y * beta * y) / (a * eta);
+  double sin_f =
+    e_y + ((1.0 - e_y * e_y * beta) * y - e_x * e_y * beta * x) / (a * eta);
+  double f = atan2(sin_f, cos_f);
+  MeanElements osc{ a, e_x, e_y, i, o, f - e_x * sin_f + e_y * cos_f };
+  // Remove the short-period terms, evaluated at the current estimate of the
+  // mean elements
+  MeanElements mean = osc;
+  for (int iter = 0; iter < 8; iter++) {
+    MeanElements variation = short_periodic(mean, state.epoch);
+    for (int k = 0; k < 6; k++) {
+      mean[k] = osc[k] - variation[k];
+    }
+  }
+  return mean;
+}
+
+// Calculate the ICRF state represented by a set of elements
+ICRF SemiAnalyticPropagator::state(MeanElements &elements, DateTime &epoch) {
+  CelestialBody body = initial_state.central_body;
+  double x, y, x_dot, y_dot;
+  plane_state(body.mu(), elements, x, y, x_dot, y_dot);
+  Vector3 p_hat, q_hat, w_hat;
+  plane_basis(elements[3], elements[4], p_hat, q_hat, w_hat);
+  Vector3 pos_q = q_hat.scale(y);
+  Vector3 vel_q = q_hat.scale(y_dot);
+  Vector3 position = p_hat.scale(x).add(pos_q);
+  Vector3 velocity = p_hat.scale(x_dot).add(vel_q);
+  return ICRF{ body, epoch, position, velocity };
+}
+
+// Extend the integration nodes to cover an offset from the initial epoch
+bool SemiAnalyticPropagator::extend_to(double dt) {
+  bool forward = dt >= 0.0;
+  std::vector<MeanElementNode> &nodes = forward ? forward_nodes : backward_nodes;
+  double &decay_time = forward ? forward_decay : backward_decay;
+  double radius = initial_state.central_body.radius_equator();
+  while (fabs(nodes.back().t) < fabs(dt)) {
+    if (decay_time != 0.0) {
+      return false;
+    }
+    MeanElementNode last = nodes.back();
+    // Shorten the step as drag brings the perigee down, so that a step
+    // changes the semi-major axis by a fraction of the remaining altitude
+    double e_last = sqrt(last.elements[1] * last.elements[1] +
+                         last.elements[2] * last.elements[2]);
+    double margin = last.elements[0] * (1.0 - e_last) - radius - DECAY_ALTITUDE;
+    double h = step_size;
+    if (fabs(last.rates[0]) * h > 0.1 * margin) {
+      h = fmax(0.1 * margin / fabs(last.rates[0]), MIN_DECAY_STEP);
+    }
+    h = forward ? h : -h;
+    // Fourth-order Runge-Kutta step of the averaged equations
+    DateTime t_0 = initial_state.epoch.increment(last.t);
+    DateTime t_half = t_0.increment(h / 2.0);
+    DateTime t_1 = t_0.increment(h);
+    MeanElements k_1 = last.rates, k_2, k_3, k_4, y;
+    for (int k = 0; k < 6; k++) {
+      y[k] = last.elements[k] + h / 2.0 * k_1[k];
+    }
+    k_2 = averaged_rates(y, t_half);
+    for (int k = 0; k < 6; k++) {
+      y[k] = last.elements[k] + h / 2.0 * k_2[k];
+    }
+    k_3 = averaged_rates(y, t_half);
+    for (int k = 0; k < 6; k++) {
+      y[k] = last.elements[k] + h * k_3[k];
+    }
+    k_4 = averaged_rates(y, t_1);
+    for (int k = 0; k < 6; k++) {
+      y[k] = last.elements[k] +
+             h / 6.0 * (k_1[k] + 2.0 * k_2[k] + 2.0 * k_3[k] + k_4[k]);
+    }
+    // Stop at the node where the mean perigee falls below the decay altitude
+    double e = sqrt(y[1] * y[1] + y[2] * y[2]);
+    if (!(e < 1.0 && y[0] * (1.0 - e) - radius >= DECAY_ALTITUDE)) {
+      decay_time = last.t + h;
+      return false;
+    }
+    MeanElementNode next{ last.t + h, y, averaged_rates(y, t_1) };
+    nodes.push_back(next);
+  }
+  return true;
+}
+
+// Obtain the mean elements at an epoch
+MeanElements SemiAnalyticPropagator::propagate_mean(DateTime &epoch) {
+  double dt = epoch.difference(initial_state.epoch);
+  if (!extend_to(dt)) {
+    std::stringstream ss;
+    ss << "SemiAnalyticPropagator::propagate_mean exception: Orbit decays "
+       << "before " << epoch;
+    throw ArcException(ss.str());
+  }
+  std::vector<MeanElementNode> &nodes =
+    dt >= 0.0 ? forward_nodes : backward_nodes;
+  if (nodes.size() == 1) {
+    return nodes[0].elements;
+  }
+  // Find the surrounding nodes (steps shorten near decay, so search)
+  size_t lower = 0, upper = nodes.size() - 1;
+  while (upper - lower > 1) {
+    size_t middle = (lower + upper) / 2;
+    if (fabs(nodes[middle].t) <= fabs(dt)) {
+      lower = middle;
+    } else {
+      upper = middle;
+    }
+  }
+  size_t index = lower;
+  // Cubic Hermite interpolation between the surrounding nodes
+  MeanElementNode &n_0 = nodes[index];
+  MeanElementNode &n_1 = nodes[index + 1];
+  double h = n_1.t - n_0.t;
+  double s = (dt - n_0.t) / h;
+  double h_00 = (1.0 + 2.0 * s) * (1.0 - s) * (1.0 - s);
+  double h_10 = s * (1.0 - s) * (1.0 - s);
+  double h_01 = s * s * (3.0 - 2.0 * s);
+  double h_11 = s * s * (s - 1.0);
+  MeanElements mean;
+  for (int k = 0; k < 6; k++) {
+    mean[k] = h_00 * n_0.elements[k] + h_10 * h * n_0.rates[k] +
+              h_01 * n_1.elements[k] + h_11 * h * n_1.rates[k];
+  }
+  return mean;
+}
+
+// Propagate the initial state to specified epoch
+ICRF SemiAnalyticPropagator::propagate(DateTime &epoch) {
+  MeanElements elements = propagate_mean(epoch);
+  if (osculating) {
+    MeanElements variation = short_periodic(elements, epoch);
+    for (int k = 0; k < 6; k++) {
+      elements[k] += variation[k];
+    }
+  }
+  return state(elements, epoch);
+}
+
+// Create an Ephemeris by propagating over an interval
+Ephemeris SemiAnalyticPropagator::step(DateTime &start, DateTime &stop,
+  double step) {
+  Ephemeris ephem{};
+  ephem.reserve(step_count(start, stop, step));
+  DateTime t = start;
+  while (stop.difference(t) >= 0.0) {
+    // End the ephemeris at decay (propagating the first state reports it)
+    if (ephem.size() > 0 && !extend_to(t.difference(initial_state.epoch))) {
+      break;
+    }
+    ICRF state = propagate(t);
+    ephem.push_back(state);
+    t = t.increment(step);
+  }
+  return ephem;
+}
\ No newline at end of file
@@ -0,0 +1,1035 @@
+#include <celestial.h>
+#include <earth_model.h>
+#include <exceptions.h>
+#include <parallel.h>
+#include <sgp4.h>
+#include <teme.h>
+
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+// Two times pi
+const double TWO_PI = 2.0 * M_PI;
+
+// Two thirds
+const double X2O3 = 2.0 / 3.0;
+
+// Square root of the gravitational parameter in Earth radii^1.5 per minute
+const double XKE = 60.0 / sqrt(SGP4_RADIUS * SGP4_RADIUS * SGP4_RADIUS / SGP4_MU);
+
+// Ratio of the J3 and J2 zonal harmonics
+const double J3OJ2 = SGP4_J3 / SGP4_J2;
+
+// Julian date of 1950 Jan 0.0 UTC
+const double SGP4_JD_1950 = 2433281.5;
+
+/*
+Shared deep space quantities computed at epoch by dscom and consumed by dsinit
+*/
+struct DeepSpaceCommon {
+  double sinim, cosim, emsq, em, nm, s1, s2, s3, s4, s5, ss1, ss2, ss3, ss4,
+    ss5, sz1, sz3, sz11, sz13, sz21, sz23, sz31, sz33, z1, z3, z11, z13, z21,
+    z23, z31, z33;
+};
+
+// Greenwich mean sidereal angle (IAU-82) from a UT1 Julian date
+static double gstime(double jdut1) {
+  double tut1 = (jdut1 - 2451545.0) / 36525.0;
+  double temp = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1 +
+                (876600.0 * 3600 + 8640184.812866) * tut1 + 67310.54841;
+  temp = fmod(temp * M_PI / 180.0 / 240.0, TWO_PI);
+  return temp < 0.0 ? temp + TWO_PI : temp;
+}
+
+// Deep space common terms (lunar and solar perturbation coefficients)
+static void dscom(double epoch, double ep, double argpp, double tc, double inclp,
+                  double nodep, double np, SGP4Record &rec, DeepSpaceCommon &ds) {
+  const double zes = 0.01675, zel = 0.05490, c1ss = 2.9864797e-6,
+               c1l = 4.7968065e-7, zsinis = 0.39785416, zcosis = 0.91744867,
+               zcosgs = 0.1945905, zsings = -0.98088458;
+  ds.nm = np;
+  ds.em = ep;
+  double snodm = sin(nodep), cnodm = cos(nodep);
+  double sinomm = sin(argpp), cosomm = cos(argpp);
+  ds.sinim = sin(inclp);
+  ds.cosim = cos(inclp);
+  ds.emsq = ds.em * ds.em;
+  double betasq = 1.0 - ds.emsq;
+  double rtemsq = sqrt(betasq);
+  // Initialize lunar solar terms
+  rec.peo = rec.pinco = rec.plo = rec.pgho = rec.pho = 0.0;
+  double day = epoch + 18261.5 + tc / 1440.0;
+  double xnodce = fmod(4.5236020 - 9.2422029e-4 * day, TWO_PI);
+  double stem = sin(xnodce), ctem = cos(xnodce);
+  double zcosil = 0.91375164 - 0.03568096 * ctem;
+  double zsinil = sqrt(1.0 - zcosil * zcosil);
+  double zsinhl = 0.089683511 * stem / zsinil;
+  double zcoshl = sqrt(1.0 - zsinhl * zsinhl);
+  double gam = 5.8351514 + 0.0019443680 * day;
+  double zx = 0.39785416 * stem / zsinil;
+  double zy = zcoshl * ctem + 0.91744867 * zsinhl * stem;
+  zx = atan2(zx, zy);
+  zx = gam + zx - xnodce;
+  double zcosgl = cos(zx), zsingl = sin(zx);
+  // Solar terms on the first pass, lunar terms on the second
+  double zcosg = zcosgs, zsing = zsings, zcosi = zcosis, zsini = zsinis;
+  double zcosh = cnodm, zsinh = snodm;
+  double cc = c1ss, xnoi = 1.0 / ds.nm;
+  double s6 = 0.0, s7 = 0.0, ss6 = 0.0, ss7 = 0.0;
+  double z2 = 0.0, z12 = 0.0, z22 = 0.0, z32 = 0.0;
+  double sz2 = 0.0, sz12 = 0.0, sz22 = 0.0, sz32 = 0.0;
+  for (int lsflg = 1; lsflg <= 2; lsflg++) {
+    double a1 = zcosg * zcosh + zsing * zcosi * zsinh;
+    double a3 = -zsing * zcosh + zcosg * zcosi * zsinh;
+    double a7 = -zcosg * zsinh + zsing * zcosi * zcosh;
+    double a8 = zsing * zsini;
+    double a9 = zsing * zsinh + zcosg * zcosi * zcosh;
+    double a10 = zcosg * zsini;
+    double a2 = ds.cosim * a7 + ds.sinim * a8;
+    double a4 = ds.cosim * a9 + ds.sinim * a10;
+    double a5 = -ds.sinim * a7 + ds.cosim * a8;
+    double a6 = -ds.sinim * a9 + ds.cosim * a10;
+    double x1 = a1 * cosomm + a2 * sinomm;
+    double x2 = a3 * cosomm + a4 * sinomm;
+    double x3 = -a1 * sinomm + a2 * cosomm;
+    double x4 = -a3 * sinomm + a4 * cosomm;
+    double x5 = a5 * sinomm;
+    double x6 = a6 * sinomm;
+    double x7 = a5 * cosomm;
+    double x8 = a6 * cosomm;
+    ds.z31 = 12.0 * x1 * x1 - 3.0 * x3 * x3;
+    z32 = 24.0 * x1 * x2 - 6.0 * x3 * x4;
+    ds.z33 = 12.0 * x2 * x2 - 3.0 * x4 * x4;
+    ds.z1 = 3.0 * (a1 * a1 + a2 * a2) + ds.z31 * ds.emsq;
+    z2 = 6.0 * (a1 * a3 + a2 * a4) + z32 * ds.emsq;
+    ds.z3 = 3.0 * (a3 * a3 + a4 * a4) + ds.z33 * ds.emsq;
+    ds.z11 = -6.0 * a1 * a5 + ds.emsq * (-24.0 * x1 * x7 - 6.0 * x3 * x5);
+    z12 = -6.0 * (a1 * a6 + a3 * a5) +
+          ds.emsq * (-24.0 * (x2 * x7 + x1 * x8) - 6.0 * (x3 * x6 + x4 * x5));
+    ds.z13 = -6.0 * a3 * a6 + ds.emsq * (-24.0 * x2 * x8 - 6.0 * x4 * x6);
+    ds.z21 = 6.0 * a2 * a5 + ds.emsq * (24.0 * x1 * x5 - 6.0 * x3 * x7);
+    z22 = 6.0 * (a4 * a5 + a2 * a6) +
+          ds.emsq * (24.0 * (x2 * x5 + x1 * x6) - 6.0 * (x4 * x7 + x3 * x8));
+    ds.z23 = 6.0 * a4 * a6 + ds.emsq * (24.0 * x2 * x6 - 6.0 * x4 * x8);
+    ds.z1 = ds.z1 + ds.z1 + betasq * ds.z31;
+    z2 = z2 + z2 + betasq * z32;
+    ds.z3 = ds.z3 + ds.z3 + betasq * ds.z33;
+    ds.s3 = cc * xnoi;
+    ds.s2 = -0.5 * ds.s3 / rtemsq;
+    ds.s4 = ds.s3 * rtemsq;
+    ds.s1 = -15.0 * ds.em * ds.s4;
+    ds.s5 = x1 * x3 + x2 * x4;
+    s6 = x2 * x3 + x1 * x4;
+    s7 = x2 * x4 - x1 * x3;
+    if (lsflg == 1) {
+      ds.ss1 = ds.s1;
+      ds.ss2 = ds.s2;
+      ds.ss3 = ds.s3;
+      ds.ss4 = ds.s4;
+      ds.ss5 = ds.s5;
+      ss6 = s6;
+      ss7 = s7;
+      ds.sz1 = ds.z1;
+      sz2 = z2;
+      ds.sz3 = ds.z3;
+      ds.sz11 = ds.z11;
+      sz12 = z12;
+      ds.sz13 = ds.z13;
+      ds.sz21 = ds.z21;
+      sz22 = z22;
+      ds.sz23 = ds.z23;
+      ds.sz31 = ds.z31;
+      sz32 = z32;
+      ds.sz33 = ds.z33;
+      zcosg = zcosgl;
+      zsing = zsingl;
+      zcosi = zcosil;
+      zsini = zsinil;
+      zcosh = zcoshl * cnodm + zsinhl * snodm;
+      zsinh = snodm * zcoshl - cnodm * zsinhl;
+      cc = c1l;
+    }
+  }
+  rec.zmol = fmod(4.7199672 + 0.22997150 * day - gam, TWO_PI);
+  rec.zmos = fmod(6.2565837 + 0.017201977 * day, TWO_PI);
+  // Solar terms
+  rec.se2 = 2.0 * ds.ss1 * ss6;
+  rec.se3 = 2.0 * ds.ss1 * ss7;
+  rec.si2 = 2.0 * ds.ss2 * sz12;
+  rec.si3 = 2.0 * ds.ss2 * (ds.sz13 - ds.sz11);
+  rec.sl2 = -2.0 * ds.ss3 * sz2;
+  rec.sl3 = -2.0 * ds.ss3 * (ds.sz3 - ds.sz1);
+  rec.sl4 = -2.0 * ds.ss3 * (-21.0 - 9.0 * ds.emsq) * zes;
+  rec.sgh2 = 2.0 * ds.ss4 * sz32;
+  rec.sgh3 = 2.0 * ds.ss4 * (ds.sz33 - ds.sz31);
+  rec.sgh4 = -18.0 * ds.ss4 * zes;
+  rec.sh2 = -2.0 * ds.ss2 * sz22;
+  rec.sh3 = -2.0 * ds.ss2 * (ds.sz23 - ds.sz21);
+  // Lunar terms
+  rec.ee2 = 2.0 * ds.s1 * s6;
+  rec.e3 = 2.0 * ds.s1 * s7;
+  rec.xi2 = 2.0 * ds.s2 * z12;
+  rec.xi3 = 2.0 * ds.s2 * (ds.z13 - ds.z11);
+  rec.xl2 = -2.0 * ds.s3 * z2;
+  rec.xl3 = -2.0 * ds.s3 * (ds.z3 - ds.z1);
+  rec.xl4 = -2.0 * ds.s3 * (-21.0 - 9.0 * ds.emsq) * zel;
+  rec.xgh2 = 2.0 * ds.s4 * z32;
+  rec.xgh3 = 2.0 * ds.s4 * (ds.z33 - ds.z31);
+  rec.xgh4 = -18.0 * ds.s4 * zel;
+  rec.xh2 = -2.0 * ds.s2 * z22;
+  rec.xh3 = -2.0 * ds.s2 * (ds.z23 - ds.z21);
+}
+
+// Deep space long-period lunar-solar periodics (not applied at epoch)
+static void dpper(SGP4Record &rec, double t, bool init, double &ep,
+                  double &inclp, double &nodep, double &argpp, double &mp) {
+  const double zns = 1.19459e-5, zes = 0.01675, znl = 1.5835218e-4,
+               zel = 0.05490;
+  // Solar terms
+  double zm = init ? rec.zmos : rec.zmos + zns * t;
+  double zf = zm + 2.0 * zes * sin(zm);
+  double sinzf = sin(zf);
+  double f2 = 0.5 * sinzf * sinzf - 0.25;
+  double f3 = -0.5 * sinzf * cos(zf);
+  double ses = rec.se2 * f2 + rec.se3 * f3;
+  double sis = rec.si2 * f2 + rec.si3 * f3;
+  double sls = rec.sl2 * f2 + rec.sl3 * f3 + rec.sl4 * sinzf;
+  double sghs = rec.sgh2 * f2 + rec.sgh3 * f3 + rec.sgh4 * sinzf;
+  double shs = rec.sh2 * f2 + rec.sh3 * f3;
+  // Lunar terms
+  zm = init ? rec.zmol : rec.zmol + znl * t;
+  zf = zm + 2.0 * zel * sin(zm);
+  sinzf = sin(zf);
+  f2 = 0.5 * sinzf * sinzf - 0.25;
+  f3 = -0.5 * sinzf * cos(zf);
+  double sel = rec.ee2 * f2 + rec.e3 * f3;
+  double sil = rec.xi2 * f2 + rec.xi3 * f3;
+  double sll = rec.xl2 * f2 + rec.xl3 * f3 + rec.xl4 * sinzf;
+  double sghl = rec.xgh2 * f2 + rec.xgh3 * f3 + rec.xgh4 * sinzf;
+  double shll = rec.xh2 * f2 + rec.xh3 * f3;
+  if (init) {
+    return;
+  }
+  double pe = ses + sel - rec.peo;
+  double pinc = sis + sil - rec.pinco;
+  double pl = sls + sll - rec.plo;
+  double pgh = sghs + sghl - rec.pgho;
+  double ph = shs + shll - rec.pho;
+  inclp = inclp + pinc;
+  ep = ep + pe;
+  double sinip = sin(inclp), cosip = cos(inclp);
+  if (inclp >= 0.2) {
+    // Apply periodics directly
+    ph = ph / sinip;
+    pgh = pgh - cosip * ph;
+    argpp = argpp + pgh;
+    nodep = nodep + ph;
+    mp = mp + pl;
+  } else {
+    // Apply periodics with the Lyddane modification
+    double sinop = sin(nodep), cosop = cos(nodep);
+    double alfdp = sinip * sinop;
+    double betdp = sinip * cosop;
+    double dalf = ph * cosop + pinc * cosip * sinop;
+    double dbet = -ph * sinop + pinc * cosip * cosop;
+    alfdp = alfdp + dalf;
+    betdp = betdp + dbet;
+    nodep = fmod(nodep, TWO_PI);
+    double xls = mp + argpp + cosip * nodep;
+    double dls = pl + pgh - pinc * nodep * sinip;
+    xls = xls + dls;
+    double xnoh = nodep;
+    nodep = atan2(alfdp, betdp);
+    if (fabs(xnoh - nodep) > M_PI) {
+      nodep = nodep < xnoh ? nodep + TWO_PI : nodep - TWO_PI;
+    }
+    mp = mp + pl;
+    argpp = xls - mp - cosip * nodep;
+  }
+}
+
+// Deep space secular rates and resonance coefficients
+static void dsinit(SGP4Record &rec, DeepSpaceCommon &ds, double eccsq,
+                   double xpidot, double inclm) {
+  const double q22 = 1.7891679e-6, q31 = 2.1460748e-6, q33 = 2.2123015e-7,
+               root22 = 1.7891679e-6, root44 = 7.3636953e-9,
+               root54 = 2.1765803e-9, rptim = 4.37526908801129966e-3,
+               root32 = 3.7393792e-7, root52 = 1.1428639e-7,
+               znl = 1.5835218e-4, zns = 1.19459e-5;
+  double nm = ds.nm, em = ds.em, emsq = ds.emsq;
+  double sinim = ds.sinim, cosim = ds.cosim;
+  // Determine if the orbit is resonant
+  rec.irez = 0;
+  if (nm < 0.0052359877 && nm > 0.0034906585) {
+    rec.irez = 1;
+  }
+  if (nm >= 8.26e-3 && nm <= 9.24e-3 && em >= 0.5) {
+    rec.irez = 2;
+  }
+  // Solar terms
+  double ses = ds.ss1 * zns * ds.ss5;
+  double sis = ds.ss2 * zns * (ds.sz11 + ds.sz13);
+  double sls = -zns * ds.ss3 * (ds.sz1 + ds.sz3 - 14.0 - 6.0 * emsq);
+  double sghs = ds.ss4 * zns * (ds.sz31 + ds.sz33 - 6.0);
+  double shs = -zns * ds.ss2 * (ds.sz21 + ds.sz23);
+  if (inclm < 5.2359877e-2 || inclm > M_PI - 5.2359877e-2) {
+    shs = 0.0;
+  }
+  if (sinim != 0.0) {
+    shs = shs / sinim;
+  }
+  double sgs = sghs - cosim * shs;
+  // Lunar terms
+  rec.dedt = ses + ds.s1 * znl * ds.s5;
+  rec.didt = sis + ds.s2 * znl * (ds.z11 + ds.z13);
+  rec.dmdt = sls - znl * ds.s3 * (ds.z1 + ds.z3 - 14.0 - 6.0 * emsq);
+  double sghl = ds.s4 * znl * (ds.z31 + ds.z33 - 6.0);
+  double shll = -znl * ds.s2 * (ds.z21 + ds.z23);
+  if (inclm < 5.2359877e-2 || inclm > M_PI - 5.2359877e-2) {
+    shll = 0.0;
+  }
+  rec.domdt = sgs + sghl;
+  rec.dnodt = shs;
+  if (sinim != 0.0) {
+    rec.domdt = rec.domdt - cosim / sinim * shll;
+    rec.dnodt = rec.dnodt + shll / sinim;
+  }
+  if (rec.irez == 0) {
+    return;
+  }
+  // Deep space resonance effects
+  double theta = fmod(rec.gsto, TWO_PI);
+  double aonv = pow(nm / XKE, X2O3);
+  if (rec.irez == 2) {
+    // Geopotential resonance for 12 hour orbits
+    double cosisq = cosim * cosim;
+    em = rec.ecco;
+    emsq = eccsq;
+    double eoc = em * emsq;
+    double g201 = -0.306 - (em - 0.64) * 0.440;
+    double g211, g310, g322, g410, g422, g520, g521, g532, g533;
+    if (em <= 0.65) {
+      g211 = 3.616 - 13.2470 * em + 16.2900 * emsq;
+      g310 = -19.302 + 117.3900 * em - 228.4190 * emsq + 156.5910 * eoc;
+      g322 = -18.9068 + 109.7927 * em - 214.6334 * emsq + 146.5816 * eoc;
+      g410 = -41.122 + 242.6940 * em - 471.0940 * emsq + 313.9530 * eoc;
+      g422 = -146.407 + 841.8800 * em - 1629.014 * emsq + 1083.4350 * eoc;
+      g520 = -532.114 + 3017.977 * em - 5740.032 * emsq + 3708.2760 * eoc;
+    } else {
+      g211 = -72.099 + 331.819 * em - 508.738 * emsq + 266.724 * eoc;
+      g310 = -346.844 + 1582.851 * em - 2415.925 * emsq + 1246.113 * eoc;
+      g322 = -342.585 + 1554.908 * em - 2366.899 * emsq + 1215.972 * eoc;
+      g410 = -1052.797 + 4758.686 * em - 7193.992 * emsq + 3651.957 * eoc;
+      g422 = -3581.690 + 16178.110 * em - 24462.770 * emsq + 12422.520 * eoc;
+      if (em > 0.715) {
+        g520 = -5149.66 + 29936.92 * em - 54087.36 * emsq + 31324.56 * eoc;
+      } else {
+        g520 = 1464.74 - 4664.75 * em + 3763.64 * emsq;
+      }
+    }
+    if (em < 0.7) {
+      g533 = -919.22770 + 4988.6100 * em - 9064.7700 * emsq + 5542.21 * eoc;
+      g521 = -822.71072 + 4568.6173 * em - 8491.4146 * emsq + 5337.524 * eoc;
+      g532 = -853.66600 + 4690.2500 * em - 8624.7700 * emsq + 5341.4 * eoc;
+    } else {
+      g533 = -37995.780 + 161616.52 * em - 229838.20 * emsq + 109377.94 * eoc;
+      g521 = -51752.104 + 218913.95 * em - 309468.16 * emsq + 146349.42 * eoc;
+      g532 = -40023.880 + 170470.89 * em - 242699.48 * emsq + 115605.82 * eoc;
+    }
+    double sini2 = sinim * sinim;
+    double f220 = 0.75 * (1.0 + 2.0 * cosim + cosisq);
+    double f221 = 1.5 * sini2;
+    double f321 = 1.875 * sinim * (1.0 - 2.0 * cosim - 3.0 * cosisq);
+    double f322 = -1.875 * sinim * (1.0 + 2.0 * cosim - 3.0 * cosisq);
+    double f441 = 35.0 * sini2 * f220;
+    double f442 = 39.3750 * sini2 * sini2;
+    double f522 = 9.84375 * sinim *
+                  (sini2 * (1.0 - 2.0 * cosim - 5.0 * cosisq) +
+                   0.33333333 * (-2.0 + 4.0 * cosim + 6.0 * cosisq));
+    double f523 = sinim * (4.92187512 * sini2 * (-2.0 - 4.0 * cosim + 10.0 * cosisq) +
+                           6.56250012 * (1.0 + 2.0 * cosim - 3.0 * cosisq));
+    double f542 = 29.53125 * sinim *
+                  (2.0 - 8.0 * cosim + cosisq * (-12.0 + 8.0 * cosim + 10.0 * cosisq));
+    double f543 = 29.53125 * sinim *
+                  (-2.0 - 8.0 * cosim + cosisq * (12.0 + 8.0 * cosim - 10.0 * cosisq));
+    double xno2 = nm * nm;
+    double ainv2 = aonv * aonv;
+    double temp1 = 3.0 * xno2 * ainv2;
+    double temp = temp1 * root22;
+    rec.d2201 = temp * f220 * g201;
+    rec.d2211 = temp * f221 * g211;
+    temp1 = temp1 * aonv;
+    temp = temp1 * root32;
+    rec.d3210 = temp * f321 * g310;
+    rec.d3222 = temp * f322 * g322;
+    temp1 = temp1 * aonv;
+    temp = 2.0 * temp1 * root44;
+    rec.d4410 = temp * f441 * g410;
+    rec.d4422 = temp * f442 * g422;
+    temp1 = temp1 * aonv;
+    temp = temp1 * root52;
+    rec.d5220 = temp * f522 * g520;
+    rec.d5232 = temp * f523 * g532;
+    temp = 2.0 * temp1 * root54;
+    rec.d5421 = temp * f542 * g521;
+    rec.d5433 = temp * f543 * g533;
+    rec.xlamo = fmod(rec.mo + rec.nodeo + rec.nodeo - theta - theta, TWO_PI);
+    rec.xfact = rec.mdot + rec.dmdt + 2.0 * (rec.nodedot + rec.dnodt - rptim) - rec.no;
+  } else {
+    // Synchronous resonance terms
+    double g200 = 1.0 + emsq * (-2.5 + 0.8125 * emsq);
+    double g310 = 1.0 + 2.0 * emsq;
+    double g300 = 1.0 + emsq * (-6.0 + 6.60937 * emsq);
+    double f220 = 0.75 * (1.0 + cosim) * (1.0 + cosim);
+    double f311 = 0.9375 * sinim * sinim * (1.0 + 3.0 * cosim) - 0.75 * (1.0 + cosim);
+    double f330 = 1.0 + cosim;
+    f330 = 1.875 * f330 * f330 * f330;
+    rec.del1 = 3.0 * nm * nm * aonv * aonv;
+    rec.del2 = 2.0 * rec.del1 * f220 * g200 * q22;
+    rec.del3 = 3.0 * rec.del1 * f330 * g300 * q33 * aonv;
+    rec.del1 = rec.del1 * f311 * g310 * q31 * aonv;
+    rec.xlamo = fmod(rec.mo + rec.nodeo + rec.argpo - theta, TWO_PI);
+    rec.xfact = rec.mdot + xpidot - rptim + rec.dmdt + rec.domdt + rec.dnodt - rec.no;
+  }
+}
+
+// Deep space secular effects and resonance integration (always integrated
+// from the element epoch)
+static void dspace(SGP4Record &rec, double t, double &em, double &argpm,
+                   double &inclm, double &mm, double &nodem, double &nm) {
+  const double fasx2 = 0.13130908, fasx4 = 2.8843198, fasx6 = 0.37448087,
+               g22 = 5.7686396, g32 = 0.95240898, g44 = 1.8014998,
+               g52 = 1.0508330, g54 = 4.4108898,
+               rptim = 4.37526908801129966e-3, stepp = 720.0, stepn = -720.0,
+               step2 = 259200.0;
+  double theta = fmod(rec.gsto + t * rptim, TWO_PI);
+  em = em + rec.dedt * t;
+  inclm = inclm + rec.didt * t;
+  argpm = argpm + rec.domdt * t;
+  nodem = nodem + rec.dnodt * t;
+  mm = mm + rec.dmdt * t;
+  if (rec.irez == 0) {
+    return;
+  }
+  double atime = 0.0, xni = rec.no, xli = rec.xlamo;
+  double delt = t > 0.0 ? stepp : stepn;
+  double ft = 0.0, xndt = 0.0, xldot = 0.0, xnddt = 0.0;
+  while (true) {
+    if (rec.irez != 2) {
+      // Near-synchronous resonance terms
+      xndt = rec.del1 * sin(xli - fasx2) + rec.del2 * sin(2.0 * (xli - fasx4)) +
+             rec.del3 * sin(3.0 * (xli - fasx6));
+      xldot = xni + rec.xfact;
+      xnddt = rec.del1 * cos(xli - fasx2) + 2.0 * rec.del2 * cos(2.0 * (xli - fasx4)) +
+              3.0 * rec.del3 * cos(3.0 * (xli - fasx6));
+      xnddt = xnddt * xldot;
+    } else {
+      // Near half-day resonance terms
+      double xomi = rec.argpo + rec.argpdot * atime;
+      double x2omi = xomi + xomi;
+      double x2li = xli + xli;
+      xndt = rec.d2201 * sin(x2omi + xli - g22) + rec.d2211 * sin(xli - g22) +
+             rec.d3210 * sin(xomi + xli - g32) + rec.d3222 * sin(-xomi + xli - g32) +
+             rec.d4410 * sin(x2omi + x2li - g44) + rec.d4422 * sin(x2li - g44) +
+             rec.d5220 * sin(xomi + xli - g52) + rec.d5232 * sin(-xomi + xli - g52) +
+             rec.d5421 * sin(xomi + x2li - g54) + rec.d5433 * sin(-xomi + x2li - g54);
+      xldot = xni + rec.xfact;
+      xnddt = rec.d2201 * cos(x2omi + xli - g22) + rec.d2211 * cos(xli - g22) +
+              rec.d3210 * cos(xomi + xli - g32) + rec.d3222 * cos(-xomi + xli - g32) +
+              rec.d5220 * cos(xomi + xli - g52) + rec.d5232 * cos(-xomi + xli - g52) +
+              2.0 * (rec.d4410 * cos(x2omi + x2li - g44) + rec.d4422 * cos(x2li - g44) +
+                     rec.d5421 * cos(xomi + x2li - g54) +
+                     rec.d5433 * cos(-xomi + x2li - g54));
+      xnddt = xnddt * xldot;
+    }
+    if (fabs(t - atime) < stepp) {
+      ft = t - atime;
+      break;
+    }
+    xli = xli + xldot * delt + xndt * step2;
+    xni = xni + xndt * delt + xnddt * step2;
+    atime = atime + delt;
+  }
+  nm = xni + xndt * ft + xnddt * ft * ft * 0.5;
+  double xl = xli + xldot * ft + xndt * ft * ft * 0.5;
+  if (rec.irez != 1) {
+    mm = xl - 2.0 * nodem + 2.0 * theta;
+  } else {
+    mm = xl - nodem - argpm + theta;
+  }
+}
+
+/*
+SGP4Propagator class methods
+*/
+
+// Default constructor
+SGP4Propagator::SGP4Propagator() : record() {}
+
+// Constructor from a two-line element set
+SGP4Propagator::SGP4Propagator(TwoLineElement &elements) : record() {
+  this->elements = elements;
+  SGP4Record &rec = record;
+  rec.bstar = elements.bstar;
+  rec.ecco = elements.eccentricity;
+  rec.inclo = elements.inclination;
+  rec.nodeo = elements.raan;
+  rec.argpo = elements.arg_perigee;
+  rec.mo = elements.mean_anomaly;
+  double epoch = elements.epoch_ds50;
+  double ss = 78.0 / SGP4_RADIUS + 1.0;
+  double qzms2t = pow((120.0 - 78.0) / SGP4_RADIUS, 4);
+  // Recover the original mean motion and semi-major axis (initl)
+  double eccsq = rec.ecco * rec.ecco;
+  double omeosq = 1.0 - eccsq;
+  double rteosq = sqrt(omeosq);
+  double cosio = cos(rec.inclo);
+  double cosio2 = cosio * cosio;
+  double ak = pow(XKE / elements.mean_motion, X2O3);
+  double d1 = 0.75 * SGP4_J2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+  double del = d1 / (ak * ak);
+  double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+  del = d1 / (adel * adel);
+  rec.no = elements.mean_motion / (1.0 + del);
+  double ao = pow(XKE / rec.no, X2O3);
+  double sinio = sin(rec.inclo);
+  double po = ao * omeosq;
+  double con42 = 1.0 - 5.0 * cosio2;
+  rec.con41 = -con42 - cosio2 - cosio2;
+  double posq = po * po;
+  double rp = ao * (1.0 - rec.ecco);
+  rec.gsto = gstime(epoch + SGP4_JD_1950);
+  if (omeosq <= 0.0 || rec.no <= 0.0) {
+    std::stringstream msg;
+    msg << "SGP4Propagator exception: Invalid mean elements for object "
+        << elements.satnum;
+    throw ArcException(msg.str());
+  }
+  // Use the simplified drag model for perigee heights below 220 km
+  rec.simple = rp < (220.0 / SGP4_RADIUS + 1.0);
+  double sfour = ss;
+  double qzms24 = qzms2t;
+  double perige = (rp - 1.0) * SGP4_RADIUS;
+  // Adjust the atmospheric density parameter for perigees below 156 km
+  if (perige < 156.0) {
+    sfour = perige < 98.0 ? 20.0 : perige - 78.0;
+    qzms24 = pow((120.0 - sfour) / SGP4_RADIUS, 4);
+    sfour = sfour / SGP4_RADIUS + 1.0;
+  }
+  double pinvsq = 1.0 / posq;
+  double tsi = 1.0 / (ao - sfour);
+  rec.eta = ao * rec.ecco * tsi;
+  double etasq = rec.eta * rec.eta;
+  double eeta = rec.ecco * rec.eta;
+  double psisq = fabs(1.0 - etasq);
+  double coef = qzms24 * pow(tsi, 4);
+  double coef1 = coef / pow(psisq, 3.5);
+  double cc2 = coef1 * rec.no *
+               (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+                0.375 * SGP4_J2 * tsi / psisq * rec.con41 *
+                    (8.0 + 3.0 * etasq * (8.0 + etasq)));
+  rec.cc1 = rec.bstar * cc2;
+  double cc3 = 0.0;
+  if (rec.ecco > 1.0e-4) {
+    cc3 = -2.0 * coef * tsi * J3OJ2 * rec.no * sinio / rec.ecco;
+  }
+  rec.x1mth2 = 1.0 - cosio2;
+  rec.cc4 = 2.0 * rec.no * coef1 * ao * omeosq *
+            (rec.eta * (2.0 + 0.5 * etasq) + rec.ecco * (0.5 + 2.0 * etasq) -
+             SGP4_J2 * tsi / (ao * psisq) *
+                 (-3.0 * rec.con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                  0.75 * rec.x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) *
+                      cos(2.0 * rec.argpo)));
+  rec.cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+  // Secular rates of the mean anomaly, perigee and node
+  double cosio4 = cosio2 * cosio2;
+  double temp1 = 1.5 * SGP4_J2 * pinvsq * rec.no;
+  double temp2 = 0.5 * temp1 * SGP4_J2 * pinvsq;
+  double temp3 = -0.46875 * SGP4_J4 * pinvsq * pinvsq * rec.no;
+  rec.mdot = rec.no + 0.5 * temp1 * rteosq * rec.con41 +
+             0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+  rec.argpdot = -0.5 * temp1 * con42 +
+                0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+                temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+  double xhdot1 = -temp1 * cosio;
+  rec.nodedot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) +
+                          2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+  double xpidot = rec.argpdot + rec.nodedot;
+  rec.omgcof = rec.bstar * cc3 * cos(rec.argpo);
+  rec.xmcof = 0.0;
+  if (rec.ecco > 1.0e-4) {
+    rec.xmcof = -X2O3 * coef * rec.bstar / eeta;
+  }
+  rec.nodecf = 3.5 * omeosq * xhdot1 * rec.cc1;
+  rec.t2cof = 1.5 * rec.cc1;
+  // Avoid a divide by zero for an inclination of 180 degrees
+  double cosio_1 = fabs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : 1.5e-12;
+  rec.xlcof = -0.25 * J3OJ2 * sinio * (3.0 + 5.0 * cosio) / cosio_1;
+  rec.aycof = -0.5 * J3OJ2 * sinio;
+  double delmotemp = 1.0 + rec.eta * cos(rec.mo);
+  rec.delmo = delmotemp * delmotemp * delmotemp;
+  rec.sinmao = sin(rec.mo);
+  rec.x7thm1 = 7.0 * cosio2 - 1.0;
+  // Deep space initialization for periods of 225 minutes or longer
+  rec.deep_space = TWO_PI / rec.no >= 225.0;
+  if (rec.deep_space) {
+    rec.simple = true;
+    DeepSpaceCommon ds{};
+    dscom(epoch, rec.ecco, rec.argpo, 0.0, rec.inclo, rec.nodeo, rec.no, rec, ds);
+    dsinit(rec, ds, eccsq, xpidot, rec.inclo);
+  }
+  // Higher-order drag terms are only used by the full drag model
+  if (!rec.simple) {
+    double cc1sq = rec.cc1 * rec.cc1;
+    rec.d2 = 4.0 * ao * tsi * cc1sq;
+    double temp = rec.d2 * tsi * rec.cc1 / 3.0;
+    rec.d3 = (17.0 * ao + sfour) * temp;
+    rec.d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * rec.cc1;
+    rec.t3cof = rec.d2 + 2.0 * cc1sq;
+    rec.t4cof = 0.25 * (3.0 * rec.d3 + rec.cc1 * (12.0 * rec.d2 + 10.0 * cc1sq));
+    rec.t5cof = 0.2 * (3.0 * rec.d4 + 12.0 * rec.cc1 * rec.d3 + 6.0 * rec.d2 * rec.d2 +
+                       15.0 * cc1sq * (2.0 * rec.d2 + cc1sq));
+  }
+}
+
+// Propagate the elements in the model's native TEME frame
+SGP4Error SGP4Propagator::propagate_teme(double tsince, double r[3], double v[3]) {
+  SGP4Record &rec = record;
+  double t = tsince;
+  // Secular gravity and atmospheric drag
+  double xmdf = rec.mo + rec.mdot * t;
+  double argpdf = rec.argpo + rec.argpdot * t;
+  double nodedf = rec.nodeo + rec.nodedot * t;
+  double argpm = argpdf;
+  double mm = xmdf;
+  double t2 = t * t;
+  double nodem = nodedf + rec.nodecf * t2;
+  double tempa = 1.0 - rec.cc1 * t;
+  double tempe = rec.bstar * rec.cc4 * t;
+  double templ = rec.t2cof * t2;
+  if (!rec.simple) {
+    double delomg = rec.omgcof * t;
+    double delmtemp = 1.0 + rec.eta * cos(xmdf);
+    double delm = rec.xmcof * (delmtemp * delmtemp * delmtemp - rec.delmo);
+    double temp = delomg + delm;
+    mm = xmdf + temp;
+    argpm = argpdf - temp;
+    double t3 = t2 * t;
+    double t4 = t3 * t;
+    tempa = tempa - rec.d2 * t2 - rec.d3 * t3 - rec.d4 * t4;
+    tempe = tempe + rec.bstar * rec.cc5 * (sin(mm) - rec.sinmao);
+    templ = templ + rec.t3cof * t3 + t4 * (rec.t4cof + t * rec.t5cof);
+  }
+  double nm = rec.no;
+  double em = rec.ecco;
+  double inclm = rec.inclo;
+  if (rec.deep_space) {
+    dspace(rec, t, em, argpm, inclm, mm, nodem, nm);
+  }
+  if (nm <= 0.0) {
+    return SGP4_MEAN_MOTION;
+  }
+  double am = pow(XKE / nm, X2O3) * tempa * tempa;
+  nm = XKE / pow(am, 1.5);
+  em = em - tempe;
+  if (em >= 1.0 || em < -0.001) {
+    return SGP4_ECCENTRICITY;
+  }
+  em = std::max(em, 1.0e-6);
+  mm = mm + rec.no * templ;
+  double xlm = mm + argpm + nodem;
+  nodem = fmod(nodem, TWO_PI);
+  argpm = fmod(argpm, TWO_PI);
+  xlm = fmod(xlm, TWO_PI);
+  mm = fmod(xlm - argpm - nodem, TWO_PI);
+  // Lunar-solar periodics
+  double ep = em, xincp = inclm, argpp = argpm, nodep = nodem, mp = mm;
+  double sinip = sin(inclm), cosip = cos(inclm);
+  double aycof = rec.aycof, xlcof = rec.xlcof;
+  double con41 = rec.con41, x1mth2 = rec.x1mth2, x7thm1 = rec.x7thm1;
+  if (rec.deep_space) {
+    dpper(rec, t, false, ep, xincp, nodep, argpp, mp);
+    if (xincp < 0.0) {
+      xincp = -xincp;
+      nodep = nodep + M_PI;
+      argpp = argpp - M_PI;
+    }
+    if (ep < 0.0 || ep > 1.0) {
+      return SGP4_PERTURBED_ECCENTRICITY;
+    }
+    sinip = sin(xincp);
+    cosip = cos(xincp);
+    aycof = -0.5 * J3OJ2 * sinip;
+    double cosip_1 = fabs(cosip + 1.0) > 1.5e-12 ? 1.0 + cosip : 1.5e-12;
+    xlcof = -0.25 * J3OJ2 * sinip * (3.0 + 5.0 * cosip) / cosip_1;
+    double cosisq = cosip * cosip;
+    con41 = 3.0 * cosisq - 1.0;
+    x1mth2 = 1.0 - cosisq;
+    x7thm1 = 7.0 * cosisq - 1.0;
+  }
+  // Long period periodics
+  double axnl = ep * cos(argpp);
+  double temp = 1.0 / (am * (1.0 - ep * ep));
+  double aynl = ep * sin(argpp) + temp * aycof;
+  double xl = mp + argpp + nodep + temp * xlcof * axnl;
+  // Solve Kepler's equation
+  double u = fmod(xl - nodep, TWO_PI);
+  double eo1 = u, tem5 = 9999.9, sineo1 = 0.0, coseo1 = 0.0;
+  for (int ktr = 1; fabs(tem5) >= 1.0e-12 && ktr <= 10; ktr++) {
+    sineo1 = sin(eo1);
+    coseo1 = cos(eo1);
+    tem5 = 1.0 - coseo1 * axnl - sineo1 * aynl;
+    tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+    tem5 = std::max(-0.95, std::min(tem5, 0.95));
+    eo1 = eo1 + tem5;
+  }
+  // Short period preliminary quantities
+  double ecose = axnl * coseo1 + aynl * sineo1;
+  double esine = axnl * sineo1 - aynl * coseo1;
+  double el2 = axnl * axnl + aynl * aynl;
+  double pl = am * (1.0 - el2);
+  if (pl < 0.0) {
+    return SGP4_SEMI_LATUS_RECTUM;
+  }
+  double rl = am * (1.0 - ecose);
+  double rdotl = sqrt(am) * esine / rl;
+  double rvdotl = sqrt(pl) / rl;
+  double betal = sqrt(1.0 - el2);
+  temp = esine / (1.0 + betal);
+  double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+  double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+  double su = atan2(sinu, cosu);
+  double sin2u = (cosu + cosu) * sinu;
+  double cos2u = 1.0 - 2.0 * sinu * sinu;
+  temp = 1.0 / pl;
+  double temp1 = 0.5 * SGP4_J2 * temp;
+  double temp2 = temp1 * temp;
+  // Update for short period periodics
+  double mrt = rl * (1.0 - 1.5 * temp2 * betal * con41) + 0.5 * temp1 * x1mth2 * cos2u;
+  su = su - 0.25 * temp2 * x7thm1 * sin2u;
+  double xnode = nodep + 1.5 * temp2 * cosip * sin2u;
+  double xinc = xincp + 1.5 * temp2 * cosip * sinip * cos2u;
+  double mvt = rdotl - nm * temp1 * x1mth2 * sin2u / XKE;
+  double rvdot = rvdotl + nm * temp1 * (x1mth2 * cos2u + 1.5 * con41) / XKE;
+  // Orientation vectors
+  double sinsu = sin(su), cossu = cos(su);
+  double snod = sin(xnode), cnod = cos(xnode);
+  double sini = sin(xinc), cosi = cos(xinc);
+  double xmx = -snod * cosi;
+  double xmy = cnod * cosi;
+  double ux = xmx * sinsu + cnod * cossu;
+  double uy = xmy * sinsu + snod * cossu;
+  double uz = sini * sinsu;
+  double vx = xmx * cossu - cnod * sinsu;
+  double vy = xmy * cossu - snod * sinsu;
+  double vz = sini * cossu;
+  // Position and velocity in km and km/s
+  double vkmpersec = SGP4_RADIUS * XKE / 60.0;
+  r[0] = mrt * ux * SGP4_RADIUS;
+  r[1] = mrt * uy * SGP4_RADIUS;
+  r[2] = mrt * uz * SGP4_RADIUS;
+  v[0] = (mvt * ux + rvdot * vx) * vkmpersec;
+  v[1] = (mvt * uy + rvdot * vy) * vkmpersec;
+  v[2] = (mvt * uz + rvdot * vz) * vkmpersec;
+  if (mrt < 1.0) {
+    return SGP4_DECAYED;
+  }
+  return SGP4_OK;
+}
+
+// Propagate the elements to specified epoch
+ICRF SGP4Propagator::propagate(DateTime &epoch) {
+  double tsince = epoch.difference(elements.epoch) / 60.0;
+  double r[3], v[3];
+  SGP4Error error = propagate_teme(tsince, r, v);
+  if (error != SGP4_OK) {
+    std::stringstream msg;
+    msg << "SGP4Propagator::propagate exception: Unable to propagate object "
+        << elements.satnum << " to " << epoch.to_iso() << " (SGP4 error "
+        << error << ")";
+    throw ArcException(msg.str());
+  }
+  Vector3 pos{r[0] * 1000.0, r[1] * 1000.0, r[2] * 1000.0};
+  Vector3 vel{v[0] * 1000.0, v[1] * 1000.0, v[2] * 1000.0};
+  TEME teme{EARTH, epoch, pos, vel};
+  return ICRF{teme};
+}
+
+/*
+Packed near-earth model constants of a catalog (one array per constant)
+*/
+struct NearEarthBlock {
+  // Index of each element set in the catalog
+  std::vector<size_t> index;
+  // Element epochs as whole and fractional seconds since J2000, kept split
+  // so the time since epoch is as exact as DateTime::difference
+  std::vector<double> epoch_whole, epoch_fraction;
+  std::vector<double> mo, mdot, argpo, argpdot, nodeo, nodedot, nodecf, cc1,
+    cc4, cc5, bstar, omgcof, xmcof, eta, delmo, sinmao, d2, d3, d4, t2cof,
+    t3cof, t4cof, t5cof, no, a0, ecco, inclo, aycof, xlcof, con41, x1mth2,
+    x7thm1, sinio, cosio;
+
+  // Append the constants of an element set
+  void push_back(size_t i, SGP4Propagator &prop) {
+    SGP4Record &rec = prop.record;
+    // The full drag terms are zero in the simplified model, so both models
+    // can share the same branch-free evaluation
+    double full = rec.simple ? 0.0 : 1.0;
+    index.push_back(i);
+    epoch_whole.push_back((double)prop.elements.epoch.whole_seconds);
+    epoch_fraction.push_back(prop.elements.epoch.fraction);
+    mo.push_back(rec.mo);
+    mdot.push_back(rec.mdot);
+    argpo.push_back(rec.argpo);
+    argpdot.push_back(rec.argpdot);
+    nodeo.push_back(rec.nodeo);
+    nodedot.push_back(rec.nodedot);
+    nodecf.push_back(rec.nodecf);
+    cc1.push_back(rec.cc1);
+    cc4.push_back(rec.cc4);
+    cc5.push_back(rec.cc5 * full);
+    bstar.push_back(rec.bstar);
+    omgcof.push_back(rec.omgcof * full);
+    xmcof.push_back(rec.xmcof * full);
+    eta.push_back(rec.eta);
+    delmo.push_back(rec.delmo);
+    sinmao.push_back(rec.sinmao);
+    d2.push_back(rec.d2 * full);
+    d3.push_back(rec.d3 * full);
+    d4.push_back(rec.d4 * full);
+    t2cof.push_back(rec.t2cof);
+    t3cof.push_back(rec.t3cof * full);
+    t4cof.push_back(rec.t4cof * full);
+    t5cof.push_back(rec.t5cof * full);
+    no.push_back(rec.no);
+    a0.push_back(pow(XKE / rec.no, X2O3));
+    ecco.push_back(rec.ecco);
+    inclo.push_back(rec.inclo);
+    aycof.push_back(rec.aycof);
+    xlcof.push_back(rec.xlcof);
+    con41.push_back(rec.con41);
+    x1mth2.push_back(rec.x1mth2);
+    x7thm1.push_back(rec.x7thm1);
+    sinio.push_back(sin(rec.inclo));
+    cosio.push_back(cos(rec.inclo));
+  }
+
+  /*
+  Evaluate every element set at a single epoch
+
+  A transcription of SGP4Propagator::propagate_teme for near-earth element
+  sets, split into passes over the packed constants with no data-dependent
+  branches so each pass can be vectorized: the secular and long period terms,
+  ten masked Newton iterations of Kepler's equation, then the short period
+  terms. Operations are evaluated in the same order as the scalar propagator,
+  so both give the same states. Error conditions are folded into a NaN result.
+
+  @param at Epoch of evaluation
+  @param work Scratch space of at least 11 * size() values
+  @param out Array of 6 * size() TEME positions/velocities (km, km/s)
+  */
+  void propagate(DateTime &at, double *work, double *out) {
+    const double vkmpersec = SGP4_RADIUS * XKE / 60.0;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    size_t n = index.size();
+    double *am_ = work, *nm_ = work + n, *nodem_ = work + 2 * n,
+           *axnl_ = work + 3 * n, *aynl_ = work + 4 * n, *u_ = work + 5 * n,
+           *eo1_ = work + 6 * n, *sineo1_ = work + 7 * n,
+           *coseo1_ = work + 8 * n, *active_ = work + 9 * n,
+           *valid_ = work + 10 * n;
+    double at_whole = (double)at.whole_seconds, at_fraction = at.fraction;
+    // Secular gravity, atmospheric drag and long period periodics
+    for (size_t i = 0; i < n; i++) {
+      double t = ((at_whole - epoch_whole[i]) +
+                  (at_fraction - epoch_fraction[i])) / 60.0;
+      double t2 = t * t, t3 = t2 * t, t4 = t3 * t;
+      double xmdf = mo[i] + mdot[i] * t;
+      double delmtemp = 1.0 + eta[i] * cos(xmdf);
+      double temp = omgcof[i] * t +
+                    xmcof[i] * (delmtemp * delmtemp * delmtemp - delmo[i]);
+      double mm = xmdf + temp;
+      double argpm = argpo[i] + argpdot[i] * t - temp;
+      double nodem = nodeo[i] + nodedot[i] * t + nodecf[i] * t2;
+      double tempa = 1.0 - cc1[i] * t - d2[i] * t2 - d3[i] * t3 - d4[i] * t4;
+      double tempe = bstar[i] * cc4[i] * t +
+                     bstar[i] * cc5[i] * (sin(mm) - sinmao[i]);
+      double templ = t2cof[i] * t2 + t3cof[i] * t3 + t4 * (t4cof[i] + t * t5cof[i]);
+      double am = a0[i] * tempa * tempa;
+      double em = ecco[i] - tempe;
+      valid_[i] = (em < 1.0 && em >= -0.001) ? 1.0 : 0.0;
+      em = std::max(em, 1.0e-6);
+      mm = mm + no[i] * templ;
+      // Reduce the angles as the scalar propagator does (fmod is exact)
+      double xlm = mm + argpm + nodem;
+      nodem = fmod(nodem, TWO_PI);
+      argpm = fmod(argpm, TWO_PI);
+      xlm = fmod(xlm, TWO_PI);
+      mm = fmod(xlm - argpm - nodem, TWO_PI);
+      double axnl = em * cos(argpm);
+      temp = 1.0 / (am * (1.0 - em * em));
+      double aynl = em * sin(argpm) + temp * aycof[i];
+      double xl = mm + argpm + nodem + temp * xlcof[i] * axnl;
+      double u = fmod(xl - nodem, TWO_PI);
+      am_[i] = am;
+      nm_[i] = XKE / pow(am, 1.5);
+      nodem_[i] = nodem;
+      axnl_[i] = axnl;
+      aynl_[i] = aynl;
+      u_[i] = u;
+      eo1_[i] = u;
+      active_[i] = 1.0;
+    }
+    // Solve Kepler's equation; an element set stops updating after the step
+    // that falls below the tolerance, keeping the sine and cosine that step
+    // was computed from
+    for (int k = 0; k < 10; k++) {
+      for (size_t i = 0; i < n; i++) {
+        bool active = active_[i] > 0.0;
+        double eo1 = eo1_[i];
+        double sineo1 = sin(eo1), coseo1 = cos(eo1);
+        double tem5 = (u_[i] - aynl_[i] * coseo1 + axnl_[i] * sineo1 - eo1) /
+                      (1.0 - coseo1 * axnl_[i] - sineo1 * aynl_[i]);
+        tem5 = std::max(-0.95, std::min(tem5, 0.95));
+        eo1_[i] = active ? eo1 + tem5 : eo1;
+        sineo1_[i] = active ? sineo1 : sineo1_[i];
+        coseo1_[i] = active ? coseo1 : coseo1_[i];
+        active_[i] = (active && fabs(tem5) >= 1.0e-12) ? 1.0 : 0.0;
+      }
+    }
+    // Short period periodics and orientation
+    for (size_t i = 0; i < n; i++) {
+      double am = am_[i], nm = nm_[i], axnl = axnl_[i], aynl = aynl_[i];
+      double sineo1 = sineo1_[i], coseo1 = coseo1_[i];
+      double ecose = axnl * coseo1 + aynl * sineo1;
+      double esine = axnl * sineo1 - aynl * coseo1;
+      double el2 = axnl * axnl + aynl * aynl;
+      double pl = am * (1.0 - el2);
+      double rl = am * (1.0 - ecose);
+      double rdotl = sqrt(am) * esine / rl;
+      double rvdotl = sqrt(fabs(pl)) / rl;
+      double betal = sqrt(fabs(1.0 - el2));
+      double temp = esine / (1.0 + betal);
+      double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+      double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+      double su = atan2(sinu, cosu);
+      double sin2u = (cosu + cosu) * sinu;
+      double cos2u = 1.0 - 2.0 * sinu * sinu;
+      temp = 1.0 / pl;
+      double temp1 = 0.5 * SGP4_J2 * temp;
+      double temp2 = temp1 * temp;
+      double mrt = rl * (1.0 - 1.5 * temp2 * betal * con41[i]) +
+                   0.5 * temp1 * x1mth2[i] * cos2u;
+      su = su - 0.25 * temp2 * x7thm1[i] * sin2u;
+      double xnode = nodem_[i] + 1.5 * temp2 * cosio[i] * sin2u;
+      double xinc = inclo[i] + 1.5 * temp2 * cosio[i] * sinio[i] * cos2u;
+      double mvt = rdotl - nm * temp1 * x1mth2[i] * sin2u / XKE;
+      double rvdot = rvdotl + nm * temp1 * (x1mth2[i] * cos2u + 1.5 * con41[i]) / XKE;
+      double sinsu = sin(su), cossu = cos(su);
+      double snod = sin(xnode), cnod = cos(xnode);
+      double sini = sin(xinc), cosi = cos(xinc);
+      double xmx = -snod * cosi;
+      double xmy = cnod * cosi;
+      double ux = xmx * sinsu + cnod * cossu;
+      double uy = xmy * sinsu + snod * cossu;
+      double uz = sini * sinsu;
+      double vx = xmx * cossu - cnod * sinsu;
+      double vy = xmy * cossu - snod * sinsu;
+      double vz = sini * cossu;
+      // Invalid elements, a negative semi-latus rectum or a decayed orbit
+      bool valid = valid_[i] > 0.0 && pl >= 0.0 && mrt >= 1.0;
+      double mask = valid ? 1.0 : nan;
+      out[6 * i] = mrt * ux * SGP4_RADIUS * mask;
+      out[6 * i + 1] = mrt * uy * SGP4_RADIUS * mask;
+      out[6 * i + 2] = mrt * uz * SGP4_RADIUS * mask;
+      out[6 * i + 3] = (mvt * ux + rvdot * vx) * vkmpersec * mask;
+      out[6 * i + 4] = (mvt * uy + rvdot * vy) * vkmpersec * mask;
+      out[6 * i + 5] = (mvt * uz + rvdot * vz) * vkmpersec * mask;
+    }
+  }
+};
+
+/*
+SGP4Catalog class methods
+*/
+
+// Direct constructor
+SGP4Catalog::SGP4Catalog(std::vector<TwoLineElement> &elements) {
+  this->threads = 0;
+  for (TwoLineElement &tle : elements) {
+    propagators.push_back(SGP4Propagator{tle});
+  }
+}
+
+// Propagate every element set over an interval
+std::vector<Ephemeris> SGP4Catalog::step(DateTime &start, DateTime &stop, double step) {
+  // Build the shared epoch grid
+  std::vector<DateTime> epochs;
+  DateTime t = start;
+  while (stop.difference(t) >= 0.0) {
+    epochs.push_back(t);
+    t = t.increment(step);
+  }
+  if (epochs.empty()) {
+    throw ArcException(
+        "SGP4Catalog::step exception: Stop time is before the start time");
+  }
+  // Split the catalog into packed near-earth and scalar deep space sets
+  NearEarthBlock near_earth;
+  std::vector<size_t> deep_space;
+  for (size_t i = 0; i < propagators.size(); i++) {
+    if (propagators[i].record.deep_space) {
+      deep_space.push_back(i);
+    } else {
+      near_earth.push_back(i, propagators[i]);
+    }
+  }
+  // Preallocate every state so workers only write their own epochs
+  std::vector<Ephemeris> ephemerides(propagators.size(),
+                                     Ephemeris{ EARTH, start });
+  for (Ephemeris &ephem : ephemerides) {
+    ephem.resize(epochs.size());
+    double *offsets = ephem.offsets();
+    for (size_t k = 0; k < epochs.size(); k++) {
+      offsets[k] = epochs[k].difference(start);
+    }
+  }
+  parallel_for(epochs.size(), threads, [&](size_t begin, size_t end) {
+    std::vector<double> packed(6 * near_earth.index.size());
+    std::vector<double> work(11 * near_earth.index.size());
+    for (size_t k = begin; k < end; k++) {
+      DateTime &epoch = epochs[k];
+      // TEME to ICRF rotation at this epoch
+      Rotation rotation = teme_to_icrf(epoch);
+      double (&rot)[3][3] = rotation.matrix.elements;
+      // Write a TEME state (km, km/s) into the output as ICRF (m, m/s)
+      auto store = [&](size_t obj, const double *teme) {
+        Ephemeris &ephem = ephemerides[obj];
+        for (int row = 0; row < 3; row++) {
+          ephem.component(row)[k] =
+            1000.0 * (rot[row][0] * teme[0] + rot[row][1] * teme[1] +
+                      rot[row][2] * teme[2]);
+          ephem.component(3 + row)[k] =
+            1000.0 * (rot[row][0] * teme[3] + rot[row][1] * teme[4] +
+                      rot[row][2] * teme[5]);
+        }
+      };
+      near_earth.propagate(epoch, work.data(), packed.data());
+      for (size_t i = 0; i < near_earth.index.size(); i++) {
+        store(near_earth.index[i], &packed[6 * i]);
+      }
+      for (size_t obj : deep_space) {
+        SGP4Propagator &prop = propagators[obj];
+        double teme[6];
+        double tsince = epoch.difference(prop.elements.epoch) / 60.0;
+        if (prop.propagate_teme(tsince, teme, teme + 3) != SGP4_OK) {
+          std::fill(teme, teme + 6, std::numeric_limits<double>::quiet_NaN());
+        }
+        store(obj, teme);
+      }
+    }
+  });
+  return ephemerides;
+}
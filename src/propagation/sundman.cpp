@@ -0,0 +1,105 @@
+#include <sundman.h>
+
+#include <math.h>
+
+// Semi-major axis of a state, or its radius if the orbit is unbound
+static double orbit_radius(ICRF &state) {
+  double r = state.position.mag();
+  double inv_a = 2.0 / r - state.velocity.dot(state.velocity) /
+                 state.central_body.mu();
+  return inv_a > 0.0 ? 1.0 / inv_a : r;
+}
+
+/*
+Sundman-transformed Runge-Kutta methods
+*/
+
+// Direct constructor (default settings)
+SundmanPropagator::SundmanPropagator(ICRF initial_state)
+  : RungeKutta4{ initial_state } {
+  this->sundman_power = 1.5;
+  this->reference_radius = orbit_radius(initial_state);
+}
+
+// Direct constructor (full settings)
+SundmanPropagator::SundmanPropagator(ICRF initial_state, double step_size,
+  ForceModel force_model)
+  : RungeKutta4{ initial_state, step_size, force_model } {
+  this->sundman_power = 1.5;
+  this->reference_radius = orbit_radius(initial_state);
+}
+
+// Calculate the derivatives of the state and time with respect to the
+// fictitious time
+Vector6 SundmanPropagator::regularized_derivatives(ICRF &state, Vector6 &k,
+  double tau, double &dt_ds) {
+  Vector6 pos_vel = Vector6{ state.position, state.velocity }.add(k);
+  std::array<Vector3, 2> vectors = pos_vel.split();
+  DateTime new_epoch = state.epoch.increment(tau);
+  ICRF sample_state{ state.central_body, new_epoch, vectors[0], vectors[1] };
+  dt_ds = pow(vectors[0].mag() / reference_radius, sundman_power);
+  Vector3 acceleration = force_model.acceleration(sample_state);
+  Vector6 final{ sample_state.velocity, acceleration };
+  return final.scale(dt_ds);
+}
+
+// Take one fixed step in the fictitious time
+ICRF SundmanPropagator::regularized_step(ICRF &state, double ds) {
+  // Time is integrated alongside the state
+  double t1, t2, t3, t4;
+  Vector6 k0{};
+  Vector6 k1 = regularized_derivatives(state, k0, 0.0, t1).scale(ds);
+  t1 *= ds;
+  Vector6 w_k1 = k1 / 2.0;
+  Vector6 k2 = regularized_derivatives(state, w_k1, t1 / 2.0, t2).scale(ds);
+  t2 *= ds;
+  Vector6 w_k2 = k2 / 2.0;
+  Vector6 k3 = regularized_derivatives(state, w_k2, t2 / 2.0, t3).scale(ds);
+  t3 *= ds;
+  Vector6 k4 = regularized_derivatives(state, k3, t3, t4).scale(ds);
+  t4 *= ds;
+  // Start combined vector and add weighted values
+  k2 = k2 * 2;
+  k3 = k3 * 2;
+  Vector6 total = k1 + k2;
+  total = total + k3;
+  total = total + k4;
+  total = total / 6;
+  double dt = (t1 + 2.0 * t2 + 2.0 * t3 + t4) / 6.0;
+  Vector6 pos_vel{ state.position, state.velocity };
+  std::array<Vector3, 2> final_vectors = (pos_vel + total).split();
+  DateTime new_epoch = state.epoch.increment(dt);
+  return ICRF{ state.central_body, new_epoch, final_vectors[0],
+               final_vectors[1] };
+}
+
+// Propagate the inital state to specified epoch
+ICRF SundmanPropagator::propagate(DateTime &epoch) {
+  cache_state = integrate(cache_state, epoch.difference(cache_state.epoch));
+  cache_state.epoch = epoch;
+  return cache_state;
+}
+
+// Step the integration a number of seconds forward/backward
+ICRF SundmanPropagator::integrate(ICRF &state, double step) {
+  ICRF current = state;
+  DateTime target = state.epoch.increment(step);
+  while (target.equals(current.epoch) != true) {
+    double remaining = target.difference(current.epoch);
+    // Physical length of a fictitious time step at the current radius
+    double physical = step_size *
+      pow(current.position.mag() / reference_radius, sundman_power);
+    if (fabs(remaining) > physical) {
+      ICRF next = regularized_step(current, copysign(step_size, remaining));
+      // Keep the step unless it passes the target epoch
+      if (target.difference(next.epoch) * remaining > 0.0) {
+        current = next;
+        continue;
+      }
+    }
+    // Finish with a physical-time step to land on the target epoch
+    current = RungeKutta4::integrate(current, remaining);
+    current.epoch = target;
+  }
+  return current;
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include <symplectic.h>
+
+#include <exceptions.h>
+#include <keplerian.h>
+
+#include <math.h>
+
+/*
+Yoshida composition weights (outermost stage first, the middle stage is one
+less twice their sum)
+*/
+
+// Fourth order (triple jump)
+static const double YOSHIDA_4[1] = { 1.0 / (2.0 - 1.2599210498948732) };
+
+// Sixth order (solution A)
+static const double YOSHIDA_6[3] = { 0.784513610477560, 0.235573213359357,
+                                     -1.17767998417887 };
+
+// Eighth order (solution D)
+static const double YOSHIDA_8[7] = { 0.914844246229740, 0.253693336566229,
+                                     -1.44485223686048, -0.158240635368243,
+                                     1.93813913762276, -1.96061023297549,
+                                     0.102799849391985 };
+
+/*
+Symplectic propagator methods
+*/
+
+// Direct constructor (default settings)
+SymplecticPropagator::SymplecticPropagator(ICRF initial_state)
+  : SymplecticPropagator{ initial_state, 60.0, ForceModel{ initial_state } } {}
+
+// Direct constructor (full settings)
+SymplecticPropagator::SymplecticPropagator(ICRF initial_state,
+  double step_size, ForceModel force_model)
+  : NumericalPropagator{ initial_state, step_size, force_model } {
+  if (!this->force_model.is_conservative()) {
+    throw ArcException(
+      "SymplecticPropagator::SymplecticPropagator exception: Force model must "
+      "be conservative (no drag or solar radiation pressure)");
+  }
+  set_method(Leapfrog, 2);
+}
+
+// Change the splitting and order of the method
+void SymplecticPropagator::set_method(SymplecticSplitting splitting,
+  int order) {
+  const double *outer;
+  int count;
+  if (order == 2) {
+    outer = nullptr;
+    count = 0;
+  }
+  else if (order == 4) {
+    outer = YOSHIDA_4;
+    count = 1;
+  }
+  else if (order == 6) {
+    outer = YOSHIDA_6;
+    count = 3;
+  }
+  else if (order == 8) {
+    outer = YOSHIDA_8;
+    count = 7;
+  }
+  else {
+    throw ArcException(
+      "SymplecticPropagator::set_method exception: Order must be 2, 4, 6, or "
+      "8");
+  }
+  this->splitting = splitting;
+  this->order = order;
+  // Symmetric sequence of stages around the middle weight
+  double sum = 0.0;
+  weights.clear();
+  for (int i = 0; i < count; i++) {
+    weights.push_back(outer[i]);
+    sum += outer[i];
+  }
+  weights.push_back(1.0 - 2.0 * sum);
+  for (int i = count - 1; i >= 0; i--) {
+    weights.push_back(outer[i]);
+  }
+}
+
+// Calculate the acceleration applied by a kick
+Vector3 SymplecticPropagator::kick_acceleration(ICRF &state) {
+  Vector3 accel = force_model.acceleration(state);
+  if (splitting == WisdomHolman) {
+    // The central-body point mass is integrated exactly by the drift
+    double r = state.position.mag();
+    Vector3 central = state.position.scale(state.central_body.mu() / (r * r * r));
+    accel = accel.add(central);
+  }
+  return accel;
+}
+
+// Drift a state a number of seconds without kicks
+void SymplecticPropagator::drift(ICRF &state, double dt) {
+  if (splitting == WisdomHolman) {
+    Vector3 r, v;
+    propagate_universal(state.central_body.mu(), state.position, state.velocity,
+                        dt, r, v);
+    state.position = r;
+    state.velocity = v;
+  }
+  else {
+    Vector3 dr = state.velocity.scale(dt);
+    state.position = state.position.add(dr);
+  }
+  state.epoch = state.epoch.increment(dt);
+}
+
+// Step the integration a number of seconds forward/backward
+ICRF SymplecticPropagator::integrate(ICRF &state, double step) {
+  ICRF current = state;
+  // Adjacent half kicks of consecutive stages are merged into one
+  double kick = 0.5 * weights[0];
+  for (size_t i = 0; i < weights.size(); i++) {
+    Vector3 dv = kick_acceleration(current).scale(kick * step);
+    current.velocity = current.velocity.add(dv);
+    drift(current, weights[i] * step);
+    double next = (i + 1 < weights.size()) ? weights[i + 1] : 0.0;
+    kick = 0.5 * (weights[i] + next);
+  }
+  Vector3 dv = kick_acceleration(current).scale(kick * step);
+  current.velocity = current.velocity.add(dv);
+  current.epoch = state.epoch.increment(step);
+  return current;
+}
\ No newline at end of file
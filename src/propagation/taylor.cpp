@@ -0,0 +1,178 @@
+#include <taylor.h>
+
+#include <exceptions.h>
+
+#include <algorithm>
+#include <math.h>
+
+/*
+Taylor series coefficient recurrences
+*/
+
+// Coefficient k of the product of two series
+static double product(std::vector<double> &f, std::vector<double> &g, int k) {
+  double sum = 0.0;
+  for (int j = 0; j <= k; j++) {
+    sum += f[j] * g[k - j];
+  }
+  return sum;
+}
+
+// Coefficient k of a series raised to a real power, given the lower
+// coefficients of the result (from f u' = alpha f' u)
+static double power(std::vector<double> &f, std::vector<double> &u,
+                    double alpha, int k) {
+  if (k == 0) {
+    return pow(f[0], alpha);
+  }
+  double sum = 0.0;
+  for (int j = 0; j < k; j++) {
+    sum += (alpha * (k - j) - j) * f[k - j] * u[j];
+  }
+  return sum / (k * f[0]);
+}
+
+/*
+Taylor propagator methods
+*/
+
+// Direct constructor (default settings)
+TaylorPropagator::TaylorPropagator(ICRF initial_state)
+  : TaylorPropagator{ initial_state, 86400.0, ForceModel{ initial_state } } {}
+
+// Direct constructor (full settings)
+TaylorPropagator::TaylorPropagator(ICRF initial_state, double step_size,
+  ForceModel force_model)
+  : NumericalPropagator{ initial_state, step_size, force_model } {
+  bool is_aspherical = false;
+  if (!this->force_model.central_gravity_only(initial_state, is_aspherical)) {
+    throw ArcException(
+      "TaylorPropagator::TaylorPropagator exception: Force model may only "
+      "contain central-body gravity");
+  }
+  CelestialBody body = initial_state.central_body;
+  this->mu = body.mu();
+  this->j2_coeff = 0.0;
+  if (is_aspherical) {
+    this->j2_coeff = 1.5 * body.mu() * body.j2() * body.radius_squared();
+  }
+  this->steps = 0;
+  set_tolerance(1e-15);
+}
+
+// Change the tolerance and select the matching series order
+void TaylorPropagator::set_tolerance(double tolerance) {
+  if (!(tolerance > 0.0)) {
+    throw ArcException(
+      "TaylorPropagator::set_tolerance exception: Tolerance must be positive");
+  }
+  this->tolerance = tolerance;
+  // Order at which the step that meets the tolerance is largest for an
+  // analytic solution (Jorba & Zou, 2005)
+  int p = (int)ceil(-0.5 * log(tolerance) + 1.0);
+  this->order = std::max(MIN_TAYLOR_ORDER, std::min(MAX_TAYLOR_ORDER, p));
+  for (std::vector<double> &s : series) {
+    s.assign(order + 1, 0.0);
+  }
+  r_2.assign(order + 1, 0.0);
+  r_m3.assign(order + 1, 0.0);
+  r_m5.assign(order + 1, 0.0);
+  r_m7.assign(order + 1, 0.0);
+  z_2.assign(order + 1, 0.0);
+  j2_term.assign(order + 1, 0.0);
+}
+
+// Generate the Taylor coefficients of the trajectory through a state
+void TaylorPropagator::expand(ICRF &state) {
+  std::vector<double> &x = series[0];
+  std::vector<double> &y = series[1];
+  std::vector<double> &z = series[2];
+  x[0] = state.position.x;
+  y[0] = state.position.y;
+  z[0] = state.position.z;
+  series[3][0] = state.velocity.x;
+  series[4][0] = state.velocity.y;
+  series[5][0] = state.velocity.z;
+  for (int k = 0; k < order; k++) {
+    // Coefficient k of every term of the acceleration
+    r_2[k] = product(x, x, k) + product(y, y, k) + product(z, z, k);
+    r_m3[k] = power(r_2, r_m3, -1.5, k);
+    double accel[3] = { -mu * product(x, r_m3, k), -mu * product(y, r_m3, k),
+                        -mu * product(z, r_m3, k) };
+    if (j2_coeff != 0.0) {
+      // a = K r / r^5 (5 z^2 / r^2 - 1), less 2 K z / r^5 along z
+      r_m5[k] = power(r_2, r_m5, -2.5, k);
+      r_m7[k] = power(r_2, r_m7, -3.5, k);
+      z_2[k] = product(z, z, k);
+      j2_term[k] = 5.0 * product(z_2, r_m7, k) - r_m5[k];
+      accel[0] += j2_coeff * product(x, j2_term, k);
+      accel[1] += j2_coeff * product(y, j2_term, k);
+      accel[2] += j2_coeff * (product(z, j2_term, k) - 2.0 * product(z, r_m5, k));
+    }
+    // Integrate each component once
+    for (int i = 0; i < 3; i++) {
+      series[i][k + 1] = series[i + 3][k] / (k + 1);
+      series[i + 3][k + 1] = accel[i] / (k + 1);
+    }
+  }
+}
+
+// Choose the step size from the last coefficients of the current expansion
+double TaylorPropagator::series_step(ICRF &state) {
+  // Position and velocity errors are relative to their own magnitudes
+  double scales[2] = { state.position.mag(), state.velocity.mag() };
+  double h = HUGE_VAL;
+  for (int j = order - 1; j <= order; j++) {
+    for (int block = 0; block < 2; block++) {
+      double norm = 0.0;
+      for (int i = 3 * block; i < 3 * block + 3; i++) {
+        norm = std::max(norm, fabs(series[i][j]));
+      }
+      norm /= scales[block];
+      if (norm > 0.0) {
+        h = std::min(h, pow(tolerance / norm, 1.0 / j));
+      }
+    }
+  }
+  // Safety factor for the terms beyond the truncation
+  return std::min(step_size, h * exp(-0.7 / (order - 1)));
+}
+
+// Evaluate the current expansion a number of seconds from its epoch
+ICRF TaylorPropagator::evaluate(ICRF &state, double h) {
+  double values[6];
+  for (int i = 0; i < 6; i++) {
+    // Horner's rule from the highest order
+    double sum = series[i][order];
+    for (int k = order - 1; k >= 0; k--) {
+      sum = sum * h + series[i][k];
+    }
+    values[i] = sum;
+  }
+  Vector3 position{ values[0], values[1], values[2] };
+  Vector3 velocity{ values[3], values[4], values[5] };
+  DateTime new_epoch = state.epoch.increment(h);
+  return ICRF{ state.central_body, new_epoch, position, velocity };
+}
+
+// Step the integration a number of seconds forward/backward
+ICRF TaylorPropagator::integrate(ICRF &state, double step) {
+  ICRF current = state;
+  double remaining = step;
+  while (remaining != 0.0) {
+    expand(current);
+    double h = series_step(current);
+    if (h >= fabs(remaining)) {
+      h = remaining;
+    }
+    else {
+      h = copysign(h, remaining);
+    }
+    current = evaluate(current, h);
+    remaining = (h == remaining) ? 0.0 : remaining - h;
+    steps += 1;
+  }
+  // Sub-steps are summed from the start to avoid accumulating epoch rounding
+  current.epoch = state.epoch.increment(step);
+  return current;
+}
\ No newline at end of file
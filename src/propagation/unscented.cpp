@@ -0,0 +1,138 @@
+#include <unscented.h>
+#include <exceptions.h>
+#include <parallel.h>
+#include <rungekutta4.h>
+
+#include <math.h>
+#include <sstream>
+
+/*
+Unscented propagator methods
+*/
+
+// Number of dimensions of the propagated state
+static const int STATE_DIM = 6;
+
+// Direct constructor
+UnscentedPropagator::UnscentedPropagator(ICRF initial_state,
+                                         Matrix6 initial_covariance,
+                                         double step_size,
+                                         ForceModel force_model) {
+  this->initial_state = initial_state;
+  this->initial_covariance = initial_covariance;
+  this->step_size = step_size;
+  this->force_model = force_model;
+  this->alpha = 1.0;
+  this->beta = 2.0;
+  this->kappa = 0.0;
+  this->threads = 0;
+}
+
+// Generate the sigma points of the initial state and covariance
+std::vector<ICRF> UnscentedPropagator::sigma_points() {
+  double lambda = alpha * alpha * (STATE_DIM + kappa) - STATE_DIM;
+  if (STATE_DIM + lambda <= 0.0) {
+    std::stringstream msg;
+    msg << "UnscentedPropagator::sigma_points exception: Invalid scaling "
+           "parameters (alpha "
+        << alpha << ", kappa " << kappa << ")";
+    throw ArcException(msg.str());
+  }
+  // Matrix square root of the scaled covariance
+  Matrix6 scaled = initial_covariance.scale(STATE_DIM + lambda);
+  Matrix6 root = scaled.cholesky();
+  std::vector<ICRF> points{initial_state};
+  // Offset the mean along each column of the square root, in both directions
+  for (double sign : {1.0, -1.0}) {
+    for (int col = 0; col < STATE_DIM; col++) {
+      Vector3 d_pos{root.elements[0][col], root.elements[1][col],
+                    root.elements[2][col]};
+      Vector3 d_vel{root.elements[3][col], root.elements[4][col],
+                    root.elements[5][col]};
+      d_pos = d_pos.scale(sign);
+      d_vel = d_vel.scale(sign);
+      Vector3 pos = initial_state.position + d_pos;
+      Vector3 vel = initial_state.velocity + d_vel;
+      points.push_back(
+          ICRF{initial_state.central_body, initial_state.epoch, pos, vel});
+    }
+  }
+  return points;
+}
+
+// Calculate the weights used to recover the mean and covariance
+void UnscentedPropagator::weights(std::vector<double> &mean_weights,
+                                  std::vector<double> &cov_weights) {
+  double lambda = alpha * alpha * (STATE_DIM + kappa) - STATE_DIM;
+  double w_i = 1.0 / (2.0 * (STATE_DIM + lambda));
+  mean_weights.assign(2 * STATE_DIM + 1, w_i);
+  cov_weights.assign(2 * STATE_DIM + 1, w_i);
+  mean_weights[0] = lambda / (STATE_DIM + lambda);
+  cov_weights[0] = mean_weights[0] + (1.0 - alpha * alpha + beta);
+}
+
+// Create an Ephemeris and covariance ephemeris by propagating over an interval
+Ephemeris UnscentedPropagator::step(DateTime &start, DateTime &stop,
+                                    double step,
+                                    CovarianceEphemeris &covariance) {
+  // Output epochs
+  std::vector<DateTime> epochs;
+  DateTime t = start;
+  while (stop.difference(t) >= 0.0) {
+    epochs.push_back(t);
+    t = t.increment(step);
+  }
+  std::vector<ICRF> points = sigma_points();
+  size_t n_points = points.size();
+  // Propagated sigma points indexed by [epoch][point], each worker only
+  // writes the points of its own batch
+  std::vector<std::vector<ICRF>> propagated(epochs.size(),
+                                            std::vector<ICRF>(n_points));
+  parallel_for(n_points, threads, [&](size_t begin, size_t end) {
+    // Each worker owns its propagator (and force model lookup cache)
+    RungeKutta4 propagator{initial_state, step_size, force_model};
+    std::vector<ICRF> batch(points.begin() + begin, points.begin() + end);
+    for (size_t e = 0; e < epochs.size(); e++) {
+      propagator.propagate_batch(batch, epochs[e]);
+      for (size_t p = begin; p < end; p++) {
+        propagated[e][p] = batch[p - begin];
+      }
+    }
+  });
+  // Recover the covariance at each epoch from the propagated points
+  std::vector<double> mean_weights, cov_weights;
+  weights(mean_weights, cov_weights);
+  Ephemeris ephem{};
+  ephem.reserve(epochs.size());
+  std::vector<Matrix6> covariances;
+  for (size_t e = 0; e < epochs.size(); e++) {
+    double mean[STATE_DIM] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (size_t p = 0; p < n_points; p++) {
+      ICRF &point = propagated[e][p];
+      double x[STATE_DIM] = {point.position.x, point.position.y,
+                             point.position.z, point.velocity.x,
+                             point.velocity.y, point.velocity.z};
+      for (int i = 0; i < STATE_DIM; i++) {
+        mean[i] += mean_weights[p] * x[i];
+      }
+    }
+    Matrix6 cov;
+    for (size_t p = 0; p < n_points; p++) {
+      ICRF &point = propagated[e][p];
+      double d[STATE_DIM] = {
+          point.position.x - mean[0], point.position.y - mean[1],
+          point.position.z - mean[2], point.velocity.x - mean[3],
+          point.velocity.y - mean[4], point.velocity.z - mean[5]};
+      for (int i = 0; i < STATE_DIM; i++) {
+        for (int j = 0; j < STATE_DIM; j++) {
+          cov.elements[i][j] += cov_weights[p] * d[i] * d[j];
+        }
+      }
+    }
+    // The central sigma point is the trajectory of the mean initial state
+    ephem.push_back(propagated[e][0]);
+    covariances.push_back(cov);
+  }
+  covariance = CovarianceEphemeris{epochs, covariances, initial_state.central_body};
+  return ephem;
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include <civil_time.h>
+
+#include <math.h>
+
+// Abbreviated month names
+static const char MONTH_ABBREVIATIONS[12][4] = {
+  "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+  "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+// Powers of ten up to the largest exactly representable fraction numerator
+static const double POWERS_OF_TEN[16] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+  1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+// Number of days in a month of a year
+static int days_in_month(int64_t year, int month) {
+  static const int DAYS[12] = { 31, 28, 31, 30, 31, 30,
+                                31, 31, 30, 31, 30, 31 };
+  if (month == 2 &&
+      (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0))) {
+    return 29;
+  }
+  return DAYS[month - 1];
+}
+
+// Lowercase an ASCII letter
+static char lower(char c) {
+  return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+// Parse a fixed number of digits, advancing the position
+static bool parse_digits(const char str[], size_t length, size_t &pos,
+                         int count, int &value) {
+  if (pos + count > length) {
+    return false;
+  }
+  value = 0;
+  for (int i = 0; i < count; i++) {
+    char c = str[pos + i];
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + (c - '0');
+  }
+  pos += count;
+  return true;
+}
+
+// Parse one expected character, advancing the position
+static bool parse_char(const char str[], size_t length, size_t &pos, char c) {
+  if (pos >= length || str[pos] != c) {
+    return false;
+  }
+  pos += 1;
+  return true;
+}
+
+// Parse a month name (abbreviated or full, in any case)
+static bool parse_month(const char str[], size_t length, size_t &pos,
+                        int &month) {
+  if (pos + 3 > length) {
+    return false;
+  }
+  month = 0;
+  for (int m = 0; m < 12; m++) {
+    if (lower(str[pos]) == lower(MONTH_ABBREVIATIONS[m][0]) &&
+        lower(str[pos + 1]) == MONTH_ABBREVIATIONS[m][1] &&
+        lower(str[pos + 2]) == MONTH_ABBREVIATIONS[m][2]) {
+      month = m + 1;
+      break;
+    }
+  }
+  if (month == 0) {
+    return false;
+  }
+  // Skip the rest of a full month name
+  pos += 3;
+  while (pos < length && lower(str[pos]) >= 'a' && lower(str[pos]) <= 'z') {
+    pos += 1;
+  }
+  return true;
+}
+
+// Write a non-negative integer with at least a number of digits
+static size_t write_digits(char buffer[], int64_t value, int count) {
+  char digits[20];
+  int n = 0;
+  do {
+    digits[n++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  while (n < count) {
+    digits[n++] = '0';
+  }
+  for (int i = 0; i < n; i++) {
+    buffer[i] = digits[n - 1 - i];
+  }
+  return (size_t)n;
+}
+
+// Write a year with at least four digits
+static size_t write_year(char buffer[], int64_t year) {
+  if (year < 0) {
+    buffer[0] = '-';
+    return 1 + write_digits(buffer + 1, -year, 4);
+  }
+  return write_digits(buffer, year, 4);
+}
+
+// Get the strftime format equivalent to a calendar date format
+const char* civil_strftime(CivilFormat format) {
+  switch (format) {
+    case ISO_8601:
+      return "%Y-%m-%dT%H:%M:%S";
+    case STK_DATE:
+      return "%d %b %Y %H:%M:%S";
+    default:
+      return "";
+  }
+}
+
+// Calculate the number of days from 1 Jan 1970 to a date
+int64_t days_from_civil(int64_t year, int month, int day) {
+  // Years start in March so the leap day is the last day of the year
+  year -= (month <= 2) ? 1 : 0;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t year_of_era = year - era * 400;
+  int64_t day_of_year =
+    (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  int64_t day_of_era = year_of_era * 365 + year_of_era / 4 -
+                       year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+// Calculate the date a number of days from 1 Jan 1970
+void civil_from_days(int64_t days, int64_t &year, int &month, int &day) {
+  days += 719468;
+  int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t day_of_era = days - era * 146097;
+  int64_t year_of_era = (day_of_era - day_of_era / 1460 +
+                         day_of_era / 36524 - day_of_era / 146096) / 365;
+  int64_t day_of_year =
+    day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  int64_t month_index = (5 * day_of_year + 2) / 153;
+  day = (int)(day_of_year - (153 * month_index + 2) / 5 + 1);
+  month = (int)(month_index < 10 ? month_index + 3 : month_index - 9);
+  year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+// Parse a calendar date
+bool parse_civil(const char str[], size_t length, CivilFormat format,
+                 int64_t &unix_seconds, double &fraction) {
+  size_t pos = 0;
+  int year, month, day, hour, minute, second;
+  if (format == ISO_8601) {
+    if (!parse_digits(str, length, pos, 4, year) ||
+        !parse_char(str, length, pos, '-') ||
+        !parse_digits(str, length, pos, 2, month) ||
+        !parse_char(str, length, pos, '-') ||
+        !parse_digits(str, length, pos, 2, day)) {
+      return false;
+    }
+    if (!parse_char(str, length, pos, 'T') &&
+        !parse_char(str, length, pos, ' ')) {
+      return false;
+    }
+  }
+  else if (format == STK_DATE) {
+    // The day of the month may have one or two digits
+    if (!parse_digits(str, length, pos, 2, day) &&
+        !parse_digits(str, length, pos, 1, day)) {
+      return false;
+    }
+    if (!parse_char(str, length, pos, ' ') ||
+        !parse_month(str, length, pos, month) ||
+        !parse_char(str, length, pos, ' ') ||
+        !parse_digits(str, length, pos, 4, year) ||
+        !parse_char(str, length, pos, ' ')) {
+      return false;
+    }
+  }
+  else {
+    return false;
+  }
+  if (!parse_digits(str, length, pos, 2, hour) ||
+      !parse_char(str, length, pos, ':') ||
+      !parse_digits(str, length, pos, 2, minute) ||
+      !parse_char(str, length, pos, ':') ||
+      !parse_digits(str, length, pos, 2, second)) {
+    return false;
+  }
+  // A leap second (60) runs into the next minute, as in mktime
+  if (month < 1 || month > 12 || day < 1 ||
+      day > days_in_month(year, month) || hour > 23 || minute > 59 ||
+      second > 60) {
+    return false;
+  }
+  // Fractional seconds beyond the precision of a double are ignored
+  fraction = 0.0;
+  if (parse_char(str, length, pos, '.')) {
+    int64_t numerator = 0;
+    int digits = 0;
+    while (pos < length && str[pos] >= '0' && str[pos] <= '9') {
+      if (digits < 15) {
+        numerator = numerator * 10 + (str[pos] - '0');
+        digits += 1;
+      }
+      pos += 1;
+    }
+    fraction = (double)numerator / POWERS_OF_TEN[digits];
+  }
+  if (format == ISO_8601) {
+    parse_char(str, length, pos, 'Z');
+  }
+  while (pos < length && (str[pos] == ' ' || str[pos] == '\t' ||
+                          str[pos] == '\r' || str[pos] == '\n')) {
+    pos += 1;
+  }
+  if (pos != length) {
+    return false;
+  }
+  unix_seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 +
+                 minute * 60 + second;
+  return true;
+}
+
+// Format a calendar date
+size_t format_civil(int64_t unix_seconds, double fraction, CivilFormat format,
+                    char buffer[]) {
+  // Round the fraction first so that a carry reaches the date
+  int64_t scale = (int64_t)POWERS_OF_TEN[CIVIL_FRACTION_DIGITS];
+  int64_t numerator = (int64_t)floor(fraction * scale + 0.5);
+  if (numerator >= scale) {
+    unix_seconds += numerator / scale;
+    numerator %= scale;
+  }
+  int64_t days = unix_seconds / 86400;
+  int64_t seconds_of_day = unix_seconds % 86400;
+  if (seconds_of_day < 0) {
+    days -= 1;
+    seconds_of_day += 86400;
+  }
+  int64_t year;
+  int month, day;
+  civil_from_days(days, year, month, day);
+  size_t n = 0;
+  if (format == STK_DATE) {
+    n += write_digits(buffer + n, day, 2);
+    buffer[n++] = ' ';
+    for (int i = 0; i < 3; i++) {
+      buffer[n++] = MONTH_ABBREVIATIONS[month - 1][i];
+    }
+    buffer[n++] = ' ';
+    n += write_year(buffer + n, year);
+    buffer[n++] = ' ';
+  }
+  else {
+    n += write_year(buffer + n, year);
+    buffer[n++] = '-';
+    n += write_digits(buffer + n, month, 2);
+    buffer[n++] = '-';
+    n += write_digits(buffer + n, day, 2);
+    buffer[n++] = 'T';
+  }
+  n += write_digits(buffer + n, seconds_of_day / 3600, 2);
+  buffer[n++] = ':';
+  n += write_digits(buffer + n, (seconds_of_day / 60) % 60, 2);
+  buffer[n++] = ':';
+  n += write_digits(buffer + n, seconds_of_day % 60, 2);
+  buffer[n++] = '.';
+  n += write_digits(buffer + n, numerator, CIVIL_FRACTION_DIGITS);
+  buffer[n] = '\0';
+  return n;
+}
\ No newline at end of file
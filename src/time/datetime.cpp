@@ -1,8 +1,10 @@
 #include <bsd_strptime.h>
-#include <data_files.h>
 #include <datetime.h>
+#include <exceptions.h>
 #include <math_utils.h>
+#include <time_scales.h>
 
+#include <cstdio>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -11,6 +13,11 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+// GMST polynomial in UT1 Julian centuries (seconds)
+static constexpr double GMST_POLY[] = {
+  67310.54841, 876600.0 * 3600.0 + 8640184.812866, 0.093104, 6.2e-6
+};
+
 /* Time scale methods */
 
 // Return string representation of a TimeScale
@@ -37,24 +44,44 @@ Date and Time methods
 
 // Default constructor
 DateTime::DateTime() {
-  this->seconds_since_j2000 = 0.0;
+  this->whole_seconds = 0;
+  this->fraction = 0.0;
   this->scale = UTC;
 }
 
 // Constructor using double and TimeScale
 DateTime::DateTime(double seconds, TimeScale scale) {
-  this->seconds_since_j2000 = seconds;
+  double whole = floor(seconds);
+  this->whole_seconds = (int64_t)whole;
+  this->fraction = seconds - whole;
+  this->scale = scale;
+}
+
+// Constructor using whole and fractional seconds
+DateTime::DateTime(int64_t whole_seconds, double fraction, TimeScale scale) {
+  double carry = floor(fraction);
+  this->whole_seconds = whole_seconds + (int64_t)carry;
+  this->fraction = fraction - carry;
   this->scale = scale;
 }
 
 // Constructor using input string and format
 DateTime::DateTime(std::string datestr, std::string format, TimeScale scale) {
-  // Determine timezone and get offset
-  time_t t = time(NULL);
-  struct tm lt = {0};
-  double offset = t - mktime(gmtime(&t));
+  // Use the dedicated parser for the formats it handles
+  if (format == civil_strftime(ISO_8601)) {
+    *this = DateTime{ datestr.c_str(), datestr.size(), ISO_8601, scale };
+    return;
+  }
+  if (format == civil_strftime(STK_DATE)) {
+    *this = DateTime{ datestr.c_str(), datestr.size(), STK_DATE, scale };
+    return;
+  }
   // Strip the date elements using NetBSD's strptime function
-  bsd_strptime(datestr.c_str(), format.c_str(), &lt);
+  struct tm lt = {0};
+  if (bsd_strptime(datestr.c_str(), format.c_str(), &lt) == NULL) {
+    throw ArcException("DateTime::DateTime exception: Unable to parse \"" +
+                       datestr + "\" with format \"" + format + "\"");
+  }
   // Parse any milliseconds from the end of the date string
   double dbl_millisecs;
   size_t dec_point = datestr.find(".");
@@ -65,25 +92,50 @@ DateTime::DateTime(std::string datestr, std::string format, TimeScale scale) {
     // If the parsing fails, assume no milliseconds were found
     dbl_millisecs = 0.0;
   }
+  // The date elements are UTC, so count the days directly rather than through
+  // the local timezone
+  int64_t unix_seconds =
+    days_from_civil(lt.tm_year + 1900, lt.tm_mon + 1, lt.tm_mday) * 86400 +
+    lt.tm_hour * 3600 + lt.tm_min * 60 + lt.tm_sec;
+  *this = DateTime{ unix_seconds - UNIX_J2000_WHOLE,
+                    dbl_millisecs - UNIX_J2000_FRACTION, scale };
+}
 
-  // Take the unix timestamp given by mktime, add the local GMT offset and any
-  // milliseconds, then offset by the unix timestamp of J2000
-  this->seconds_since_j2000 = mktime(&lt) + offset - UNIX_J2000 + dbl_millisecs;
-  this->scale = scale;
+// Constructor using characters in a calendar date format
+DateTime::DateTime(const char datestr[], size_t length, CivilFormat format,
+                   TimeScale scale) {
+  int64_t unix_seconds;
+  double unix_fraction;
+  if (!parse_civil(datestr, length, format, unix_seconds, unix_fraction)) {
+    throw ArcException("DateTime::DateTime exception: Unable to parse \"" +
+                       std::string{ datestr, length } + "\" as " +
+                       (format == STK_DATE ? "an STK" : "an ISO 8601") +
+                       " date");
+  }
+  // Offset the unix timestamp by the unix timestamp of J2000
+  *this = DateTime{ unix_seconds - UNIX_J2000_WHOLE,
+                    unix_fraction - UNIX_J2000_FRACTION, scale };
 }
 
 // Constructor using input string in ISO 8601 format
 DateTime::DateTime(std::string datestr, TimeScale scale)
-    : DateTime{datestr, "%Y-%m-%dT%H:%M:%S", scale} {}
+    : DateTime{ datestr.c_str(), datestr.size(), ISO_8601, scale } {}
+
+// Get the number of seconds since J2000 as a single double
+double DateTime::seconds_since_j2000() { return whole_seconds + fraction; }
 
 // Convert to `struct tm' representation of *TIMER in UTC
 tm* DateTime::to_tm() {
-  time_t t = (long)(seconds_since_j2000 + UNIX_J2000);
+  double unix_fraction = fraction + UNIX_J2000_FRACTION;
+  time_t t = (time_t)(whole_seconds + UNIX_J2000_WHOLE) +
+             (time_t)floor(unix_fraction);
   return gmtime(&t);
 }
 
 // Get Unix timestamp of instance
-double DateTime::unix_timestamp() { return seconds_since_j2000 + UNIX_J2000; }
+double DateTime::unix_timestamp() {
+  return (whole_seconds + UNIX_J2000_WHOLE) + (fraction + UNIX_J2000_FRACTION);
+}
 
 // Convert to a Julian Date
 // Uses Unix time definition of Julian Day
@@ -103,56 +155,68 @@ double DateTime::mjd_gsfc() { return mjd() - 29999.5; }
 
 // Convert to equivalent time in the UT1 time scale
 DateTime DateTime::ut1() {
-  double d_ut1 = DATA_FILES.get_finals(mjd())[3];
-  return DateTime{seconds_since_j2000 + d_ut1, UT1};
+  return TIME_SCALES.convert(*this, UT1);
 }
 
 // Convert to equivalent time in the International Atomic Time (TAI) scale
 DateTime DateTime::tai() {
-  double leap = DATA_FILES.get_leap_seconds(seconds_since_j2000);
-  return DateTime{seconds_since_j2000 + leap, TAI};
+  return TIME_SCALES.convert(*this, TAI);
 }
 
 // Convert to equivalent time in the Terrestrial Time (TT) scale
 DateTime DateTime::tt() {
-  DateTime dt_tai = tai();
-  return {dt_tai.seconds_since_j2000 + 32.184, TT};
+  return TIME_SCALES.convert(*this, TT);
 }
 
 // Convert to equivalent time in the Barycentric Dynamical Time (TDB) scale
 DateTime DateTime::tdb() {
-  // Get this in Terrestrial Time
-  DateTime dt_tt = tt();
-  // Convert TT of this to Julian Centuries
-  double jc = dt_tt.julian_centuries();
-  // Calculate offset from unix time
-  double m_earth = (357.5277233 + 35999.05034 * jc) * (M_PI / 180);
-  double secs = 0.001658 * sin(m_earth) + 0.00001385 * sin(2 * m_earth);
-  return DateTime{dt_tt.seconds_since_j2000 + secs, TDB};
+  return TIME_SCALES.convert(*this, TDB);
 }
 
 // Calculate the Greenwich Mean Sideral Time (GMST) angle
 double DateTime::gmst_angle() {
   double t = ut1().julian_centuries();
-  double seconds = eval_poly(
-      t, std::vector<double>{67310.54841, 876600.0 * 3600.0 + 8640184.812866,
-                             0.093104, 6.2e-6});
+  double seconds = eval_poly(t, GMST_POLY);
   return (fmod(seconds, 86400) / 86400) * 2 * M_PI;
 }
 
+// Calculate the Earth Rotation Angle (ERA)
+double DateTime::era_angle() {
+  DateTime ut1_epoch = ut1();
+  // Split the UT1 days since 1 Jan 2000 12:00:00 into whole days and a
+  // fraction, so the whole turns drop out before any rounding
+  int64_t seconds = ut1_epoch.whole_seconds + UNIX_J2000_WHOLE - 946728000;
+  int64_t days = seconds / 86400 - (seconds % 86400 < 0 ? 1 : 0);
+  double day_fraction = ((seconds - days * 86400) +
+                         (ut1_epoch.fraction + UNIX_J2000_FRACTION)) / 86400.0;
+  double turns = 0.7790572732640 + 0.00273781191135448 * (days + day_fraction) +
+                 day_fraction;
+  double angle = fmod(turns, 1.0) * 2.0 * M_PI;
+  return angle < 0.0 ? angle + 2.0 * M_PI : angle;
+}
+
 // Increment time by a desired number of seconds
 DateTime DateTime::increment(double seconds) {
-  return DateTime{seconds_since_j2000 + seconds, scale};
+  // Both subtractions are exact, leaving one rounding in the fraction sum
+  double whole = floor(seconds);
+  double sum = fraction + (seconds - whole);
+  double carry = floor(sum);
+  DateTime incremented;
+  incremented.whole_seconds = whole_seconds + (int64_t)(whole + carry);
+  incremented.fraction = sum - carry;
+  incremented.scale = scale;
+  return incremented;
 }
 
 // Calculate the difference between this instance and another DateTime
 double DateTime::difference(DateTime& other) {
-  return seconds_since_j2000 - other.seconds_since_j2000;
+  return (double)(whole_seconds - other.whole_seconds) +
+         (fraction - other.fraction);
 }
 
 // Evaluates to true if DateTime is equal to another
 bool DateTime::equals(DateTime& other) {
-  return seconds_since_j2000 == other.seconds_since_j2000;
+  return whole_seconds == other.whole_seconds && fraction == other.fraction;
 }
 
 // Format date using strftime parameters
@@ -165,17 +229,36 @@ std::string DateTime::format(const char fmt[]) {
 
 // Format date usding strftime paramaters, appending fractional seconds
 std::string DateTime::format_fractional(const char fmt[]) {
-  std::string formatted = format(fmt);
-  double timestamp = unix_timestamp();
-  double intpart = 1.0;
-  std::string fractional = std::to_string(modf(timestamp, &intpart));
-  fractional = fractional.substr(fractional.find("."), fractional.size());
-  return formatted + fractional;
+  // Use the dedicated formatter for the formats it handles
+  std::string format_str{ fmt };
+  if (format_str == civil_strftime(ISO_8601)) {
+    char buffer[CIVIL_BUFFER_SIZE];
+    return std::string{ buffer, write_civil(ISO_8601, buffer) };
+  }
+  if (format_str == civil_strftime(STK_DATE)) {
+    char buffer[CIVIL_BUFFER_SIZE];
+    return std::string{ buffer, write_civil(STK_DATE, buffer) };
+  }
+  // Round the fraction before formatting so a carry reaches the seconds
+  double unix_fraction = fraction + UNIX_J2000_FRACTION;
+  int64_t micros = (int64_t)floor(unix_fraction * 1e6 + 0.5);
+  time_t t = (time_t)(whole_seconds + UNIX_J2000_WHOLE + micros / 1000000);
+  char buffer[256];
+  size_t n = strftime(buffer, sizeof(buffer), fmt, gmtime(&t));
+  snprintf(buffer + n, sizeof(buffer) - n, ".%06d", (int)(micros % 1000000));
+  return std::string{ buffer };
+}
+
+// Write date in a calendar date format with fractional seconds
+size_t DateTime::write_civil(CivilFormat format, char buffer[]) {
+  return format_civil(whole_seconds + UNIX_J2000_WHOLE,
+                      fraction + UNIX_J2000_FRACTION, format, buffer);
 }
 
 // Format date as ISO 8601
 std::string DateTime::to_iso() {
-  return format_fractional("%Y-%m-%dT%H:%M:%S");
+  char buffer[CIVIL_BUFFER_SIZE];
+  return std::string{ buffer, write_civil(ISO_8601, buffer) };
 }
 
 /*
@@ -184,7 +267,7 @@ DateTime operator functions
 
 // I/O stream
 std::ostream& operator<<(std::ostream& out, DateTime& dt) {
-  out << "[DateTime] { Seconds since J2000: " << dt.seconds_since_j2000
+  out << "[DateTime] { Seconds since J2000: " << dt.seconds_since_j2000()
       << ", ISO: " << dt.to_iso() << " " << time_scale_str(dt.scale) << " }";
   return out;
 }
\ No newline at end of file
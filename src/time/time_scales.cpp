@@ -0,0 +1,233 @@
+#include <data_files.h>
+#include <exceptions.h>
+#include <time_scales.h>
+
+#include <algorithm>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+// Shared converter instance
+TimeScaleConverter TIME_SCALES{};
+
+// Calculate TDB - TT in seconds at a TT epoch (seconds since J2000)
+static double tdb_tt_offset(double tt_seconds) {
+  // Julian centuries of TT using the Unix time definition of Julian Day
+  double jc = ((tt_seconds + UNIX_J2000) / 86400.0 + 2440587.5 - 2451545.0) /
+              36525.0;
+  double m_earth = (357.5277233 + 35999.05034 * jc) * (M_PI / 180);
+  // sin(2M) from sin(M) and cos(M), which are evaluated together
+  double sin_m = sin(m_earth);
+  double cos_m = cos(m_earth);
+  return sin_m * (0.001658 + 2.0 * 0.00001385 * cos_m);
+}
+
+/*
+Offset table methods
+*/
+
+// Default constructor
+OffsetTable::OffsetTable() : hot{ 0 } {
+  this->segments = std::vector<OffsetSegment>{};
+}
+
+// Add a segment after all existing segments
+void OffsetTable::push_back(OffsetSegment segment) {
+  segments.push_back(segment);
+}
+
+// Remove all segments
+void OffsetTable::clear() {
+  segments.clear();
+  hot.store(0, std::memory_order_relaxed);
+}
+
+// Get the number of segments
+size_t OffsetTable::size() { return segments.size(); }
+
+// Get the offset at an epoch
+double OffsetTable::offset(double seconds) {
+  size_t n = segments.size();
+  if (n == 0 || seconds < segments[0].start) {
+    return 0.0;
+  }
+  // Test the cached segment and the one after it before searching
+  size_t i = hot.load(std::memory_order_relaxed);
+  if (i < n && segments[i].start <= seconds &&
+      (i + 1 == n || seconds < segments[i + 1].start)) {
+    // Cached segment
+  }
+  else if (i + 1 < n && segments[i + 1].start <= seconds &&
+           (i + 2 == n || seconds < segments[i + 2].start)) {
+    i = i + 1;
+    hot.store(i, std::memory_order_relaxed);
+  }
+  else {
+    // Last segment starting at or before the epoch
+    auto it = std::upper_bound(
+      segments.begin(), segments.end(), seconds,
+      [](double t, const OffsetSegment &s) { return t < s.start; });
+    i = (size_t)(it - segments.begin()) - 1;
+    hot.store(i, std::memory_order_relaxed);
+  }
+  OffsetSegment &s = segments[i];
+  return s.offset + s.rate * (seconds - s.start);
+}
+
+/*
+Time-scale converter methods
+*/
+
+// Default constructor
+TimeScaleConverter::TimeScaleConverter() : tables_ready{ false } {}
+
+// Build the TAI-UTC tables from the leap seconds
+void TimeScaleConverter::build_leap_second_tables() {
+  tai_utc.clear();
+  tai_utc_by_tai.clear();
+  for (std::array<double, 2> &leap : DATA_FILES.leap_seconds) {
+    tai_utc.push_back(OffsetSegment{ leap[0], leap[1], 0.0 });
+    tai_utc_by_tai.push_back(
+      OffsetSegment{ leap[0] + leap[1], leap[1], 0.0 });
+  }
+}
+
+// Build the UT1-UTC table from the Earth orientation parameters
+void TimeScaleConverter::build_ut1_table() {
+  ut1_utc.clear();
+  // UT1-UTC is interpolated linearly between daily values (modified Julian
+  // date, UT1-UTC in the fourth column)
+  std::vector<std::array<double, 7>> &finals = DATA_FILES.finals_data;
+  for (size_t i = 0; i < finals.size(); i++) {
+    double start = (finals[i][0] - 40587.0) * 86400.0 - UNIX_J2000;
+    double rate = 0.0;
+    if (i + 1 < finals.size()) {
+      double end = (finals[i + 1][0] - 40587.0) * 86400.0 - UNIX_J2000;
+      // Remove the jump of a leap second between the two values
+      double change = finals[i + 1][3] - finals[i][3];
+      change -= round(change);
+      rate = change / (end - start);
+    }
+    ut1_utc.push_back(OffsetSegment{ start, finals[i][3], rate });
+  }
+}
+
+// Build the offset tables from the data files
+void TimeScaleConverter::build_tables() {
+  build_leap_second_tables();
+  build_ut1_table();
+  tables_ready.store(true, std::memory_order_release);
+}
+
+// Replace the built-in leap seconds with those of a leap seconds file
+void TimeScaleConverter::load_leap_seconds(const char filename[]) {
+  DATA_FILES.load_leap_seconds(filename);
+  if (tables_ready.load(std::memory_order_acquire)) {
+    build_leap_second_tables();
+  }
+}
+
+// Load the Earth orientation parameters of an IERS finals.all file
+void TimeScaleConverter::load_earth_orientation(const char filename[]) {
+  DATA_FILES.load_finals(filename);
+  if (tables_ready.load(std::memory_order_acquire)) {
+    build_ut1_table();
+  }
+}
+
+// Calculate TAI minus a time scale at an epoch
+double TimeScaleConverter::tai_offset(double seconds, TimeScale scale) {
+  switch (scale) {
+    case UTC:
+      return tai_utc.offset(seconds);
+    case UT1: {
+      // UT1-UTC is keyed by UTC, so refine the UTC estimate once
+      double utc = seconds - ut1_utc.offset(seconds);
+      double ut1_offset = ut1_utc.offset(utc);
+      utc = seconds - ut1_offset;
+      return tai_utc.offset(utc) - ut1_offset;
+    }
+    case TAI:
+      return 0.0;
+    case TT:
+      return -TT_TAI_OFFSET;
+    case TDB:
+      // TDB-TT varies slowly enough that one evaluation at TDB suffices
+      return -tdb_tt_offset(seconds) - TT_TAI_OFFSET;
+    default:
+      return 0.0;
+  }
+}
+
+// Calculate a time scale minus TAI at a TAI epoch
+double TimeScaleConverter::scale_offset(double seconds, TimeScale scale) {
+  switch (scale) {
+    case UTC:
+      return -tai_utc_by_tai.offset(seconds);
+    case UT1: {
+      double utc_offset = -tai_utc_by_tai.offset(seconds);
+      return utc_offset + ut1_utc.offset(seconds + utc_offset);
+    }
+    case TAI:
+      return 0.0;
+    case TT:
+      return TT_TAI_OFFSET;
+    case TDB:
+      return TT_TAI_OFFSET + tdb_tt_offset(seconds + TT_TAI_OFFSET);
+    default:
+      return 0.0;
+  }
+}
+
+// Calculate the offset between time scales at an epoch
+double TimeScaleConverter::offset(double seconds, TimeScale from,
+                                  TimeScale to) {
+  if (!tables_ready.load(std::memory_order_acquire)) {
+    std::call_once(tables_built, &TimeScaleConverter::build_tables, this);
+  }
+  if (from == to) {
+    return 0.0;
+  }
+  if ((from == UT1 || to == UT1) && ut1_utc.size() == 0) {
+    throw ArcException(
+      "TimeScaleConverter::offset exception: UT1 requires Earth orientation "
+      "parameters (load a finals.all file)");
+  }
+  // UTC and UT1 share a key, so avoid the round trip through TAI
+  if (from == UTC && to == UT1) {
+    return ut1_utc.offset(seconds);
+  }
+  double to_tai = tai_offset(seconds, from);
+  return to_tai + scale_offset(seconds + to_tai, to);
+}
+
+// Convert seconds since J2000 between time scales
+double TimeScaleConverter::convert(double seconds, TimeScale from,
+                                   TimeScale to) {
+  return seconds + offset(seconds, from, to);
+}
+
+// Convert a DateTime to another time scale
+DateTime TimeScaleConverter::convert(DateTime &epoch, TimeScale to) {
+  // The offset is added to the two-part epoch to keep its precision
+  DateTime converted = epoch.increment(
+    offset(epoch.seconds_since_j2000(), epoch.scale, to));
+  converted.scale = to;
+  return converted;
+}
+
+// Convert an array of epochs between time scales in place
+void TimeScaleConverter::convert_batch(double *seconds, size_t count,
+                                       TimeScale from, TimeScale to) {
+  for (size_t i = 0; i < count; i++) {
+    seconds[i] = convert(seconds[i], from, to);
+  }
+}
+
+// Convert DateTimes to another time scale in place
+void TimeScaleConverter::convert_batch(std::vector<DateTime> &epochs,
+                                       TimeScale to) {
+  for (DateTime &epoch : epochs) {
+    epoch = convert(epoch, to);
+  }
+}
\ No newline at end of file
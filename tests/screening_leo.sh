@@ -0,0 +1,22 @@
+#!/bin/sh
+# Propagate the LEO and crossing LEO orbits, screen them for conjunctions, and
+# check the report holds the designed crossing (miss distance under 1 m)
+#
+# Usage: screening_leo.sh <arc executable> <output directory>
+# Run from the source directory, so the configurations' data paths resolve
+ARC="$1"
+OUT="$2"
+
+# Write every product (and read the screened ephemerides) in the output
+# directory
+for config in propagation_leo propagation_leo_crossing screening_leo; do
+  sed "s|\"ic_test_|\"$OUT/ic_test_|" "tests/$config.json" \
+    > "$OUT/$config.json"
+done
+"$ARC" "$OUT/propagation_leo.json" > /dev/null || exit 1
+"$ARC" "$OUT/propagation_leo_crossing.json" > /dev/null || exit 1
+"$ARC" "$OUT/screening_leo.json" > /dev/null || exit 1
+
+# Report lines: TCA, primary, secondary, miss distance, relative speed
+awk '!/^#/ && $4 < 1.0 { found = 1 } END { exit !found }' \
+  "$OUT/ic_test_conjunctions.txt"
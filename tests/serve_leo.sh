@@ -0,0 +1,36 @@
+#!/bin/sh
+# Run the LEO propagation once directly and once through an arc server, and
+# compare the streamed ephemeris with the one written by the direct run
+#
+# Usage: serve_leo.sh <arc executable> <output directory>
+# Run from the source directory, so the configuration's data paths resolve
+ARC="$1"
+OUT="$2"
+SOCKET="$OUT/serve_leo.sock"
+DIRECT="$OUT/serve_leo_direct.e"
+STREAMED="$OUT/serve_leo_streamed.e"
+
+# The direct run writes the same product to a file instead of the stream
+sed "s|\"FILENAME\": \"-\"|\"FILENAME\": \"$DIRECT\"|" tests/serve_leo.json \
+  > "$OUT/serve_leo_direct.json"
+"$ARC" "$OUT/serve_leo_direct.json" > /dev/null || exit 1
+
+"$ARC" --serve "$SOCKET" &
+SERVER=$!
+# Wait for the server to listen
+tries=0
+while [ ! -S "$SOCKET" ]; do
+  tries=$((tries + 1))
+  if [ "$tries" -gt 100 ]; then
+    kill "$SERVER"
+    exit 1
+  fi
+  sleep 0.1
+done
+
+status=0
+"$ARC" --send "$SOCKET" tests/serve_leo.json > "$STREAMED" || status=1
+cmp "$STREAMED" "$DIRECT" || status=1
+"$ARC" --stop "$SOCKET" || status=1
+wait "$SERVER" || status=1
+exit $status
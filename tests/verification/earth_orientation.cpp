@@ -0,0 +1,46 @@
+#include <data_files.h>
+#include <time_scales.h>
+#include <verification.h>
+
+#include <string>
+
+// Radians to arcseconds
+static const double ARCSEC = 206264.80624709636;
+
+/*
+Check the Earth orientation parameters loaded from the shipped finals.all
+against the values of its lines for 22 and 23 November 2020 (MJD 59175 and
+59176), at a tabulated day and halfway between the two
+*/
+int main() {
+  TIME_SCALES.load_earth_orientation("data/finals_all.txt");
+
+  DateTime midnight{ std::string("2020-11-22T00:00:00.000000") };
+  DateTime noon{ std::string("2020-11-22T12:00:00.000000") };
+  double ut1_midnight =
+    TIME_SCALES.offset(midnight.seconds_since_j2000(), UTC, UT1);
+  double ut1_noon = TIME_SCALES.offset(noon.seconds_since_j2000(), UTC, UT1);
+  bool pass = check("UT1-UTC on MJD 59175 (s)", ut1_midnight + 0.1763203,
+                    1e-9);
+  pass = check("UT1-UTC on MJD 59175.5 (s)",
+               ut1_noon + 0.5 * (0.1763203 + 0.1762769), 1e-9) &&
+         pass;
+  // The UT1 epoch differs from UTC by the same offset (to the resolution of
+  // seconds since J2000 in a double)
+  pass = check("DateTime::ut1 offset (s)",
+               noon.ut1().seconds_since_j2000() - noon.seconds_since_j2000() -
+                 ut1_noon,
+               1e-6) &&
+         pass;
+
+  std::array<double, 7> finals = DATA_FILES.get_finals(59175.5);
+  pass = check("Polar motion x on MJD 59175.5 (arcsec)",
+               finals[1] * ARCSEC - 0.5 * (0.132925 + 0.131458),
+               1e-9) &&
+         pass;
+  pass = check("Polar motion y on MJD 59175.5 (arcsec)",
+               finals[2] * ARCSEC - 0.5 * (0.288347 + 0.288203),
+               1e-9) &&
+         pass;
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+#include <keplerian.h>
+#include <math_utils.h>
+#include <verification.h>
+
+#include <algorithm>
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+// Earth gravitational parameter used by the Vallado example (m^3/s^2)
+static const double VALLADO_MU = 3.986004418e14;
+
+/*
+Check the universal-variable propagator against closed-form solutions: an
+elliptic orbit returns to its initial state after one period, a hyperbolic
+orbit matches the hyperbolic Kepler equation (solved here by bisection), and
+the elliptic case of Vallado (2013), Example 2-4, matches the published
+state
+*/
+int main() {
+  double mu = EARTH.mu();
+
+  // Molniya orbit (a = 26554 km, e = 0.72) starting at perigee
+  double a = 26554e3, e = 0.72;
+  double r_p = a * (1.0 - e);
+  Vector3 r_0{ r_p, 0.0, 0.0 };
+  Vector3 v_0{ 0.0, sqrt(mu * (1.0 + e) / r_p) * cos(radians(63.4)),
+               sqrt(mu * (1.0 + e) / r_p) * sin(radians(63.4)) };
+  double period = 2.0 * M_PI * sqrt(a * a * a / mu);
+  Vector3 r, v;
+  propagate_universal(mu, r_0, v_0, period, r, v);
+  bool pass = check("Elliptic, one period: position (m)", (r - r_0).mag(),
+                    1e-4);
+  pass = check("Elliptic, one period: velocity (m/s)", (v - v_0).mag(),
+               1e-7) &&
+         pass;
+
+  // Hyperbolic flyby (e = 1.5, perigee 7000 km) two hours after perigee
+  e = 1.5;
+  r_p = 7000e3;
+  a = r_p / (1.0 - e);
+  r_0 = Vector3{ r_p, 0.0, 0.0 };
+  v_0 = Vector3{ 0.0, sqrt(mu * (1.0 + e) / r_p), 0.0 };
+  double dt = 7200.0;
+  double mean_anom = sqrt(mu / (-a * -a * -a)) * dt;
+  // e sinh(H) - H increases with H, so bisect on [0, mean_anom]
+  double h_lo = 0.0, h_hi = std::max(mean_anom, 1.0);
+  for (int i = 0; i < 200; i++) {
+    double h = 0.5 * (h_lo + h_hi);
+    if (e * sinh(h) - h < mean_anom) {
+      h_lo = h;
+    } else {
+      h_hi = h;
+    }
+  }
+  double hyp_anom = 0.5 * (h_lo + h_hi);
+  Vector3 expected{ -a * (e - cosh(hyp_anom)),
+                    -a * sqrt(e * e - 1.0) * sinh(hyp_anom), 0.0 };
+  propagate_universal(mu, r_0, v_0, dt, r, v);
+  pass = check("Hyperbolic, two hours: position (m)", (r - expected).mag(),
+               1e-4) &&
+         pass;
+
+  // Vallado (2013), Example 2-4: 40 minutes (km and km/s in the text)
+  r_0 = Vector3{ 1131340.0, -2282343.0, 6672423.0 };
+  v_0 = Vector3{ -5643.05, 4303.33, 2428.79 };
+  propagate_universal(VALLADO_MU, r_0, v_0, 2400.0, r, v);
+  Vector3 r_ref{ -4219752.7, 4363029.2, -3958766.6 };
+  Vector3 v_ref{ 3689.866, -1916.735, -6112.511 };
+  pass = check("Vallado Example 2-4: position (m)", (r - r_ref).mag(), 1.0) &&
+         pass;
+  pass = check("Vallado Example 2-4: velocity (m/s)", (v - v_ref).mag(),
+               1e-3) &&
+         pass;
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+#include <sgp4.h>
+#include <verification.h>
+
+#include <algorithm>
+
+// Largest differences between a catalog and its scalar propagators (m, m/s)
+static void catalog_errors(std::vector<TwoLineElement> &elements,
+                           DateTime &start, double &position_error,
+                           double &velocity_error) {
+  SGP4Catalog catalog{ elements };
+  catalog.threads = 1;
+  DateTime stop = start.increment(86400.0);
+  std::vector<Ephemeris> ephemerides = catalog.step(start, stop, 60.0);
+  position_error = 0.0;
+  velocity_error = 0.0;
+  for (size_t obj = 0; obj < ephemerides.size(); obj++) {
+    Ephemeris &ephem = ephemerides[obj];
+    for (size_t i = 0; i < ephem.size(); i++) {
+      DateTime epoch = ephem.state_epoch(i);
+      ICRF packed = ephem.state(i);
+      ICRF scalar = catalog.propagators[obj].propagate(epoch);
+      position_error = std::max(position_error,
+                                (packed.position - scalar.position).mag());
+      velocity_error = std::max(velocity_error,
+                                (packed.velocity - scalar.velocity).mag());
+    }
+  }
+}
+
+/*
+Check that the packed near-earth evaluation of SGP4Catalog::step reproduces
+SGP4Propagator::propagate at every epoch, for each element set of
+tests/catalog.tle (ISS, and the Vallado et al. 00005 and 08195 verification
+sets) alone over a day from its own epoch, and for the whole catalog over a
+day from the latest element epoch. The TEME states agree exactly; what
+remains is the rounding of the two TEME to ICRF rotation paths
+*/
+int main() {
+  std::vector<TwoLineElement> catalog = read_tle_file("tests/catalog.tle");
+  bool pass = true;
+  DateTime latest = catalog.front().epoch;
+  for (TwoLineElement &tle : catalog) {
+    std::vector<TwoLineElement> single{ tle };
+    double position_error, velocity_error;
+    catalog_errors(single, tle.epoch, position_error, velocity_error);
+    std::string name = tle.satnum;
+    pass = check((name + " catalog vs scalar position (m)").c_str(),
+                 position_error, 1e-7) &&
+           pass;
+    pass = check((name + " catalog vs scalar velocity (m/s)").c_str(),
+                 velocity_error, 1e-10) &&
+           pass;
+    if (tle.epoch.difference(latest) > 0.0) {
+      latest = tle.epoch;
+    }
+  }
+  double position_error, velocity_error;
+  catalog_errors(catalog, latest, position_error, velocity_error);
+  pass = check("Full catalog vs scalar position (m)", position_error, 1e-7) &&
+         pass;
+  pass = check("Full catalog vs scalar velocity (m/s)", velocity_error, 1e-10) &&
+         pass;
+  return pass ? 0 : 1;
+}
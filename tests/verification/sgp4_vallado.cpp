@@ -0,0 +1,91 @@
+#include <sgp4.h>
+#include <verification.h>
+
+#include <algorithm>
+
+// Published TEME state at a time since epoch (minutes, km, km/s)
+struct ReferenceState {
+  double tsince;
+  double r[3];
+  double v[3];
+};
+
+// Largest position and velocity errors of a satellite against its vectors
+static void vector_errors(const char line1[], const char line2[],
+                          const ReferenceState *states, int count,
+                          double &position_error, double &velocity_error) {
+  TwoLineElement tle{ line1, line2 };
+  SGP4Propagator propagator{ tle };
+  position_error = 0.0;
+  velocity_error = 0.0;
+  for (int i = 0; i < count; i++) {
+    double r[3], v[3];
+    if (propagator.propagate_teme(states[i].tsince, r, v) != SGP4_OK) {
+      position_error = INFINITY;
+      velocity_error = INFINITY;
+      return;
+    }
+    for (int k = 0; k < 3; k++) {
+      position_error =
+        std::max(position_error, std::fabs(r[k] - states[i].r[k]));
+      velocity_error =
+        std::max(velocity_error, std::fabs(v[k] - states[i].v[k]));
+    }
+  }
+}
+
+/*
+Check SGP4 against the verification vectors of Vallado et al. (2006),
+"Revisiting Spacetrack Report #3" (tcppver.out): 00005, a near-Earth orbit
+with e = 0.186, and 08195, a deep space 12 hour resonant Molniya orbit. The
+vectors are printed to 1e-8 km and 1e-9 km/s
+*/
+int main() {
+  const ReferenceState vanguard[] = {
+    { 0.0,
+      { 7022.46529266, -1400.08296755, 0.03995155 },
+      { 1.893841015, 6.405893759, 4.534807250 } },
+    { 360.0,
+      { -7154.03120202, -3783.17682504, -3536.19412294 },
+      { 4.741887409, -4.151817765, -2.093935425 } },
+    { 720.0,
+      { -7134.59340119, 6531.68641334, 3260.27186483 },
+      { -4.113793027, -2.911922039, -2.557327851 } },
+    { 1080.0,
+      { 5568.53901181, 4492.06992591, 3863.87641983 },
+      { -4.209106476, 5.159719888, 2.744852980 } },
+    { 1440.0,
+      { -938.55923943, -6268.18748831, -4294.02924751 },
+      { 7.536105209, -0.427127707, 0.989878080 } }
+  };
+  const ReferenceState molniya[] = {
+    { 0.0,
+      { 2349.89483350, -14785.93811562, 0.02119378 },
+      { 2.721488096, -3.256811655, 4.498416672 } },
+    { 120.0,
+      { 15223.91713658, -17852.95881713, 25280.39558224 },
+      { 1.079041732, 0.875187372, 2.485682813 } },
+    { 360.0,
+      { 19089.29762968, 3107.89495018, 39958.14661370 },
+      { -0.410308034, 1.640332277, -0.306873818 } },
+    { 720.0,
+      { 2622.13222207, -15125.15464924, 474.51048398 },
+      { 2.688287199, -3.078426664, 4.494979530 } }
+  };
+
+  double position_error, velocity_error;
+  vector_errors(
+    "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753",
+    "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667",
+    vanguard, 5, position_error, velocity_error);
+  bool pass = check("00005 position (km)", position_error, 1e-6);
+  pass = check("00005 velocity (km/s)", velocity_error, 2e-9) && pass;
+
+  vector_errors(
+    "1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813",
+    "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656",
+    molniya, 4, position_error, velocity_error);
+  pass = check("08195 position (km)", position_error, 1e-6) && pass;
+  pass = check("08195 velocity (km/s)", velocity_error, 2e-9) && pass;
+  return pass ? 0 : 1;
+}
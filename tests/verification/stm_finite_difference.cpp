@@ -0,0 +1,58 @@
+#include <rungekutta4.h>
+#include <verification.h>
+
+/*
+Compare the state transition matrix integrated with the variational equations
+against central differences of perturbed-state propagations (LEO, J2 and
+drag, one hour)
+*/
+int main() {
+  DateTime start{ "2020-11-22T00:00:00.000000" };
+  DateTime stop = start.increment(3600.0);
+  Vector3 position{ -698891.686, 6023436.003, 3041793.014 };
+  Vector3 velocity{ -4987.520, -3082.634, 4941.720 };
+  ICRF initial{ EARTH, start, position, velocity };
+  std::vector<GravityModel> gravity{ GravityModel{ EARTH, J2, true, 0, 0 } };
+  ForceModel fm{ gravity, DragModel{ EARTH, Standard1976, 1000.0, 10.0,
+                                     2.2 } };
+
+  RungeKutta4 nominal{ initial, 15.0, fm };
+  Matrix6 stm;
+  ICRF final_state = nominal.propagate_with_stm(stop, stm);
+  // The state integrated alongside the matrix matches plain propagation
+  RungeKutta4 plain{ initial, 15.0, fm };
+  ICRF plain_state = plain.propagate(stop);
+  bool pass = check("STM-path state vs plain propagation (m)",
+                    (final_state.position - plain_state.position).mag(),
+                    1e-6);
+
+  // Perturbation of each initial component (m, m/s)
+  const double delta[6] = { 1.0, 1.0, 1.0, 1e-3, 1e-3, 1e-3 };
+  double max_error = 0.0;
+  for (int j = 0; j < 6; j++) {
+    double d[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    d[j] = delta[j];
+    Vector3 dp{ d[0], d[1], d[2] };
+    Vector3 dv{ d[3], d[4], d[5] };
+    Vector3 pos_plus = position + dp, vel_plus = velocity + dv;
+    Vector3 pos_minus = position - dp, vel_minus = velocity - dv;
+    RungeKutta4 plus{ ICRF{ EARTH, start, pos_plus, vel_plus }, 15.0, fm };
+    RungeKutta4 minus{ ICRF{ EARTH, start, pos_minus, vel_minus }, 15.0, fm };
+    ICRF a = plus.propagate(stop);
+    ICRF b = minus.propagate(stop);
+    double da[6] = { a.position.x, a.position.y, a.position.z,
+                     a.velocity.x, a.velocity.y, a.velocity.z };
+    double db[6] = { b.position.x, b.position.y, b.position.z,
+                     b.velocity.x, b.velocity.y, b.velocity.z };
+    for (int i = 0; i < 6; i++) {
+      double difference = (da[i] - db[i]) / (2.0 * delta[j]);
+      // Relative to the element, floored for near-zero partials
+      double error = std::fabs(stm.elements[i][j] - difference) /
+                     (std::fabs(difference) + 1e-3);
+      max_error = std::max(max_error, error);
+    }
+  }
+  pass = check("STM vs central differences (relative)", max_error, 1e-4) &&
+         pass;
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,46 @@
+#include <rungekutta4.h>
+#include <sundman.h>
+#include <verification.h>
+
+#include <cstdio>
+
+/*
+Show the step-size benefit of the Sundman transformation on the HEO case
+(tests/sundman_heo.json, perigee 7435 km, apogee 45660 km, J2, one day):
+at fewer force evaluations, RK4 in regularized time is far more accurate
+than fixed-step RK4, which wastes steps near apogee and is too coarse at
+perigee
+*/
+int main() {
+  DateTime start{ "2021-03-20T00:00:00.000000" };
+  DateTime stop = start.increment(86400.0);
+  Vector3 position{ 0.0, -3329142.549, -6648144.049 };
+  Vector3 velocity{ 9602.606, 0.0, 0.0 };
+  ICRF initial{ EARTH, start, position, velocity };
+  ForceModel fm{};
+  fm.add_gravity(GravityModel{ EARTH, J2, true, 0, 0 });
+
+  // Reference trajectory from a very small fixed step
+  RungeKutta4 reference{ initial, 1.0, fm };
+  ICRF truth = reference.propagate(stop);
+
+  RungeKutta4 fixed{ initial, 60.0, fm };
+  double fixed_error = (fixed.propagate(stop).position - truth.position).mag();
+  SundmanPropagator regularized{ initial, 80.0, fm };
+  regularized.sundman_power = 1.5;
+  double sundman_error =
+    (regularized.propagate(stop).position - truth.position).mag();
+  printf("RK4: %zu evaluations, %.3e m; RK4-Sundman: %zu evaluations, "
+         "%.3e m\n",
+         fixed.force_model.evaluations, fixed_error,
+         regularized.force_model.evaluations, sundman_error);
+
+  bool pass = check("RK4-Sundman evaluations / RK4 evaluations",
+                    (double)regularized.force_model.evaluations /
+                      fixed.force_model.evaluations,
+                    1.0);
+  pass = check("RK4-Sundman error / RK4 error", sundman_error / fixed_error,
+               0.1) &&
+         pass;
+  return pass ? 0 : 1;
+}
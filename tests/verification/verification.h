@@ -0,0 +1,29 @@
+#ifndef VERIFICATION_H
+#define VERIFICATION_H
+#include <cmath>
+#include <iostream>
+
+/*
+Numerical verification helpers
+
+Each verification program checks results against finite differences,
+closed-form solutions, or published reference values, printing every
+checked quantity and returning nonzero if any is out of tolerance.
+*/
+
+/*
+Report a checked error and whether it is within tolerance
+
+@param name Description of the checked quantity
+@param error Error of the quantity
+@param tolerance Largest acceptable error
+@returns (bool) True if the error is within tolerance
+*/
+inline bool check(const char name[], double error, double tolerance) {
+  bool pass = std::fabs(error) <= tolerance;
+  std::cout << (pass ? "PASS " : "FAIL ") << name << ": error " << error
+            << " (tolerance " << tolerance << ")" << std::endl;
+  return pass;
+}
+
+#endif